@@ -0,0 +1,67 @@
+// Copyright 2020-2025 Nestor Neto
+
+// Ports::scanPorts() on a synthetic /dev/serial/by-id directory. Built
+// with BUILD_TESTING_ON for the Ports(const char*) constructor.
+
+#include <benchmark/benchmark.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "libserial/ports.hpp"
+
+namespace {
+
+// Temporary /dev/serial/by-id look-alike with one symlink per device
+class ByIdDirectory {
+public:
+explicit ByIdDirectory(size_t devices) {
+  char path[] = "/tmp/libserial_bench_XXXXXX";
+  if (!mkdtemp(path)) {
+    throw std::runtime_error("Failed to create temporary directory");
+  }
+  path_ = path;
+
+  for (size_t i = 0; i < devices; ++i) {
+    std::string name = path_ + "/usb-Vendor_Device_" + std::to_string(i) + "-if00-port0";
+    std::string target = "../../ttyUSB" + std::to_string(i);
+    if (symlink(target.c_str(), name.c_str()) != 0) {
+      throw std::runtime_error("Failed to create symlink " + name);
+    }
+    links_.push_back(name);
+  }
+}
+
+~ByIdDirectory() {
+  for (const auto& link : links_) {
+    unlink(link.c_str());
+  }
+  rmdir(path_.c_str());
+}
+
+const char* path() const {
+  return path_.c_str();
+}
+
+private:
+std::string path_;
+std::vector<std::string> links_;
+};
+
+void BM_ScanPorts(benchmark::State& state) {
+  ByIdDirectory directory(static_cast<size_t>(state.range(0)));
+  libserial::Ports ports(directory.path());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ports.scanPorts());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+
+}  // namespace
+
+BENCHMARK(BM_ScanPorts)->RangeMultiplier(4)->Range(1, 64);
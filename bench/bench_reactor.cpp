@@ -0,0 +1,187 @@
+// Copyright 2020-2025 Nestor Neto
+
+// Compares the ways of draining many ports at once: a hand-written
+// poll()+read() loop, SerialReactor on epoll and SerialReactor on io_uring.
+// Every iteration writes one chunk to each pty master and runs the loop
+// until all chunks have been read from the slaves.
+
+#include <benchmark/benchmark.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "libserial/serial.hpp"
+#include "libserial/serial_reactor.hpp"
+
+namespace {
+
+constexpr size_t kChunkSize = 1024;
+
+// N pseudo-terminal pairs with raw line settings, so no echo or output
+// processing distorts the byte counts
+class PtyBank {
+public:
+explicit PtyBank(size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+      throw std::runtime_error("Failed to open pseudo-terminal");
+    }
+
+    struct termios2 tio;
+    ioctl(master, TCGETS2, &tio);
+    tio.c_lflag &= ~(ICANON | ECHO | ECHOE | ECHOK | ECHONL | ISIG | IEXTEN);
+    tio.c_iflag &= ~(ICRNL | INLCR | IXON);
+    tio.c_oflag &= ~OPOST;
+    ioctl(master, TCSETS2, &tio);
+
+    auto serial = std::make_unique<libserial::Serial>();
+    serial->open(ptsname(master));
+    masters_.push_back(master);
+    slaves_.push_back(std::move(serial));
+  }
+}
+
+~PtyBank() {
+  for (auto& serial : slaves_) {
+    serial->close();
+  }
+  for (int master : masters_) {
+    close(master);
+  }
+}
+
+void writeAll(const char* data, size_t size) {
+  for (int master : masters_) {
+    if (write(master, data, size) != static_cast<ssize_t>(size)) {
+      throw std::runtime_error("Short write to pseudo-terminal master");
+    }
+  }
+}
+
+size_t size() const {
+  return slaves_.size();
+}
+
+libserial::Serial& slave(size_t index) {
+  return *slaves_[index];
+}
+
+private:
+std::vector<int> masters_;
+std::vector<std::unique_ptr<libserial::Serial>> slaves_;
+};
+
+// User plus system CPU time of the whole process, io_uring workers included
+double processCpuSeconds() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+         static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+void reportCounters(benchmark::State& state, size_t ports, uint64_t syscalls,
+                    double cpu_seconds) {
+  const double bytes = static_cast<double>(state.iterations() * ports * kChunkSize);
+  const double megabytes = bytes / (1024.0 * 1024.0);
+
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+  state.counters["syscalls"] = benchmark::Counter(static_cast<double>(syscalls),
+                                                  benchmark::Counter::kIsRate);
+  state.counters["syscalls_per_MB"] = static_cast<double>(syscalls) / megabytes;
+  state.counters["cpu_ms_per_MB"] = cpu_seconds * 1000.0 / megabytes;
+}
+
+void BM_PollRead(benchmark::State& state) {
+  const size_t ports = static_cast<size_t>(state.range(0));
+  PtyBank bank(ports);
+  const std::string chunk(kChunkSize, 'x');
+  std::vector<char> buffer(4096);
+
+  std::vector<struct pollfd> fds(ports);
+  for (size_t i = 0; i < ports; ++i) {
+    fds[i].fd = bank.slave(i).getFileDescriptor();
+    fds[i].events = POLLIN;
+  }
+
+  uint64_t syscalls = 0;
+  double cpu_start = processCpuSeconds();
+  for (auto _ : state) {
+    bank.writeAll(chunk.data(), chunk.size());
+
+    size_t received = 0;
+    while (received < ports * kChunkSize) {
+      syscalls++;
+      poll(fds.data(), fds.size(), -1);
+      for (size_t i = 0; i < ports; ++i) {
+        if (!(fds[i].revents & POLLIN)) {
+          continue;
+        }
+        size_t bytes = 0;
+        do {
+          syscalls++;
+          bytes = bank.slave(i).readAvailable(buffer.data(), buffer.size());
+          received += bytes;
+        } while (bytes > 0);
+      }
+    }
+  }
+  reportCounters(state, ports, syscalls, processCpuSeconds() - cpu_start);
+}
+
+void runReactor(benchmark::State& state, libserial::ReactorBackend backend) {
+  const size_t ports = static_cast<size_t>(state.range(0));
+  PtyBank bank(ports);
+  const std::string chunk(kChunkSize, 'x');
+
+  libserial::SerialReactor reactor(backend);
+  if (reactor.getBackend() != backend) {
+    state.SkipWithError("io_uring is not available on this system");
+    return;
+  }
+
+  size_t received = 0;
+  for (size_t i = 0; i < ports; ++i) {
+    libserial::PortHandlers handlers;
+    handlers.on_data = [&received](libserial::Serial&, const char*, size_t size) {
+        received += size;
+      };
+    reactor.addPort(bank.slave(i), handlers);
+  }
+
+  uint64_t syscalls_start = reactor.getSystemCallCount();
+  double cpu_start = processCpuSeconds();
+  for (auto _ : state) {
+    bank.writeAll(chunk.data(), chunk.size());
+
+    received = 0;
+    while (received < ports * kChunkSize) {
+      reactor.runOnce(std::chrono::milliseconds(-1));
+    }
+  }
+  reportCounters(state, ports, reactor.getSystemCallCount() - syscalls_start,
+                 processCpuSeconds() - cpu_start);
+}
+
+void BM_ReactorEpoll(benchmark::State& state) {
+  runReactor(state, libserial::ReactorBackend::EPOLL);
+}
+
+void BM_ReactorIoUring(benchmark::State& state) {
+  runReactor(state, libserial::ReactorBackend::IO_URING);
+}
+
+}  // namespace
+
+BENCHMARK(BM_PollRead)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(BM_ReactorEpoll)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK(BM_ReactorIoUring)->RangeMultiplier(4)->Range(1, 64);
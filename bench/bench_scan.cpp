@@ -0,0 +1,93 @@
+// Copyright 2020-2025 Nestor Neto
+
+// Compares the ways of splitting a 64 KB burst of log output at '\n':
+// a per-byte loop, the SWAR scalar path, the vector path used by the
+// library, and the C library memchr() as a reference.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "libserial/byte_scan.hpp"
+
+namespace {
+
+constexpr size_t kBurstSize = 64 * 1024;
+
+// Printable lines of 40 to 120 characters, as a device logging at speed would send
+std::string logBurst() {
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<size_t> length(40, 120);
+  std::uniform_int_distribution<int> character(' ', '~');
+
+  std::string burst;
+  burst.reserve(kBurstSize);
+  while (burst.size() < kBurstSize) {
+    size_t line = std::min(length(generator), kBurstSize - burst.size() - 1);
+    for (size_t i = 0; i < line; ++i) {
+      burst += static_cast<char>(character(generator));
+    }
+    burst += '\n';
+  }
+  return burst;
+}
+
+const char* findBytePerByte(const char* data, size_t size, char byte) {
+  for (size_t i = 0; i < size; ++i) {
+    if (data[i] == byte) {
+      return data + i;
+    }
+  }
+  return nullptr;
+}
+
+const char* findByteMemchr(const char* data, size_t size, char byte) {
+  return static_cast<const char*>(std::memchr(data, byte, size));
+}
+
+template <const char* (*Find)(const char*, size_t, char)>
+void BM_SplitLines(benchmark::State& state) {
+  const std::string burst = logBurst();
+  size_t lines = 0;
+
+  for (auto _ : state) {
+    const char* p = burst.data();
+    const char* end = p + burst.size();
+    while (const char* newline = Find(p, static_cast<size_t>(end - p), '\n')) {
+      benchmark::DoNotOptimize(newline);
+      ++lines;
+      p = newline + 1;
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * burst.size()));
+  state.counters["lines"] = benchmark::Counter(static_cast<double>(lines),
+                                               benchmark::Counter::kIsRate);
+}
+
+// A burst without any terminator: the raw scan rate over the whole buffer
+template <const char* (*Find)(const char*, size_t, char)>
+void BM_ScanNoMatch(benchmark::State& state) {
+  const std::string burst(kBurstSize, 'x');
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(Find(burst.data(), burst.size(), '\n'));
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * burst.size()));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_SplitLines, findBytePerByte)->Name("BM_SplitLines/PerByte");
+BENCHMARK_TEMPLATE(BM_SplitLines, libserial::findByteScalar)->Name("BM_SplitLines/Scalar");
+BENCHMARK_TEMPLATE(BM_SplitLines, libserial::findByte)->Name("BM_SplitLines/Vector");
+BENCHMARK_TEMPLATE(BM_SplitLines, findByteMemchr)->Name("BM_SplitLines/Memchr");
+
+BENCHMARK_TEMPLATE(BM_ScanNoMatch, findBytePerByte)->Name("BM_ScanNoMatch/PerByte");
+BENCHMARK_TEMPLATE(BM_ScanNoMatch, libserial::findByteScalar)->Name("BM_ScanNoMatch/Scalar");
+BENCHMARK_TEMPLATE(BM_ScanNoMatch, libserial::findByte)->Name("BM_ScanNoMatch/Vector");
+BENCHMARK_TEMPLATE(BM_ScanNoMatch, findByteMemchr)->Name("BM_ScanNoMatch/Memchr");
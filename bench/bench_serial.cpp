@@ -0,0 +1,465 @@
+// Copyright 2020-2025 Nestor Neto
+
+// Throughput and per-call latency of the Serial I/O paths over a pty
+// pair, the cost of the configuration setters, the dispatch cost of the
+// system call layer on small reads, the cost of an idle poll through
+// the throwing and the non-throwing API, the ping-pong round trip with
+// and without low latency mode, and a fresh string per read against a
+// pooled buffer. Each read benchmark writes one
+// payload to the master and reads it back through the measured call, so
+// the reported time is the latency of one call and bytes_per_second its
+// throughput. Run with --benchmark_format=json (or the bench_json
+// target) to keep results across releases.
+
+#include <benchmark/benchmark.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libserial/capture.hpp"
+#include "libserial/serial.hpp"
+#include "libserial/serial_config.hpp"
+#include "libserial/system_calls.hpp"
+#include "libserial/traffic_tap.hpp"
+
+namespace {
+
+// Same pseudo-terminal setup as test/test_serial_pty.cpp, with echo and
+// input translation turned off so byte counts match on both ends
+class PtyPair {
+public:
+explicit PtyPair(libserial::CanonicalMode mode) {
+  master_fd_ = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master_fd_ < 0 || grantpt(master_fd_) != 0 || unlockpt(master_fd_) != 0) {
+    throw std::runtime_error("Failed to open pseudo-terminal");
+  }
+
+  serial_.open(ptsname(master_fd_));
+  serial_.setCanonicalMode(mode);
+  serial_.setReadTimeout(std::chrono::milliseconds(1000));
+
+  struct termios2 tty;
+  ioctl(serial_.getFileDescriptor(), TCGETS2, &tty);
+  tty.c_iflag &= ~(INLCR | IGNCR | ICRNL | IXON);
+  tty.c_oflag &= ~OPOST;
+  tty.c_lflag &= ~(ECHO | ECHONL | ISIG | IEXTEN);
+  ioctl(serial_.getFileDescriptor(), TCSETS2, &tty);
+  serial_.refreshConfig();
+}
+
+~PtyPair() {
+  serial_.close();
+  close(master_fd_);
+}
+
+void writeMaster(const std::string& data) {
+  if (write(master_fd_, data.data(), data.size()) != static_cast<ssize_t>(data.size())) {
+    throw std::runtime_error("Short write to pseudo-terminal master");
+  }
+}
+
+void drainMaster(char* buffer, size_t size) {
+  size_t received = 0;
+  while (received < size) {
+    ssize_t result = read(master_fd_, buffer + received, size - received);
+    if (result <= 0) {
+      throw std::runtime_error("Failed to read from pseudo-terminal master");
+    }
+    received += static_cast<size_t>(result);
+  }
+}
+
+libserial::Serial& serial() {
+  return serial_;
+}
+
+private:
+int master_fd_{-1};
+libserial::Serial serial_;
+};
+
+void reportBytes(benchmark::State& state, size_t payload) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload));
+}
+
+void BM_Write(benchmark::State& state) {
+  const size_t payload = static_cast<size_t>(state.range(0));
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  const std::string data(payload, 'x');
+  std::vector<char> sink(payload);
+
+  for (auto _ : state) {
+    pty.serial().write(data.data(), data.size());
+    state.PauseTiming();
+    pty.drainMaster(sink.data(), sink.size());
+    state.ResumeTiming();
+  }
+  reportBytes(state, payload);
+}
+
+// Same as BM_Write with the traffic teed into a capture file; the
+// difference is the cost of record() on the write path
+void BM_WriteCaptured(benchmark::State& state) {
+  const size_t payload = static_cast<size_t>(state.range(0));
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  const std::string data(payload, 'x');
+  std::vector<char> sink(payload);
+
+  char path[] = "/tmp/libserial_bench_capture_XXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to create capture file");
+  }
+  close(fd);
+  unlink(path);
+  auto writer = std::make_shared<libserial::CaptureWriter>(path);
+  pty.serial().setCapture(writer);
+
+  for (auto _ : state) {
+    pty.serial().write(data.data(), data.size());
+    state.PauseTiming();
+    pty.drainMaster(sink.data(), sink.size());
+    state.ResumeTiming();
+  }
+  reportBytes(state, payload);
+  state.counters["dropped"] = static_cast<double>(writer->getDroppedRecords());
+
+  pty.serial().setCapture(nullptr);
+  writer.reset();
+  unlink(path);
+}
+
+// Same as BM_Write with a tap whose only observer takes 1 ms per chunk;
+// the writes keep their speed and the tap drops what it cannot deliver
+void BM_WriteTapped(benchmark::State& state) {
+  const size_t payload = static_cast<size_t>(state.range(0));
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  const std::string data(payload, 'x');
+  std::vector<char> sink(payload);
+
+  auto tap = std::make_shared<libserial::TrafficTap>(64);
+  tap->addObserver([](const libserial::CaptureRecord&) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+  pty.serial().setTap(tap);
+
+  for (auto _ : state) {
+    pty.serial().write(data.data(), data.size());
+    state.PauseTiming();
+    pty.drainMaster(sink.data(), sink.size());
+    state.ResumeTiming();
+  }
+  reportBytes(state, payload);
+  libserial::TapStats stats = tap->getStats();
+  state.counters["delivered"] = static_cast<double>(stats.delivered);
+  state.counters["dropped"] = static_cast<double>(stats.dropped);
+
+  pty.serial().setTap(nullptr);
+}
+
+// read() is the canonical-mode call, so the payload is one line; the
+// line discipline caps canonical lines at 4095 bytes
+void BM_Read(benchmark::State& state) {
+  const size_t payload = static_cast<size_t>(state.range(0));
+  PtyPair pty(libserial::CanonicalMode::ENABLE);
+  const std::string line = std::string(payload - 1, 'x') + "\n";
+  std::vector<char> buffer(payload);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    pty.writeMaster(line);
+    state.ResumeTiming();
+    size_t received = 0;
+    while (received < payload) {
+      received += pty.serial().read(buffer.data() + received, payload - received);
+    }
+  }
+  reportBytes(state, payload);
+}
+
+void BM_ReadBytes(benchmark::State& state) {
+  const size_t payload = static_cast<size_t>(state.range(0));
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  const std::string data(payload, 'x');
+  std::vector<char> buffer(payload);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    pty.writeMaster(data);
+    state.ResumeTiming();
+    size_t received = 0;
+    while (received < payload) {
+      received += pty.serial().readBytes(buffer.data() + received, payload - received);
+    }
+  }
+  reportBytes(state, payload);
+}
+
+void BM_ReadUntil(benchmark::State& state) {
+  const size_t payload = static_cast<size_t>(state.range(0));
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  pty.serial().setMaxSafeReadSize(payload);
+  const std::string line = std::string(payload - 1, 'x') + "\n";
+  std::vector<char> buffer(payload);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    pty.writeMaster(line);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(pty.serial().readUntil(buffer.data(), buffer.size(), '\n'));
+  }
+  reportBytes(state, payload);
+}
+
+void BM_SetBaudRate(benchmark::State& state) {
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  bool fast = false;
+
+  for (auto _ : state) {
+    fast = !fast;
+    pty.serial().setBaudRate(fast ? libserial::BaudRate::BAUD_RATE_115200 :
+                             libserial::BaudRate::BAUD_RATE_9600);
+  }
+}
+
+void BM_SetParity(benchmark::State& state) {
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  bool even = false;
+
+  for (auto _ : state) {
+    even = !even;
+    pty.serial().setParity(even ? libserial::Parity::ENABLE : libserial::Parity::DISABLE);
+  }
+}
+
+void BM_SetReadTimeout(benchmark::State& state) {
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  bool longer = false;
+
+  for (auto _ : state) {
+    longer = !longer;
+    pty.serial().setReadTimeout(std::chrono::milliseconds(longer ? 2000 : 1000));
+  }
+}
+
+// Every line setting staged on one termios2 and applied with one ioctl
+void BM_ApplyConfig(benchmark::State& state) {
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  libserial::SerialConfig configs[2];
+  configs[0].setBaudRate(libserial::BaudRate::BAUD_RATE_9600);
+  configs[0].setParity(libserial::Parity::DISABLE);
+  configs[0].setDataLength(libserial::DataLength::EIGHT);
+  configs[1].setBaudRate(libserial::BaudRate::BAUD_RATE_115200);
+  configs[1].setParity(libserial::Parity::ENABLE);
+  configs[1].setDataLength(libserial::DataLength::SEVEN);
+
+  size_t index = 0;
+  for (auto _ : state) {
+    index ^= 1;
+    pty.serial().applyConfig(configs[index]);
+  }
+}
+
+// One-byte reads, each one a read() system call: the port is refilled
+// from the master outside the timed region every kRefill reads
+constexpr size_t kRefill = 4096;
+
+template <typename Read>
+void runSmallReads(benchmark::State& state, PtyPair& pty, Read read) {
+  const std::string refill(kRefill, 'x');
+  size_t left = 0;
+  char byte;
+
+  for (auto _ : state) {
+    if (left == 0) {
+      state.PauseTiming();
+      pty.writeMaster(refill);
+      left = kRefill;
+      state.ResumeTiming();
+    }
+    if (read(&byte) != 1) {
+      state.SkipWithError("Short read");
+      break;
+    }
+    --left;
+  }
+  state.counters["sizeof_Serial"] = sizeof(libserial::Serial);
+}
+
+// The system call layer as it is compiled into Serial
+void BM_SmallReadSerial(benchmark::State& state) {
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  pty.serial().setNonBlocking(true);
+  runSmallReads(state, pty, [&pty](char* byte) {
+      return static_cast<ssize_t>(pty.serial().readAvailable(byte, 1));
+    });
+}
+
+// Static dispatch through PosixSystemCalls, as production builds do
+void BM_SmallReadPolicy(benchmark::State& state) {
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  const int fd = pty.serial().getFileDescriptor();
+  runSmallReads(state, pty, [fd](char* byte) {
+      return libserial::PosixSystemCalls::read(fd, byte, 1);
+    });
+}
+
+// The std::function member Serial used to call through on every read
+void BM_SmallReadStdFunction(benchmark::State& state) {
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  const int fd = pty.serial().getFileDescriptor();
+  std::function<ssize_t(int, void*, size_t)> read_function =
+    [](int descriptor, void* buffer, size_t size) {
+      return ::read(descriptor, buffer, size);
+    };
+  benchmark::DoNotOptimize(read_function);
+  runSmallReads(state, pty, [fd, &read_function](char* byte) {
+      return read_function(fd, byte, 1);
+    });
+}
+
+// A line read into a fresh string per call, as the examples used to
+// do, and into a recycled BufferPool slab
+void BM_ReadFreshString(benchmark::State& state) {
+  PtyPair pty(libserial::CanonicalMode::ENABLE);
+  const std::string line = std::string(63, 'x') + "\n";
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    pty.writeMaster(line);
+    state.ResumeTiming();
+    auto buffer = std::make_shared<std::string>();
+    benchmark::DoNotOptimize(pty.serial().read(buffer));
+  }
+  reportBytes(state, line.size());
+}
+
+void BM_ReadPooled(benchmark::State& state) {
+  PtyPair pty(libserial::CanonicalMode::ENABLE);
+  const std::string line = std::string(63, 'x') + "\n";
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    pty.writeMaster(line);
+    state.ResumeTiming();
+    libserial::PooledBuffer buffer = pty.serial().readPooled();
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  reportBytes(state, line.size());
+}
+
+// A poll of an idle port with a zero read timeout, the common case of
+// a polling loop: read() throws, tryRead() returns WOULD_BLOCK
+void BM_IdlePollThrow(benchmark::State& state) {
+  PtyPair pty(libserial::CanonicalMode::ENABLE);
+  pty.serial().setReadTimeout(std::chrono::milliseconds(0));
+  char buffer[64];
+
+  for (auto _ : state) {
+    try {
+      pty.serial().read(buffer, sizeof(buffer));
+    }
+    catch (const libserial::IOException& e) {
+      benchmark::DoNotOptimize(e.what());
+    }
+  }
+}
+
+void BM_IdlePollResult(benchmark::State& state) {
+  PtyPair pty(libserial::CanonicalMode::ENABLE);
+  pty.serial().setReadTimeout(std::chrono::milliseconds(0));
+  char buffer[64];
+
+  for (auto _ : state) {
+    libserial::IoResult result = pty.serial().tryRead(buffer, sizeof(buffer));
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+// One-byte ping-pong against an echo thread on the master side. The
+// round-trip percentiles are reported as counters, in microseconds.
+// Mode 0 is the default blocking read (VMIN = 1), mode 1 low latency
+// mode without spinning, mode 2 low latency mode with the default spin.
+void BM_PingPong(benchmark::State& state) {
+  PtyPair pty(libserial::CanonicalMode::DISABLE);
+  pty.serial().setMinNumberCharRead(1);
+  if (state.range(0) == 1) {
+    pty.serial().setLowLatencyMode(true, std::chrono::microseconds(0));
+  }
+  else if (state.range(0) == 2) {
+    pty.serial().setLowLatencyMode(true);
+  }
+
+  std::thread echo([&pty]() {
+      char byte = 0;
+      while (byte != 'q') {
+        pty.drainMaster(&byte, 1);
+        pty.writeMaster(std::string(1, byte));
+      }
+    });
+
+  std::vector<int64_t> samples;
+  samples.reserve(1 << 16);
+  char reply;
+  for (auto _ : state) {
+    auto start = std::chrono::steady_clock::now();
+    pty.serial().write("p", 1);
+    if (pty.serial().readBytes(&reply, 1) != 1) {
+      state.SkipWithError("No reply");
+      break;
+    }
+    samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start).count());
+  }
+
+  pty.serial().write("q", 1);
+  echo.join();
+
+  if (samples.empty()) {
+    return;
+  }
+  std::sort(samples.begin(), samples.end());
+  auto percentile = [&samples](double p) {
+      size_t index = static_cast<size_t>(p / 100.0 * static_cast<double>(samples.size() - 1));
+      return static_cast<double>(samples[index]) / 1000.0;
+    };
+  state.counters["p50_us"] = percentile(50);
+  state.counters["p99_us"] = percentile(99);
+  state.counters["p999_us"] = percentile(99.9);
+}
+
+}  // namespace
+
+BENCHMARK(BM_Write)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK(BM_WriteCaptured)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK(BM_WriteTapped)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK(BM_Read)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK(BM_ReadBytes)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK(BM_ReadUntil)->RangeMultiplier(4)->Range(16, 4096);
+
+BENCHMARK(BM_SetBaudRate);
+BENCHMARK(BM_SetParity);
+BENCHMARK(BM_SetReadTimeout);
+BENCHMARK(BM_ApplyConfig);
+
+BENCHMARK(BM_SmallReadSerial);
+BENCHMARK(BM_SmallReadPolicy);
+BENCHMARK(BM_SmallReadStdFunction);
+
+BENCHMARK(BM_ReadFreshString);
+BENCHMARK(BM_ReadPooled);
+
+BENCHMARK(BM_IdlePollThrow);
+BENCHMARK(BM_IdlePollResult);
+
+BENCHMARK(BM_PingPong)->ArgName("mode")->DenseRange(0, 2)->UseRealTime();
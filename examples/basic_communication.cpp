@@ -2,8 +2,6 @@
 
 #include <iostream>
 #include <memory>
-#include <thread>
-#include <chrono>
 #include <string>
 
 #include "libserial/serial.hpp"
@@ -35,54 +33,36 @@ int main(int argc, const char* argv[]) {
     int current_baud = serial.getBaudRate();
     std::cout << "Current baud rate: " << current_baud << std::endl;
 
+    // Print whatever arrives as soon as it arrives, from a reader thread
+    serial.onData([](const char* data, size_t size) {
+        std::cout << "Received (" << size << " bytes): '" << std::string(data, size) << "'"
+                  << std::endl;
+      });
+    serial.onError([](const libserial::SerialException& e) {
+        std::cerr << "Read error: " << e.what() << std::endl;
+      });
+    serial.startAsyncRead();
+
     // Send a message
     auto message = std::make_shared<std::string>("Hello from libserial!");
     std::cout << "Sending message: '" << *message << "'" << std::endl;
     serial.write(message);
 
-    // Wait a bit for potential response
-    std::cout << "Waiting for response..." << std::endl;
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-
-    // Check for available data
-    int available = serial.getAvailableData();
-    std::cout << "Available data: " << available << " bytes" << std::endl;
-
-    if (available > 0) {
-      auto buffer = std::make_shared<std::string>();
-      size_t bytes_read = serial.read(buffer);
-      std::cout << "Received (" << bytes_read << " bytes): '" << *buffer << "'" << std::endl;
-    } else {
-      std::cout << "No response received." << std::endl;
-      std::cout << "You can send data to the other end of the virtual port." << std::endl;
-    }
-
     // Interactive mode
     std::cout << std::endl;
-    std::cout << "Interactive mode - type messages (Ctrl+C to exit):" << std::endl;
+    std::cout << "Interactive mode - type messages (Ctrl+D to exit):" << std::endl;
     std::string input;
 
-    while (true) {
-      std::cout << "> ";
-      std::getline(std::cin, input);
-
+    while (std::getline(std::cin, input)) {
       if (input.empty()) continue;
 
-      // Send user input
+      // Send user input; responses are printed by the onData callback
       auto user_message = std::make_shared<std::string>(input);
       serial.write(user_message);
       std::cout << "Sent: '" << input << "'" << std::endl;
-
-      // Check for response
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
-      available = serial.getAvailableData();
-
-      if (available > 0) {
-        auto buffer = std::make_shared<std::string>();
-        size_t bytes_read = serial.read(buffer);
-        std::cout << "Received (" << bytes_read << " bytes): '" << *buffer << "'" << std::endl;
-      }
     }
+
+    serial.stopAsyncRead();
   } catch (const libserial::SerialException& e) {
     std::cerr << "Serial error: " << e.what() << std::endl;
     return 1;
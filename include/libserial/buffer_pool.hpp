@@ -0,0 +1,172 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_BUFFER_POOL_HPP_
+#define INCLUDE_LIBSERIAL_BUFFER_POOL_HPP_
+
+#include <cstddef>
+#include <string_view>
+
+namespace libserial {
+
+class PooledBuffer;
+
+/**
+ * @brief Recycles the receive buffers handed out by the pooled read calls
+ *
+ * Buffers are fixed-size slabs in power-of-two size classes from
+ * kMinSlabSize to kMaxSlabSize. Every thread keeps its own free list per
+ * class, so acquiring and releasing a slab takes no lock and, once the
+ * lists are warm, no heap allocation. Slab memory is never zero-filled.
+ *
+ * A slab goes back to the free list of the thread that drops its
+ * PooledBuffer; the lists of a thread are freed when the thread exits.
+ * Requests larger than kMaxSlabSize get a plain allocation that is freed
+ * on release.
+ *
+ * @author Nestor Pereira Neto
+ */
+class BufferPool {
+public:
+/**
+ * @brief Smallest slab size in bytes
+ */
+static constexpr size_t kMinSlabSize = 256;
+
+/**
+ * @brief Largest pooled slab size in bytes
+ */
+static constexpr size_t kMaxSlabSize = 64 * 1024;
+
+/**
+ * @brief Most free slabs kept per size class and thread
+ */
+static constexpr size_t kMaxCachedSlabs = 16;
+
+BufferPool() = delete;
+
+/**
+ * @brief Takes a buffer from the free list of this thread
+ *
+ * @param capacity Minimum capacity in bytes, rounded up to the size class
+ * @return Empty buffer of at least capacity bytes
+ */
+static PooledBuffer acquire(size_t capacity);
+
+/**
+ * @brief Gets the number of free slabs kept by this thread
+ *
+ * @param capacity A capacity within the size class to count
+ * @return Free slabs of the size class holding capacity, 0 above kMaxSlabSize
+ */
+static size_t getCachedCount(size_t capacity);
+
+/**
+ * @brief Frees every slab kept by this thread
+ */
+static void trim();
+
+private:
+friend class PooledBuffer;
+
+/**
+ * @brief Puts a slab back on the free list of this thread
+ *
+ * @param data Slab memory
+ * @param capacity Slab capacity
+ */
+static void release(char* data, size_t capacity);
+};
+
+/**
+ * @brief Handle of a pooled receive buffer
+ *
+ * Move-only. The slab goes back to BufferPool when the handle is
+ * destroyed or reassigned.
+ *
+ * @author Nestor Pereira Neto
+ */
+class PooledBuffer {
+public:
+PooledBuffer() = default;
+~PooledBuffer();
+
+PooledBuffer(PooledBuffer&& other) noexcept;
+PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+PooledBuffer(const PooledBuffer&) = delete;
+PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+/**
+ * @brief Gets the buffer memory
+ *
+ * @return Pointer to capacity() bytes, nullptr for an empty handle
+ */
+char* data() {
+  return data_;
+}
+
+const char* data() const {
+  return data_;
+}
+
+/**
+ * @brief Gets the number of valid bytes
+ *
+ * @return Bytes stored by the read that filled the buffer
+ */
+size_t size() const {
+  return size_;
+}
+
+/**
+ * @brief Sets the number of valid bytes
+ *
+ * @param size New size, at most capacity()
+ */
+void resize(size_t size) {
+  size_ = size;
+}
+
+/**
+ * @brief Gets the size of the slab
+ *
+ * @return Capacity in bytes
+ */
+size_t capacity() const {
+  return capacity_;
+}
+
+/**
+ * @brief Checks whether no byte is stored
+ *
+ * @return true when size() is zero
+ */
+bool empty() const {
+  return size_ == 0;
+}
+
+/**
+ * @brief Gets the stored bytes
+ *
+ * @return View of the first size() bytes, valid while the handle lives
+ */
+std::string_view view() const {
+  return std::string_view(data_, size_);
+}
+
+private:
+friend class BufferPool;
+
+PooledBuffer(char* data, size_t capacity)
+  : data_(data), capacity_(capacity) {
+}
+
+void reset();
+
+char* data_{nullptr};
+size_t size_{0};
+size_t capacity_{0};
+};
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_BUFFER_POOL_HPP_
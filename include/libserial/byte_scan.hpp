@@ -0,0 +1,56 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_BYTE_SCAN_HPP_
+#define INCLUDE_LIBSERIAL_BYTE_SCAN_HPP_
+
+#include <cstddef>
+#include <string_view>
+
+namespace libserial {
+
+/**
+ * @brief Finds the first occurrence of a byte, using the widest vector unit available
+ *
+ * On x86-64 the scan compares up to 128 bytes per iteration with AVX2 when the
+ * CPU supports it (checked once at run time) and 16 bytes with SSE2
+ * otherwise; other architectures use findByteScalar(). This is the
+ * delimiter search behind readUntil(), readLines() and the line
+ * reassembly of the reactor and async reader.
+ *
+ * @param data Pointer to the bytes to scan
+ * @param size Number of bytes
+ * @param byte The byte to look for
+ * @return Pointer to the first match, nullptr if there is none
+ */
+const char* findByte(const char* data, size_t size, char byte);
+
+/**
+ * @brief Portable version of findByte(), eight bytes per step in a general register
+ *
+ * Uses the SWAR "has zero byte" test on 64-bit words, without any
+ * vector instructions.
+ *
+ * @param data Pointer to the bytes to scan
+ * @param size Number of bytes
+ * @param byte The byte to look for
+ * @return Pointer to the first match, nullptr if there is none
+ */
+const char* findByteScalar(const char* data, size_t size, char byte);
+
+/**
+ * @brief Finds the first occurrence of a byte sequence
+ *
+ * Scans with findByte() for the last byte of the sequence, which for
+ * delimiters such as "\r\n" or "OK\r\n" is the rare one, and compares
+ * the preceding bytes only at those candidates.
+ *
+ * @param data Pointer to the bytes to scan
+ * @param size Number of bytes
+ * @param sequence The bytes to look for; must not be empty
+ * @return Pointer to the first byte of the first match, nullptr if there is none
+ */
+const char* findSequence(const char* data, size_t size, std::string_view sequence);
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_BYTE_SCAN_HPP_
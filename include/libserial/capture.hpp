@@ -0,0 +1,297 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_CAPTURE_HPP_
+#define INCLUDE_LIBSERIAL_CAPTURE_HPP_
+
+#include <sys/uio.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace libserial {
+
+/**
+ * @brief First bytes of every capture file; the last digit is the format version
+ */
+inline constexpr char kCaptureMagic[] = "LSERCAP1";
+
+/**
+ * @brief Direction of the bytes of a capture record
+ */
+enum class CaptureDirection : uint8_t {
+  RX = 0,  ///< Received from the port
+  TX = 1   ///< Transmitted to the port
+};
+
+/**
+ * @brief One chunk of captured traffic
+ *
+ * A record holds the bytes moved by a single read or write system call,
+ * so the chunk boundaries of the original traffic are kept.
+ *
+ * @author Nestor Pereira Neto
+ */
+struct CaptureRecord {
+/**
+ * @brief CLOCK_MONOTONIC time of the system call
+ */
+std::chrono::nanoseconds timestamp{0};
+
+/**
+ * @brief Whether the bytes were received or transmitted
+ */
+CaptureDirection direction{CaptureDirection::RX};
+
+/**
+ * @brief The bytes moved by the call
+ */
+std::string data;
+};
+
+/**
+ * @brief Appends timestamped traffic to a capture file
+ *
+ * The file starts with the 8-byte magic kCaptureMagic, followed by
+ * records of a 13-byte little-endian header - int64 timestamp in
+ * nanoseconds, uint32 size, uint8 direction - and the data bytes.
+ *
+ * record() only copies the chunk into a pending batch under a short
+ * lock; a background thread writes the batches to disk, so the I/O path
+ * of the port never waits on the file system. The thread collects
+ * records for up to kBatchInterval, or until a quarter of max_pending
+ * is waiting, before each write. When more than max_pending bytes are
+ * waiting, new records are dropped and counted instead of blocking.
+ * Safe to share between ports and threads.
+ *
+ * @author Nestor Pereira Neto
+ */
+class CaptureWriter {
+public:
+/**
+ * @brief Default limit of bytes waiting to be written
+ */
+static constexpr size_t kDefaultMaxPending = 4 * 1024 * 1024;
+
+/**
+ * @brief Longest time a record waits before its batch is written
+ */
+static constexpr std::chrono::milliseconds kBatchInterval{10};
+
+/**
+ * @brief Constructor of the CaptureWriter class
+ *
+ * Opens path for appending and creates it when missing. An existing
+ * non-empty file must be a capture file.
+ *
+ * @param path Path of the capture file
+ * @param max_pending Most bytes kept waiting for the writer thread
+ * @throws SerialException if the file cannot be opened or is not a capture file
+ */
+explicit CaptureWriter(const std::string& path, size_t max_pending = kDefaultMaxPending);
+
+/**
+ * @brief Destructor; writes out every pending record and closes the file
+ */
+~CaptureWriter();
+
+CaptureWriter(const CaptureWriter&) = delete;
+CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+/**
+ * @brief Records a chunk, timestamped now
+ *
+ * @param direction Whether the bytes were received or transmitted
+ * @param data Pointer to the bytes
+ * @param size Number of bytes
+ */
+void record(CaptureDirection direction, const void* data, size_t size);
+
+/**
+ * @brief Records the first size bytes of a segment list as one chunk
+ *
+ * @param direction Whether the bytes were received or transmitted
+ * @param segments Segments of a readv() or writev() call
+ * @param count Number of entries in segments
+ * @param size Bytes moved by the call, at most the sum of the segment lengths
+ */
+void record(CaptureDirection direction, const struct iovec* segments, int count, size_t size);
+
+/**
+ * @brief Writes the pending batch now and waits until it is in the file
+ *
+ * @throws SerialException if writing the file failed
+ */
+void flush();
+
+/**
+ * @brief Gets the number of records dropped because the batch was full
+ *
+ * @return Dropped records since construction
+ */
+uint64_t getDroppedRecords() const;
+
+/**
+ * @brief Gets the path of the capture file
+ *
+ * @return The path passed to the constructor
+ */
+const std::string& getPath() const;
+
+private:
+/**
+ * @brief Body of the writer thread
+ */
+void writerLoop();
+
+/**
+ * @brief Copies a record header into the pending batch; mutex_ must be held
+ *
+ * @return false when the record does not fit and was dropped
+ */
+bool appendHeader(CaptureDirection direction, size_t size);
+
+/**
+ * @brief Accounts a record appended after appendHeader() and wakes the writer
+ *
+ * The writer thread is only signaled when the batch becomes non-empty
+ * or reaches wake_size_, so most records cost no system call.
+ *
+ * @param lock Lock of mutex_, released before signaling
+ * @param before Size of pending_ before the record was appended
+ */
+void finishRecord(std::unique_lock<std::mutex>& lock, size_t before);
+
+std::string path_;
+int fd_{-1};
+size_t max_pending_;
+size_t wake_size_;  ///< Batch size that wakes the writer early
+
+mutable std::mutex mutex_;
+std::condition_variable pending_cv_;
+std::condition_variable written_cv_;
+std::vector<char> pending_;
+uint64_t appended_{0};  ///< Bytes ever appended to pending_
+uint64_t written_{0};   ///< Bytes of those written to the file
+uint64_t dropped_{0};
+int write_error_{0};
+bool flush_requested_{false};
+bool stop_{false};
+std::thread thread_;
+};
+
+/**
+ * @brief Reads the records of a capture file in order
+ *
+ * A record cut short at the end of the file, e.g. by a crash while
+ * capturing, ends the capture.
+ *
+ * @author Nestor Pereira Neto
+ */
+class CaptureReader {
+public:
+/**
+ * @brief Constructor of the CaptureReader class
+ *
+ * @param path Path of the capture file
+ * @throws SerialException if the file cannot be opened or is not a capture file
+ */
+explicit CaptureReader(const std::string& path);
+
+/**
+ * @brief Reads the next record
+ *
+ * @param record Filled with the record read
+ * @return false at the end of the capture
+ */
+bool next(CaptureRecord& record);
+
+private:
+std::ifstream file_;
+};
+
+/**
+ * @brief How CaptureReplayer paces the records
+ */
+enum class ReplayTiming {
+  ORIGINAL,  ///< Keep the time between records as captured
+  FAST       ///< Write every record as soon as the port accepts it
+};
+
+/**
+ * @brief Plays captured traffic back through a pseudo-terminal
+ *
+ * Creates a raw pty pair; the code under test opens getPortName() like
+ * a real port, e.g. with Serial. replay() writes the received (RX)
+ * records of a capture into the master side, one write per record, so
+ * the decoder sees the original chunks. Bytes the code under test
+ * transmits are read and discarded meanwhile.
+ *
+ * @author Nestor Pereira Neto
+ */
+class CaptureReplayer {
+public:
+/**
+ * @brief Constructor of the CaptureReplayer class
+ *
+ * @throws SerialException if the pseudo-terminal cannot be created
+ */
+CaptureReplayer();
+
+/**
+ * @brief Destructor; closes both ends of the pseudo-terminal
+ */
+~CaptureReplayer();
+
+CaptureReplayer(const CaptureReplayer&) = delete;
+CaptureReplayer& operator=(const CaptureReplayer&) = delete;
+
+/**
+ * @brief Gets the device path to open as the port under test
+ *
+ * @return Path of the pty slave, e.g. /dev/pts/3
+ */
+const std::string& getPortName() const;
+
+/**
+ * @brief Plays the RX records of a capture file
+ *
+ * Blocks until every record has been written.
+ *
+ * @param path Path of the capture file
+ * @param timing ReplayTiming::ORIGINAL to keep the captured pacing
+ * @return Number of bytes written
+ * @throws SerialException if the capture cannot be read or the pty fails
+ */
+size_t replay(const std::string& path, ReplayTiming timing = ReplayTiming::ORIGINAL);
+
+private:
+/**
+ * @brief Writes a whole chunk to the master, discarding incoming bytes
+ *
+ * @param data Pointer to the bytes
+ * @param size Number of bytes
+ */
+void writeChunk(const char* data, size_t size);
+
+/**
+ * @brief Discards incoming bytes until deadline
+ *
+ * @param deadline When to return
+ */
+void drainUntil(std::chrono::steady_clock::time_point deadline);
+
+int master_fd_{-1};
+int slave_fd_{-1};
+std::string port_name_;
+};
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_CAPTURE_HPP_
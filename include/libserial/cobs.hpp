@@ -0,0 +1,118 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_COBS_HPP_
+#define INCLUDE_LIBSERIAL_COBS_HPP_
+
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "libserial/stream_framer.hpp"
+
+namespace libserial {
+
+/**
+ * @brief Consistent Overhead Byte Stuffing (COBS) framing on top of Serial
+ *
+ * Frames travel COBS-encoded and delimited by 0x00. Outgoing frames are
+ * encoded into a list of segments that point into the caller's payload
+ * and handed to Serial::writev(), so the payload is never copied into an
+ * encoded string. Incoming bytes are decoded as they arrive, straight
+ * into the frame buffer; see StreamFramer for the read APIs.
+ *
+ * A delimiter in the middle of a block, or a frame longer than the
+ * maximum size, drops the frame; decoding resumes at the next delimiter.
+ *
+ * @author Nestor Pereira Neto
+ */
+class CobsFramer : public StreamFramer {
+public:
+/**
+ * @brief Constructor of the CobsFramer class
+ *
+ * @param serial The port frames are read from and written to
+ * @param max_frame_size Largest decoded frame accepted, in bytes
+ * @throws SerialException if max_frame_size is zero
+ */
+explicit CobsFramer(Serial& serial, size_t max_frame_size = kDefaultMaxFrameSize);
+
+/**
+ * @brief Gets the worst-case encoded size of a frame, delimiter included
+ *
+ * @param size Decoded frame size in bytes
+ * @return Upper bound of the bytes written by writeFrame()
+ */
+static size_t getMaxEncodedSize(size_t size);
+
+using StreamFramer::writeFrame;
+
+/**
+ * @brief Encodes a frame and writes it with a single writev()
+ *
+ * @param data Pointer to the frame payload
+ * @param size Number of payload bytes
+ * @return Number of bytes written, delimiter included
+ * @throws IOException if write operation fails
+ * @throws IOException if data is null while size is not zero
+ * @throws TimeoutException if the write timeout expires
+ */
+size_t writeFrame(const void* data, size_t size) override;
+
+protected:
+size_t decode(const uint8_t* data, size_t size, bool* frame_done) override;
+void resetFrame() override;
+
+private:
+/**
+ * @brief Reports a dropped frame and resets the decoder
+ *
+ * @param message Description of the error
+ * @param skip_to_delimiter Whether input up to the next delimiter must be skipped
+ */
+void dropFrame(const std::string& message, bool skip_to_delimiter);
+
+/**
+ * @brief Appends decoded bytes, dropping the frame if it grows too large
+ *
+ * @return false if the frame was dropped
+ */
+bool appendOrDrop(const uint8_t* data, size_t size);
+
+/**
+ * @brief Data bytes left in the current block
+ */
+size_t block_left_{0};
+
+/**
+ * @brief Whether the previous block ended with an implied zero
+ */
+bool pending_zero_{false};
+
+/**
+ * @brief Whether the current block's code is 0xFF (no implied zero)
+ */
+bool full_block_{false};
+
+/**
+ * @brief Whether a code byte of the current frame was seen
+ */
+bool in_frame_{false};
+
+/**
+ * @brief Whether input is skipped until the next delimiter
+ */
+bool discarding_{false};
+
+/**
+ * @brief Code bytes and segments of the frame being written, reused across frames
+ */
+std::vector<uint8_t> codes_;
+std::vector<struct iovec> segments_;
+};
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_COBS_HPP_
@@ -0,0 +1,54 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_CRC_HPP_
+#define INCLUDE_LIBSERIAL_CRC_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace libserial {
+
+/**
+ * @brief Computes CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF)
+ *
+ * Table driven, one byte per step. Pass the previous result as crc to
+ * continue a checksum over several buffers.
+ *
+ * @param data Pointer to the bytes
+ * @param size Number of bytes
+ * @param crc Checksum of the preceding bytes, 0xFFFF to start
+ * @return Checksum of all bytes so far
+ */
+uint16_t crc16Ccitt(const void* data, size_t size, uint16_t crc = 0xFFFF);
+
+/**
+ * @brief Computes CRC-32 (IEEE 802.3, as used by zlib and Ethernet)
+ *
+ * Slice-by-8: eight table lookups per 8 input bytes. On AArch64 CPUs
+ * with the CRC extension the CRC32X instruction is used instead. Pass
+ * the previous result as crc to continue a checksum over several buffers.
+ *
+ * @param data Pointer to the bytes
+ * @param size Number of bytes
+ * @param crc Checksum of the preceding bytes, 0 to start
+ * @return Checksum of all bytes so far
+ */
+uint32_t crc32(const void* data, size_t size, uint32_t crc = 0);
+
+/**
+ * @brief Computes CRC-32C (Castagnoli, as used by iSCSI and ext4)
+ *
+ * Uses the SSE4.2 CRC32 instruction when the CPU has it (checked once at
+ * run time) or CRC32CX on AArch64, and slice-by-8 otherwise. Pass the
+ * previous result as crc to continue a checksum over several buffers.
+ *
+ * @param data Pointer to the bytes
+ * @param size Number of bytes
+ * @param crc Checksum of the preceding bytes, 0 to start
+ * @return Checksum of all bytes so far
+ */
+uint32_t crc32c(const void* data, size_t size, uint32_t crc = 0);
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_CRC_HPP_
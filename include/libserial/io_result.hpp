@@ -0,0 +1,117 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_IO_RESULT_HPP_
+#define INCLUDE_LIBSERIAL_IO_RESULT_HPP_
+
+#include <cstddef>
+
+namespace libserial {
+
+/**
+ * @enum IoStatus
+ * @brief Outcome of a non-throwing I/O call
+ */
+enum class IoStatus {
+  OK,                ///< The call completed; getBytes() holds the bytes transferred
+  TIMEOUT,           ///< The read or write timeout expired
+  WOULD_BLOCK,       ///< No data was ready and the timeout is zero
+  CLOSED,            ///< The other end closed the connection
+  LIMIT_EXCEEDED,    ///< The size limit was reached before the terminator was found
+  INVALID_ARGUMENT,  ///< The call was made with invalid arguments or in the wrong mode
+  SYSTEM_ERROR       ///< A system call failed; getErrno() holds the error
+};
+
+/**
+ * @brief Result of a non-throwing I/O call
+ *
+ * Carries the bytes transferred and, on failure, the reason. Building a
+ * result never allocates: the message is a static string and the
+ * system error is kept as an errno value, to be formatted only if the
+ * caller wants to. Bytes may be non-zero on failure, e.g. the part of a
+ * write that went out before the timeout.
+ *
+ * @author Nestor Pereira Neto
+ */
+class IoResult {
+public:
+/**
+ * @brief Constructor of a successful result
+ *
+ * @param bytes Number of bytes transferred
+ */
+constexpr IoResult(size_t bytes = 0) noexcept  // NOLINT(runtime/explicit)
+  : bytes_(bytes) {
+}
+
+/**
+ * @brief Constructor of a failed result
+ *
+ * @param status Reason of the failure
+ * @param message Static description of the failure
+ * @param error The errno value for IoStatus::SYSTEM_ERROR, zero otherwise
+ * @param bytes Number of bytes transferred before the failure
+ */
+constexpr IoResult(IoStatus status, const char* message, int error = 0,
+                   size_t bytes = 0) noexcept
+  : status_(status), bytes_(bytes), error_(error), message_(message) {
+}
+
+/**
+ * @brief Checks whether the call completed
+ *
+ * @return true for IoStatus::OK
+ */
+constexpr bool ok() const noexcept {
+  return status_ == IoStatus::OK;
+}
+
+constexpr explicit operator bool() const noexcept {
+  return this->ok();
+}
+
+/**
+ * @brief Gets the outcome of the call
+ *
+ * @return The status
+ */
+constexpr IoStatus getStatus() const noexcept {
+  return status_;
+}
+
+/**
+ * @brief Gets the number of bytes transferred
+ *
+ * @return Bytes read or written, also on failure
+ */
+constexpr size_t getBytes() const noexcept {
+  return bytes_;
+}
+
+/**
+ * @brief Gets the system error of a failed system call
+ *
+ * @return The errno value, zero unless the status is IoStatus::SYSTEM_ERROR
+ */
+constexpr int getErrno() const noexcept {
+  return error_;
+}
+
+/**
+ * @brief Gets a description of the failure
+ *
+ * @return Static string, empty for a successful result
+ */
+constexpr const char* getMessage() const noexcept {
+  return message_;
+}
+
+private:
+IoStatus status_{IoStatus::OK};
+size_t bytes_{0};
+int error_{0};
+const char* message_{""};
+};
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_IO_RESULT_HPP_
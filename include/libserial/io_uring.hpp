@@ -0,0 +1,214 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_IO_URING_HPP_
+#define INCLUDE_LIBSERIAL_IO_URING_HPP_
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace libserial {
+
+/**
+ * @brief A minimal io_uring submission/completion ring
+ *
+ * The IoUring class sets up a ring with the raw io_uring_setup(2),
+ * io_uring_enter(2) and io_uring_register(2) system calls, so no
+ * liburing dependency is needed. Callers fill submission entries with
+ * getSqe(), submit them together with submitAndWait() and drain the
+ * results with forEachCompletion().
+ *
+ * Construction fails on kernels without IORING_FEAT_EXT_ARG (Linux 5.11),
+ * which is needed for timed waits; callers are expected to fall back to
+ * their poll-based path in that case.
+ *
+ * @author Nestor Pereira Neto
+ */
+class IoUring {
+public:
+/**
+ * @brief Constructor of the IoUring class
+ *
+ * @param entries Requested number of submission queue entries
+ * @throws SerialException if the ring cannot be created or the kernel is too old
+ */
+explicit IoUring(unsigned int entries);
+IoUring(const IoUring&) = delete;
+IoUring& operator=(const IoUring&) = delete;
+
+/**
+ * @brief Destructor of the IoUring class
+ *
+ * Unmaps the rings and closes the ring descriptor.
+ */
+~IoUring() noexcept;
+
+/**
+ * @brief Checks whether io_uring is usable on this system
+ *
+ * The result is probed once and cached.
+ *
+ * @return true if an IoUring can be constructed
+ */
+static bool isSupported();
+
+/**
+ * @brief Registers fixed buffers for IORING_OP_READ_FIXED/WRITE_FIXED
+ *
+ * @param buffers Array of buffers to register
+ * @param count Number of buffers
+ * @return true on success, false if the kernel refused the registration
+ */
+bool registerBuffers(const struct iovec* buffers, unsigned int count);
+
+/**
+ * @brief Gets the next free submission queue entry
+ *
+ * The entry is zeroed and queued for the next submitAndWait().
+ *
+ * @return Pointer to the entry, nullptr when the submission queue is full
+ */
+struct io_uring_sqe* getSqe();
+
+/**
+ * @brief Gets the number of submission queue entries still free
+ *
+ * @return Number of entries getSqe() can hand out before a submit
+ */
+unsigned int getFreeSqes() const;
+
+/**
+ * @brief Submits all queued entries and optionally waits for completions
+ *
+ * Everything queued since the last call goes to the kernel in a single
+ * io_uring_enter(2).
+ *
+ * @param min_complete Number of completions to wait for; 0 does not wait
+ * @param timeout Maximum wait; negative values wait indefinitely
+ * @return Number of entries consumed by the kernel
+ * @throws SerialException if io_uring_enter fails
+ */
+unsigned int submitAndWait(unsigned int min_complete, std::chrono::nanoseconds timeout);
+
+/**
+ * @brief Invokes a callable for every pending completion
+ *
+ * Each completion is consumed before the callable runs, so it may queue
+ * new submissions.
+ *
+ * @param handler Callable invoked as handler(const struct io_uring_cqe&)
+ * @return Number of completions handled
+ */
+template <typename Handler>
+size_t forEachCompletion(Handler handler) {
+  size_t handled = 0;
+  uint32_t head = *cq_head_;
+  while (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+    struct io_uring_cqe cqe = cqes_[head & *cq_mask_];
+    head++;
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    handler(cqe);
+    handled++;
+  }
+  return handled;
+}
+
+#ifdef BUILD_TESTING_ON
+// WARNING: Test helper only! Replaces the io_uring_setup system call for
+// every IoUring constructed afterwards, so tests can force the fallback
+// path. Pass nullptr to restore the real system call.
+static void setSetupSystemFunction(
+  std::function<int(unsigned int, struct io_uring_params*)> setup_func) {
+  setup_ = setup_func ? setup_func : defaultSetup();
+}
+#endif
+
+private:
+/**
+ * @brief The real io_uring_setup system call
+ *
+ * @return A callable wrapping io_uring_setup(2)
+ */
+static std::function<int(unsigned int, struct io_uring_params*)> defaultSetup();
+
+/**
+ * @brief Setup system call function wrapper
+ *
+ * Allows injection of a custom io_uring_setup function for testing.
+ */
+static std::function<int(unsigned int, struct io_uring_params*)> setup_;
+
+/**
+ * @brief Releases the mappings and the ring descriptor
+ */
+void release();
+
+/**
+ * @brief The ring file descriptor
+ */
+int ring_fd_{-1};
+
+/**
+ * @brief Mapping holding the submission ring (and the completion ring
+ * when the kernel supports a single mmap)
+ */
+void* sq_ring_{nullptr};
+
+/**
+ * @brief Size of the submission ring mapping
+ */
+size_t sq_ring_size_{0};
+
+/**
+ * @brief Mapping holding the completion ring when mapped separately
+ */
+void* cq_ring_{nullptr};
+
+/**
+ * @brief Size of the completion ring mapping
+ */
+size_t cq_ring_size_{0};
+
+/**
+ * @brief Mapping holding the submission queue entries
+ */
+struct io_uring_sqe* sqes_{nullptr};
+
+/**
+ * @brief Size of the submission queue entry mapping
+ */
+size_t sqes_size_{0};
+
+/**
+ * @brief Pointers into the shared submission ring
+ */
+uint32_t* sq_head_{nullptr};
+uint32_t* sq_tail_{nullptr};
+uint32_t* sq_mask_{nullptr};
+uint32_t* sq_array_{nullptr};
+
+/**
+ * @brief Pointers into the shared completion ring
+ */
+uint32_t* cq_head_{nullptr};
+uint32_t* cq_tail_{nullptr};
+uint32_t* cq_mask_{nullptr};
+struct io_uring_cqe* cqes_{nullptr};
+
+/**
+ * @brief Number of submission queue entries
+ */
+uint32_t sq_entries_{0};
+
+/**
+ * @brief Local submission tail, published to the kernel on submit
+ */
+uint32_t sqe_tail_{0};
+};
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_IO_URING_HPP_
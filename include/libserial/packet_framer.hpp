@@ -0,0 +1,146 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_PACKET_FRAMER_HPP_
+#define INCLUDE_LIBSERIAL_PACKET_FRAMER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "libserial/stream_framer.hpp"
+
+namespace libserial {
+
+/**
+ * @brief Integrity check appended to every packet
+ */
+enum class FrameCheck {
+  CRC16_CCITT,  ///< CRC-16/CCITT-FALSE, 2 bytes
+  CRC32,        ///< CRC-32 (IEEE 802.3), 4 bytes
+  CRC32C        ///< CRC-32C (Castagnoli), 4 bytes, hardware accelerated
+};
+
+/**
+ * @brief Length-prefixed binary packets with a CRC, on top of Serial
+ *
+ * Wire format, multi-byte fields little-endian:
+ *
+ *     | 0xA5 0x5A | length (2) | payload (length) | CRC (2 or 4) |
+ *
+ * The CRC covers the length field and the payload. Packets are written
+ * with one writev() of header, payload and CRC, without copying the
+ * payload. Received packets are decoded in place: the payload handed to
+ * the caller is the one read from the port.
+ *
+ * A header with an out-of-range length or a CRC mismatch is reported as
+ * a framing error. Instead of discarding what was received, the decoder
+ * then scans the buffered bytes after the bad sync word for the next
+ * one, so a packet that followed a corrupted one is still recovered.
+ *
+ * @author Nestor Pereira Neto
+ */
+class PacketFramer : public StreamFramer {
+public:
+/**
+ * @brief Sync word opening every packet
+ */
+static constexpr uint8_t kSync[2] = {0xA5, 0x5A};
+
+/**
+ * @brief Size of the sync word and length field
+ */
+static constexpr size_t kHeaderSize = 4;
+
+/**
+ * @brief Largest payload the length field can describe
+ */
+static constexpr size_t kMaxPayloadSize = 0xFFFF;
+
+/**
+ * @brief Constructor of the PacketFramer class
+ *
+ * @param serial The port packets are read from and written to
+ * @param check The integrity check used in both directions
+ * @param max_frame_size Largest payload accepted, in bytes
+ * @throws SerialException if max_frame_size is zero or above kMaxPayloadSize
+ */
+explicit PacketFramer(Serial& serial, FrameCheck check = FrameCheck::CRC16_CCITT,
+                      size_t max_frame_size = kDefaultMaxFrameSize);
+
+/**
+ * @brief Gets the integrity check in use
+ *
+ * @return The frame check
+ */
+FrameCheck getFrameCheck() const;
+
+using StreamFramer::writeFrame;
+
+/**
+ * @brief Writes a packet with a single writev()
+ *
+ * @param data Pointer to the payload
+ * @param size Number of payload bytes
+ * @return Number of bytes written, header and CRC included
+ * @throws IOException if write operation fails
+ * @throws IOException if data is null while size is not zero
+ * @throws IOException if size exceeds the maximum frame size
+ * @throws TimeoutException if the write timeout expires
+ */
+size_t writeFrame(const void* data, size_t size) override;
+
+protected:
+size_t decode(const uint8_t* data, size_t size, bool* frame_done) override;
+void resetFrame() override;
+bool hasPendingInput() const override;
+
+private:
+/**
+ * @brief Computes the configured CRC over the length field and payload
+ */
+uint32_t checksum(const uint8_t* length_field, const uint8_t* payload, size_t size) const;
+
+/**
+ * @brief Gets the number of buffered bytes needed for the next decision
+ */
+size_t needed() const;
+
+/**
+ * @brief Drops the leading sync word and moves to the next candidate one
+ */
+void resync();
+
+/**
+ * @brief The integrity check in use
+ */
+FrameCheck check_;
+
+/**
+ * @brief Size of the CRC field in bytes
+ */
+size_t crc_size_;
+
+/**
+ * @brief Received bytes buffered in frame_, from the candidate sync word on
+ */
+size_t raw_size_{0};
+
+/**
+ * @brief End of the delivered packet in frame_, 0 while none is delivered
+ */
+size_t packet_end_{0};
+
+/**
+ * @brief Whether the buffered header was validated
+ */
+bool header_valid_{false};
+
+/**
+ * @brief Header and CRC of the packet being written
+ */
+uint8_t tx_header_[kHeaderSize];
+uint8_t tx_crc_[4];
+};
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_PACKET_FRAMER_HPP_
@@ -13,17 +13,29 @@
 #include <asm/termbits.h>
 #include <sys/ioctl.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 #include <chrono>
 #include <iostream>
 #include <memory>
 #include <functional>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <utility>
 #include <vector>
 
+#include "libserial/buffer_pool.hpp"
+#include "libserial/capture.hpp"
+#include "libserial/io_result.hpp"
+#include "libserial/serial_awaitable.hpp"
+#include "libserial/serial_config.hpp"
 #include "libserial/serial_exception.hpp"
+#include "libserial/serial_stats.hpp"
 #include "libserial/serial_types.hpp"
+#include "libserial/spsc_ring.hpp"
+#include "libserial/system_calls.hpp"
+#include "libserial/traffic_tap.hpp"
 
 /**
  * @brief Serial Interface Library libserial namespace
@@ -66,6 +78,15 @@ Serial& operator=(const Serial&) = delete;
  */
 explicit Serial(const std::string& port);
 
+/**
+ * @brief Constructor that opens and configures a port in one step
+ *
+ * @param port The device path (e.g., "/dev/ttyUSB0", "/dev/ttyS0")
+ * @param config The configuration applied right after opening
+ * @throws SerialException if the port cannot be opened or configured
+ */
+Serial(const std::string& port, const SerialConfig& config);
+
 /**
  * @brief Destructor
  *
@@ -83,6 +104,18 @@ explicit Serial(const std::string& port);
  */
 void open(const std::string& port);
 
+/**
+ * @brief Opens a serial port and applies a configuration
+ *
+ * The configuration is applied with a single TCSETS2 right after the
+ * port is opened. If it cannot be applied the port is closed again.
+ *
+ * @param port The device path to open (e.g., "/dev/ttyUSB0")
+ * @param config The configuration to apply
+ * @throws SerialException if the port cannot be opened or configured
+ */
+void open(const std::string& port, const SerialConfig& config);
+
 /**
  * @brief Closes the currently open serial port
  *
@@ -93,25 +126,60 @@ void close();
 /**
  * @brief Writes data to the serial port
  *
- * Sends the provided string data to the serial port. A carriage return
- * character ('\\r') is automatically appended to the data.
+ * Sends the provided string data to the serial port. This is a thin
+ * wrapper over write(const void*, size_t).
  *
  * @param data Shared pointer to the string data to write
- * @throws SerialException if write operation fails
- * @throws std::invalid_argument if data pointer is null
- *
- * @note The original string is not modified; a copy is made with the
- *       terminator appended.
+ * @throws IOException if write operation fails
+ * @throws IOException if data pointer is null
+ * @throws TimeoutException if the write timeout expires before every byte is sent
  */
 void write(std::shared_ptr<std::string> data);
 
+/**
+ * @brief Writes raw bytes from caller memory to the serial port
+ *
+ * Zero-copy variant of write(): the bytes are handed to the kernel
+ * straight from the caller's buffer, without an intermediate string.
+ * Short writes are retried until every byte has been accepted. When the
+ * output queue is full the call waits for POLLOUT, bounded by the write
+ * timeout (see setWriteTimeout()).
+ *
+ * @param data Pointer to the bytes to write
+ * @param size Number of bytes to write
+ * @return Number of bytes written, always equal to size
+ * @throws IOException if write operation fails
+ * @throws IOException if data pointer is null
+ * @throws TimeoutException if the write timeout expires; bytesTransferred()
+ *         reports how many bytes were sent
+ */
+size_t write(const void* data, size_t size);
+
+/**
+ * @brief Writes a list of buffer segments to the serial port
+ *
+ * Scatter/gather variant of write(): the segments (e.g. header, payload
+ * and trailer of a frame) are submitted with a single writev() system
+ * call, without concatenating them first. Partial writes and the write
+ * timeout are handled exactly like write().
+ *
+ * @param segments Array of segments to write, in order
+ * @param count Number of entries in segments
+ * @return Total number of bytes written, always the sum of all segment lengths
+ * @throws IOException if write operation fails
+ * @throws IOException if segments is null while count is not zero
+ * @throws TimeoutException if the write timeout expires; bytesTransferred()
+ *         reports how many bytes were sent
+ */
+size_t writev(const struct iovec* segments, size_t count);
+
 /**
  * @brief Reads data from serial port into a shared pointer buffer
  *
- * Reads up to max_length bytes from the serial port and stores them
- * in the provided shared string buffer. This version provides better
- * memory management and avoids unnecessary string copies. Just works
- * in canonical mode.
+ * Reads up to max_safe_read_size_ bytes from the serial port and stores
+ * them in the provided shared string buffer. Bytes already held in the
+ * internal receive buffer are returned first without touching the port.
+ * Just works in canonical mode.
  *
  * @param buffer Shared pointer to string where data will be stored
  * @return Number of bytes actually read
@@ -122,11 +190,31 @@ void write(std::shared_ptr<std::string> data);
  */
 size_t read(std::shared_ptr<std::string> buffer);
 
+/**
+ * @brief Reads data from serial port into caller memory
+ *
+ * Zero-copy variant of read(): bytes go straight into the caller's
+ * buffer, no string or heap allocation is involved. Just works in
+ * canonical mode.
+ *
+ * @param buffer Pointer to the memory where data will be stored
+ * @param size Capacity of buffer in bytes
+ * @return Number of bytes actually read
+ * @throws IOException if read operation fails
+ * @throws IOException if buffer is null
+ */
+size_t read(void* buffer, size_t size);
+
 /**
  * @brief Reads a specific number of bytes from the serial port
  *
- * Reads exactly num_bytes from the serial port and stores them
- * in the provided shared string buffer. Just works in non-canonical mode.
+ * Reads up to num_bytes from the serial port and stores them in the
+ * provided shared string buffer. Bytes already held in the internal
+ * receive buffer are returned first. Just works in non-canonical mode.
+ *
+ * On the default blocking descriptor the wait follows VMIN/VTIME, with
+ * VTIME derived from the read timeout; after setNonBlocking(true) it
+ * happens in poll() for up to the read timeout.
  *
  * @param buffer Shared pointer to string where data will be stored
  * @param num_bytes Number of bytes to read
@@ -139,26 +227,400 @@ size_t read(std::shared_ptr<std::string> buffer);
  */
 size_t readBytes(std::shared_ptr<std::string> buffer, size_t num_bytes);
 
+/**
+ * @brief Reads a specific number of bytes into caller memory
+ *
+ * Zero-copy variant of readBytes(). Just works in non-canonical mode.
+ *
+ * @param buffer Pointer to the memory where data will be stored
+ * @param num_bytes Number of bytes to read; buffer must hold at least this many
+ * @return Number of bytes actually read
+ * @throws IOException if read operation fails
+ * @throws IOException if buffer is null
+ * @throws IOException if num_bytes is zero
+ */
+size_t readBytes(void* buffer, size_t num_bytes);
+
 /**
  * @brief Reads data until a specific terminator character is found
  *
- * Continues reading byte by byte until the specified terminator
- * character is encountered. The terminator is included in the result.
+ * Continues reading until the specified terminator character is
+ * encountered. The terminator is included in the result. Data is pulled
+ * from the port in bulk into the internal receive buffer; any bytes that
+ * follow the terminator stay buffered for the next read call.
  * Works in both canonical and non-canonical modes.
  *
+ * @param buffer Shared pointer to string where data will be stored
  * @param terminator The character to stop reading at
- * @return String containing all read data including the terminator
+ * @return Number of bytes stored in buffer, including the terminator
  * @throws SerialException if read operation fails
- *
- * @warning This method reads one byte at a time and may be slower
- *          for large amounts of data
  */
 size_t readUntil(std::shared_ptr<std::string> buffer, char terminator);
 
+/**
+ * @brief Reads data into caller memory until a terminator is found
+ *
+ * Zero-copy variant of readUntil(). At most the smaller of size and
+ * max_safe_read_size_ bytes are stored, terminator included.
+ *
+ * @param buffer Pointer to the memory where data will be stored
+ * @param size Capacity of buffer in bytes
+ * @param terminator The character to stop reading at
+ * @return Number of bytes stored in buffer, including the terminator
+ * @throws IOException if read operation fails
+ * @throws IOException if buffer is null
+ */
+size_t readUntil(void* buffer, size_t size, char terminator);
+
+/**
+ * @brief Reads data until a multi-byte delimiter is found
+ *
+ * Like readUntil(std::shared_ptr<std::string>, char), for delimiters of
+ * several bytes such as "\r\n" or "OK\r\n". The delimiter is matched
+ * on the buffered data, so one split across two reads is still found.
+ * The delimiter is included in the result.
+ *
+ * @param buffer Shared pointer to string where data will be stored
+ * @param delimiter The byte sequence to stop reading at
+ * @return Number of bytes stored in buffer, including the delimiter
+ * @throws IOException if read operation fails, on timeout or when the
+ *         maximum read size is exceeded
+ * @throws IOException if buffer is null
+ * @throws IOException if delimiter is empty or longer than the maximum read size
+ */
+size_t readUntil(std::shared_ptr<std::string> buffer, std::string_view delimiter);
+
+/**
+ * @brief Reads data into caller memory until a multi-byte delimiter is found
+ *
+ * Zero-copy variant of readUntil(std::shared_ptr<std::string>, std::string_view).
+ * At most the smaller of size and max_safe_read_size_ bytes are stored,
+ * delimiter included.
+ *
+ * @param buffer Pointer to the memory where data will be stored
+ * @param size Capacity of buffer in bytes
+ * @param delimiter The byte sequence to stop reading at
+ * @return Number of bytes stored in buffer, including the delimiter
+ * @throws IOException if read operation fails
+ * @throws IOException if buffer is null
+ * @throws IOException if delimiter is empty or longer than the maximum read size
+ */
+size_t readUntil(void* buffer, size_t size, std::string_view delimiter);
+
+/**
+ * @brief Reads data into a buffer taken from BufferPool
+ *
+ * Pooled variant of read(std::shared_ptr<std::string>): the slab comes
+ * from the free list of this thread and goes back there when the
+ * returned handle is dropped, so steady-state reception allocates
+ * nothing. Just works in canonical mode.
+ *
+ * @return Buffer holding the bytes read, up to max_safe_read_size_
+ * @throws IOException if read operation fails or on timeout
+ */
+PooledBuffer readPooled();
+
+/**
+ * @brief Reads a specific number of bytes into a buffer taken from BufferPool
+ *
+ * Pooled variant of readBytes(). Just works in non-canonical mode.
+ *
+ * @param num_bytes Number of bytes to read
+ * @return Buffer holding the bytes read, at most num_bytes
+ * @throws IOException if read operation fails
+ * @throws IOException if num_bytes is zero
+ */
+PooledBuffer readBytesPooled(size_t num_bytes);
+
+/**
+ * @brief Reads until a terminator into a buffer taken from BufferPool
+ *
+ * Pooled variant of readUntil().
+ *
+ * @param terminator The character to stop reading at
+ * @return Buffer holding the bytes read, terminator included
+ * @throws IOException if read operation fails, on timeout or when
+ *         max_safe_read_size_ is exceeded
+ */
+PooledBuffer readUntilPooled(char terminator);
+
+/**
+ * @brief Reads until a multi-byte delimiter into a buffer taken from BufferPool
+ *
+ * @param delimiter The byte sequence to stop reading at
+ * @return Buffer holding the bytes read, delimiter included
+ * @throws IOException if read operation fails, on timeout or when
+ *         max_safe_read_size_ is exceeded
+ * @throws IOException if delimiter is empty or longer than the maximum read size
+ */
+PooledBuffer readUntilPooled(std::string_view delimiter);
+
+/**
+ * @brief Reads every complete line that has arrived, with one bulk read
+ *
+ * Returns all lines ended by the terminator set with setTerminator()
+ * that are held in the internal receive buffer. When it holds none, waits for data like readUntil() (see
+ * setReadTimeout()) and pulls everything the kernel has in one read, so
+ * a burst of lines costs one poll and one read instead of one per line.
+ * A partial trailing line stays buffered and is completed by later reads.
+ *
+ * The views point into the receive buffer and include the terminator.
+ * They stay valid until the next read call on this port.
+ *
+ * @return Views of the complete lines, in arrival order, never empty
+ * @throws IOException if read operation fails or on timeout
+ * @throws IOException if a line exceeds max_safe_read_size_ without a terminator
+ */
+const std::vector<std::string_view>& readLines();
+
+/**
+ * @brief Reads whatever data is available without blocking
+ *
+ * Returns bytes held in the internal receive buffer first; otherwise
+ * performs a single non-blocking read straight into caller memory.
+ * Intended for event loops that already know the descriptor is readable.
+ *
+ * @param buffer Pointer to the memory where data will be stored
+ * @param size Capacity of buffer in bytes
+ * @return Number of bytes read, 0 when nothing is available
+ * @throws IOException if read operation fails
+ * @throws IOException if buffer is null
+ */
+size_t readAvailable(void* buffer, size_t size);
+
+/**
+ * @brief Reads whatever data arrives first, in any canonical mode
+ *
+ * Returns bytes held in the internal receive buffer first. Otherwise
+ * waits for data like read() (see setReadTimeout()) and performs a
+ * single read straight into caller memory. Meant for binary protocols
+ * whose frame boundaries are found by a decoder rather than by a
+ * terminator.
+ *
+ * @param buffer Pointer to the memory where data will be stored
+ * @param size Capacity of buffer in bytes
+ * @return Number of bytes read
+ * @throws IOException if poll or read fails, or on timeout
+ * @throws IOException if buffer is null
+ */
+size_t readSome(void* buffer, size_t size);
+
+/**
+ * @brief Reads from the serial port straight into a ring buffer
+ *
+ * Meant to be called from the producer thread of the ring. Waits for
+ * data like read() (see setReadTimeout()), then fills the free space of
+ * the ring with a single readv() call, wrap-around included. Bytes left
+ * in the internal receive buffer by earlier reads are moved first.
+ *
+ * @param ring The ring to fill; this thread must be its producer
+ * @return Number of bytes stored, 0 when the ring is full
+ * @throws IOException if poll or read fails, or on timeout
+ */
+size_t readInto(SpscRing& ring);
+
+/**
+ * @brief Writes as much data as the port accepts without blocking
+ *
+ * Performs a single non-blocking write. Intended for event loops that
+ * keep their own queue of pending output and wait for POLLOUT.
+ *
+ * @param data Pointer to the bytes to write
+ * @param size Number of bytes to write
+ * @return Number of bytes accepted, 0 when the output queue is full
+ * @throws IOException if write operation fails
+ * @throws IOException if data pointer is null
+ */
+size_t writeAvailable(const void* data, size_t size);
+
+/**
+ * @brief Non-throwing variant of read(void*, size_t)
+ *
+ * Reports every outcome through the result instead of an exception, so
+ * a poll loop that mostly times out pays no exception cost and builds
+ * no message string. With a read timeout of zero an empty port gives
+ * IoStatus::WOULD_BLOCK instead of IoStatus::TIMEOUT.
+ *
+ * @param buffer Pointer to the memory where data will be stored
+ * @param size Capacity of buffer in bytes
+ * @return Bytes read, or why nothing was read
+ */
+IoResult tryRead(void* buffer, size_t size);
+
+/**
+ * @brief Non-throwing variant of readBytes(void*, size_t)
+ *
+ * Where readBytes() returns 0, this reports IoStatus::TIMEOUT when
+ * VTIME expired, or IoStatus::WOULD_BLOCK when VTIME is zero.
+ *
+ * @param buffer Pointer to the memory where data will be stored
+ * @param num_bytes Number of bytes to read; buffer must hold at least this many
+ * @return Bytes read, or why nothing was read
+ */
+IoResult tryReadBytes(void* buffer, size_t num_bytes);
+
+/**
+ * @brief Non-throwing variant of readUntil(void*, size_t, char)
+ *
+ * On failure getBytes() tells how many bytes were already stored in
+ * buffer; they are not given back to the receive buffer.
+ *
+ * @param buffer Pointer to the memory where data will be stored
+ * @param size Capacity of buffer in bytes
+ * @param terminator The character to stop reading at
+ * @return Bytes stored, terminator included, or why no terminator was found
+ */
+IoResult tryReadUntil(void* buffer, size_t size, char terminator);
+
+/**
+ * @brief Non-throwing variant of readUntil(void*, size_t, std::string_view)
+ *
+ * @param buffer Pointer to the memory where data will be stored
+ * @param size Capacity of buffer in bytes
+ * @param delimiter The byte sequence to stop reading at
+ * @return Bytes stored, delimiter included, or why no delimiter was found
+ */
+IoResult tryReadUntil(void* buffer, size_t size, std::string_view delimiter);
+
+/**
+ * @brief Non-throwing variant of write(const void*, size_t)
+ *
+ * On IoStatus::TIMEOUT getBytes() reports how many bytes were sent, like
+ * TimeoutException::bytesTransferred().
+ *
+ * @param data Pointer to the bytes to write
+ * @param size Number of bytes to write
+ * @return Bytes written, or why not all of them were
+ */
+IoResult tryWrite(const void* data, size_t size);
+
+/**
+ * @brief Switches the port between blocking and non-blocking mode
+ *
+ * The port is opened in blocking mode, where readBytes() waits
+ * according to VMIN/VTIME. A timed write switches a blocking descriptor
+ * to O_NONBLOCK for its own duration only; readAvailable() and
+ * writeAvailable() enable non-blocking mode for good. In non-blocking
+ * mode readBytes() waits in poll() for up to the read timeout instead.
+ * The current mode is cached so the fcntl() calls only happen when the
+ * mode actually changes.
+ *
+ * @param enable true for O_NONBLOCK, false for blocking mode
+ * @throws IOException if the file status flags cannot be changed
+ */
+void setNonBlocking(bool enable);
+
+/**
+ * @brief Reads until a terminator without blocking the thread
+ *
+ * Meant to be co_awaited from a C++20 coroutine running on a
+ * SerialExecutor, e.g. co_await serial.asyncReadUntil('\n'). The
+ * coroutine is suspended while the port has no data; bytes after the
+ * terminator stay buffered for the next read.
+ *
+ * @param terminator The character to stop reading at
+ * @return Awaitable yielding the data read, terminator included
+ */
+ReadUntilAwaitable asyncReadUntil(char terminator);
+
+/**
+ * @brief Reads an exact number of bytes without blocking the thread
+ *
+ * @param num_bytes Number of bytes to read
+ * @return Awaitable yielding exactly num_bytes bytes
+ */
+ReadBytesAwaitable asyncReadBytes(size_t num_bytes);
+
+/**
+ * @brief Writes data without blocking the thread
+ *
+ * The coroutine is suspended while the output queue is full.
+ *
+ * @param data Pointer to the bytes to write; must stay valid until resumed
+ * @param size Number of bytes to write
+ * @return Awaitable yielding the number of bytes written
+ * @throws IOException if data pointer is null
+ */
+WriteAwaitable asyncWrite(const void* data, size_t size);
+
+/**
+ * @brief Writes a string without blocking the thread
+ *
+ * @param data The string to write; must stay valid until resumed
+ * @return Awaitable yielding the number of bytes written
+ */
+WriteAwaitable asyncWrite(const std::string& data);
+
+/**
+ * @brief Registers the callback invoked with every chunk read in async mode
+ *
+ * Called from the reader thread with the bytes exactly as they were read.
+ *
+ * @param callback Callable invoked as callback(const char* data, size_t size)
+ * @throws SerialException if the reader thread is running
+ */
+void onData(std::function<void(const char*, size_t)> callback);
+
+/**
+ * @brief Registers the callback invoked with every complete line in async mode
+ *
+ * Lines are split on the Terminator configured when startAsyncRead() is
+ * called, reassembled across reads, and passed with the terminator
+ * included. A line longer than the maximum safe read size is discarded
+ * and reported through the error callback.
+ *
+ * @param callback Callable invoked as callback(const std::string& line)
+ * @throws SerialException if the reader thread is running
+ */
+void onLine(std::function<void(const std::string&)> callback);
+
+/**
+ * @brief Registers the callback invoked when async reading fails
+ *
+ * Poll or read failures and hang-ups end the reader thread after this
+ * callback returns; stopAsyncRead() still has to be called to join it.
+ *
+ * @param callback Callable invoked as callback(const SerialException& error)
+ * @throws SerialException if the reader thread is running
+ */
+void onError(std::function<void(const SerialException&)> callback);
+
+/**
+ * @brief Starts a background thread that reads and dispatches to the callbacks
+ *
+ * The thread blocks in poll() on the port and on an internal eventfd,
+ * so it costs nothing while the line is idle and delivers data as soon
+ * as it arrives. Bytes already held in the internal receive buffer are
+ * delivered first. While the thread runs, read(), readBytes(),
+ * readUntil() and readAvailable() must not be called; writes are fine.
+ *
+ * @throws SerialException if the port is not open, the thread is already
+ * running or the wakeup descriptor cannot be created
+ */
+void startAsyncRead();
+
+/**
+ * @brief Stops and joins the background reader thread
+ *
+ * Interrupts a blocked poll() immediately. Does nothing if the thread is
+ * not running. Called automatically by close() and the destructor.
+ *
+ * @throws SerialException if called from one of the callbacks
+ */
+void stopAsyncRead();
+
+/**
+ * @brief Checks whether the background reader thread has been started
+ *
+ * @return true between startAsyncRead() and stopAsyncRead()
+ */
+bool isAsyncReading() const;
+
 /**
  * @brief Flushes the input buffer
  *
- * Discards any data that has been received but not yet read.
+ * Discards any data that has been received but not yet read, including
+ * bytes held in the internal receive buffer.
  * Useful for clearing stale data before starting fresh communication.
  *
  * @throws SerialException if flush operation fails
@@ -182,7 +644,8 @@ void setBaudRate(unsigned int baud_rate);
  * @brief Gets the number of bytes available for reading
  *
  * Returns the number of bytes currently available in the input buffer
- * without actually reading them. Useful for non-blocking operations.
+ * without actually reading them, including bytes already held in the
+ * internal receive buffer. Useful for non-blocking operations.
  *
  * @return Number of bytes available for reading
  * @throws SerialException if operation fails
@@ -199,15 +662,55 @@ int getAvailableData() const;
  *
  * @note The system timeout is set in deciseconds (100ms units), so the value
  *       will be rounded down to the nearest multiple of 100ms. For example,
- *       1549ms will be set as 1500ms.
+ *       1549ms will be set as 1500ms. In low latency mode the system
+ *       timeout stays zero and only poll() uses the value.
  */
 void setReadTimeout(std::chrono::milliseconds timeout);
 
+/**
+ * @brief Trades CPU time for read latency
+ *
+ * Enabling does three things:
+ * - sets ASYNC_LOW_LATENCY on the driver (TIOCSSERIAL), so received
+ *   bytes are pushed to the line discipline at once; drivers without
+ *   TIOCGSERIAL support (USB CDC, pseudo-terminals) are left as they are
+ * - sets VMIN and VTIME to zero, so a read returns as soon as anything
+ *   is queued; the read timeout is then enforced with poll() alone
+ * - makes every read first busy-poll the port for spin_time before
+ *   blocking in poll(), which saves the wakeup latency when the reply
+ *   arrives within that window
+ *
+ * Disabling restores the flag and VMIN/VTIME. While the mode is on,
+ * setReadTimeout(), setTimeOut(), setMinNumberCharRead() and
+ * applyConfig() only update the values to restore, and the getters
+ * report them. The mode is reset by close().
+ *
+ * @param enable true to enable low latency mode
+ * @param spin_time How long reads busy-poll before blocking; zero to never spin
+ * @throws SerialException if the driver or termios settings cannot be changed
+ */
+void setLowLatencyMode(bool enable,
+                       std::chrono::microseconds spin_time = kDefaultSpinTime);
+
+/**
+ * @brief Checks whether low latency mode is enabled
+ *
+ * @return true after setLowLatencyMode(true)
+ */
+bool isLowLatencyMode() const;
+
+/**
+ * @brief Gets how long reads busy-poll before blocking
+ *
+ * @return The spin time, zero unless low latency mode is enabled
+ */
+std::chrono::microseconds getSpinTime() const;
+
 /**
  * @brief Sets the write timeout in milliseconds
  *
- * Configures the maximum time to wait for write operations before
- * timing out. A value of 0 means no timeout (blocking).
+ * Configures the maximum time a write may spend waiting for room in the
+ * output queue before timing out. A value of 0 means no timeout (blocking).
  *
  * @param timeout Timeout in milliseconds
  * @throws SerialException if setting cannot be applied
@@ -279,6 +782,8 @@ void setTerminator(Terminator term);
 /**
  * @brief Sets the read timeout in deciseconds
  *
+ * In low latency mode the value is kept for when the mode is disabled.
+ *
  * @param time Timeout in deciseconds
  * @throws SerialException if setting cannot be applied
  */
@@ -287,6 +792,8 @@ void setTimeOut(uint16_t time);
 /**
  * @brief Sets the minimum number of characters to read
  *
+ * In low latency mode the value is kept for when the mode is disabled.
+ *
  * @param num Minimum number of characters to read
  * @throws SerialException if setting cannot be applied
  */
@@ -305,6 +812,18 @@ void setMinNumberCharRead(uint16_t);
  */
 void setBaudRate(BaudRate baud_rate);
 
+/**
+ * @brief Applies a whole configuration as one transaction
+ *
+ * Every setting present in config is staged on a single termios2 copy
+ * and written with one TCSETS2 ioctl, so the line goes straight from the
+ * old to the new state. Settings absent from config are left untouched.
+ *
+ * @param config The configuration to apply
+ * @throws SerialException if the configuration cannot be applied
+ */
+void applyConfig(const SerialConfig& config);
+
 /**
  * @brief Sets the maximum safe read size
  *
@@ -325,11 +844,99 @@ void setMaxSafeReadSize(size_t size);
  */
 size_t getMaxSafeReadSize() const;
 
+/**
+ * @brief Gets the runtime statistics of the port
+ *
+ * Counts bytes, system calls, EAGAIN retries, timeouts and exceptions,
+ * and the latency of the read and write calls. Safe to call from any
+ * thread while the port is in use. All counts are zero when the
+ * library is built without BUILD_STATS.
+ *
+ * @return Snapshot of the statistics
+ */
+SerialStats getStats() const;
+
+/**
+ * @brief Sets all runtime statistics back to zero
+ */
+void resetStats();
+
+/**
+ * @brief Tees the traffic of the port into a capture file
+ *
+ * Every successful read and write system call is recorded as one chunk
+ * with its direction and a monotonic timestamp, including the reads of
+ * the background reader thread and of SerialReactor. Recording only
+ * copies the bytes into the writer's pending batch, see CaptureWriter.
+ * One writer may be shared by several ports.
+ *
+ * @param writer Capture to record into, nullptr to stop capturing
+ * @throws SerialException if the reader thread is running
+ */
+void setCapture(std::shared_ptr<CaptureWriter> writer);
+
+/**
+ * @brief Gets the capture the traffic is recorded into
+ *
+ * @return The writer passed to setCapture(), nullptr when not capturing
+ */
+const std::shared_ptr<CaptureWriter>& getCapture() const;
+
+/**
+ * @brief Publishes the traffic of the port to a tap's observers
+ *
+ * Every successful read and write system call is published as one
+ * chunk, like setCapture() records it. The observers run on the tap's
+ * drain thread; the I/O path only copies the chunk into the tap's
+ * bounded queue, so a slow observer drops chunks instead of delaying
+ * read(), readUntil() or write(). One tap may be shared by several ports.
+ *
+ * @param tap Tap to publish to, nullptr to stop publishing
+ * @throws SerialException if the reader thread is running
+ */
+void setTap(std::shared_ptr<TrafficTap> tap);
+
+/**
+ * @brief Gets the tap the traffic is published to
+ *
+ * @return The tap passed to setTap(), nullptr when not tapped
+ */
+const std::shared_ptr<TrafficTap>& getTap() const;
+
+/**
+ * @brief Refreshes the cached configuration from the port
+ *
+ * The getters answer from a cache of the last applied configuration.
+ * Call this when the settings may have been changed outside of this
+ * object, e.g. by another process or file descriptor.
+ *
+ * @throws SerialException if the configuration cannot be read
+ */
+void refreshConfig();
+
+/**
+ * @brief Gets the terminator character used for line-oriented reads
+ *
+ * @return The current terminator
+ */
+Terminator getTerminator() const;
+
+/**
+ * @brief Gets the file descriptor of the open port
+ *
+ * Allows registering the port with an external event loop such as
+ * SerialReactor. The descriptor stays owned by this object.
+ *
+ * @return The file descriptor, or -1 when no port is open
+ */
+int getFileDescriptor() const;
+
 /**
  * @brief Gets the current baud rate
  *
+ * Served from the cached configuration, no system call is made.
+ *
  * @return The current baud rate
- * @throws SerialException if unable to retrieve baud rate
  */
 int getBaudRate() const;
 
@@ -337,6 +944,7 @@ int getBaudRate() const;
  * @brief Gets the current data length setting
  *
  * Retrieves the number of data bits configured for serial communication.
+ * Served from the cached configuration, no system call is made.
  *
  * @return The current data length (number of data bits)
  */
@@ -345,6 +953,9 @@ DataLength getDataLength() const;
 /**
  * @brief Gets the current read timeout setting
  *
+ * Served from the cached configuration (VTIME), no system call is made.
+ * In low latency mode this is the VTIME restored when the mode is disabled.
+ *
  * @return The current read timeout in milliseconds
  */
 std::chrono::milliseconds getReadTimeout() const;
@@ -352,6 +963,9 @@ std::chrono::milliseconds getReadTimeout() const;
 /**
  * @brief Gets the current minimum number of characters to read setting
  *
+ * Served from the cached configuration (VMIN), no system call is made.
+ * In low latency mode this is the VMIN restored when the mode is disabled.
+ *
  * @return The current minimum number of characters to read
  */
 uint16_t getMinNumberCharRead() const;
@@ -364,93 +978,406 @@ uint16_t getMinNumberCharRead() const;
 void setFdForTest(int fd) {
   fd_serial_port_ = fd;
 }
-// WARNING: Test helper only! This function allows injection of custom
-// system call functions for testing error handling. It should NEVER be
-// used in production code.
+// WARNING: Test helper only! These functions replace the system calls
+// of this object to test error handling. They should NEVER be used in
+// production code, where the calls are bound at compile time.
 void setPollSystemFunction(
   std::function<int(struct pollfd*, nfds_t, int)> poll_func) {
-  poll_ = [poll_func](struct pollfd* f, nfds_t n, int t) {
-            return poll_func(f, n, t);
-          };
+  this->systemCallOverrides().poll = std::move(poll_func);
 }
 
 void setReadSystemFunction(
   std::function<ssize_t(int, void*, size_t)> read_func) {
-  read_ = [read_func](int fd, void* buf, size_t sz) {
-            return read_func(fd, buf, sz);
-          };
+  this->systemCallOverrides().read = std::move(read_func);
 }
 
 /* *INDENT-OFF* */
 void setIoctlSystemFunction(
   std::function<int(int, unsigned long, void*)> ioctl_func) {  // NOLINT
-  ioctl_ = [ioctl_func](int fd, unsigned long request, void* arg) { // NOLINT
-             return ioctl_func(fd, request, arg);
-           };
+  this->systemCallOverrides().ioctl = std::move(ioctl_func);
 }
 /* *INDENT-ON* */
 #endif
 
 private:
+friend class ReadUntilAwaitable;
+friend class SerialReactor;
+
+/**
+ * @brief System calls injected by tests; null in production
+ */
+std::unique_ptr<SystemCallOverrides> overrides_;
+
 /**
- * @brief Ioctl system call function wrapper
+ * @brief Returns the system call overrides, creating them on first use
+ */
+SystemCallOverrides& systemCallOverrides() {
+  if (!overrides_) {
+    overrides_ = std::make_unique<SystemCallOverrides>();
+  }
+  return *overrides_;
+}
+
+/**
+ * @brief Reads from the port descriptor
  *
- * Allows injection of custom ioctl function for testing.
+ * Bound to PosixSystemCalls at compile time, so production objects make
+ * the plain system call; tests can override it with setReadSystemFunction().
+ * Every call is counted in the statistics.
  */
-/* *INDENT-OFF* */
-std::function<int(int, unsigned long, void*)> ioctl_ = // NOLINT
-  [](int fd, unsigned long request, void* arg) {  // NOLINT
-    return ::ioctl(fd, request, arg);
-  };
-/* *INDENT-ON* */
+ssize_t callRead(void* buffer, size_t size) {
+  stats_.add(StatsCounter::READ_CALLS);
+  ssize_t result;
+  if (overrides_ && overrides_->read) {
+    result = overrides_->read(fd_serial_port_, buffer, size);
+  }
+  else {
+    result = PosixSystemCalls::read(fd_serial_port_, buffer, size);
+  }
+  if (result > 0 && (capture_ || tap_)) {
+    this->teeTraffic(CaptureDirection::RX, buffer, static_cast<size_t>(result));
+  }
+  return result;
+}
+
+/**
+ * @brief Scatter read from the port descriptor
+ */
+ssize_t callReadv(const struct iovec* segments, int count) {
+  stats_.add(StatsCounter::READ_CALLS);
+  ssize_t result = PosixSystemCalls::readv(fd_serial_port_, segments, count);
+  if (result > 0 && (capture_ || tap_)) {
+    this->teeTraffic(CaptureDirection::RX, segments, count, static_cast<size_t>(result));
+  }
+  return result;
+}
+
+/**
+ * @brief Writes to the port descriptor
+ */
+ssize_t callWrite(const void* data, size_t size) {
+  stats_.add(StatsCounter::WRITE_CALLS);
+  ssize_t result = PosixSystemCalls::write(fd_serial_port_, data, size);
+  if (result > 0 && (capture_ || tap_)) {
+    this->teeTraffic(CaptureDirection::TX, data, static_cast<size_t>(result));
+  }
+  return result;
+}
 
 /**
- * @brief Poll system call function wrapper
+ * @brief Gather write to the port descriptor
+ */
+ssize_t callWritev(const struct iovec* segments, int count) {
+  stats_.add(StatsCounter::WRITE_CALLS);
+  ssize_t result = PosixSystemCalls::writev(fd_serial_port_, segments, count);
+  if (result > 0 && (capture_ || tap_)) {
+    this->teeTraffic(CaptureDirection::TX, segments, count, static_cast<size_t>(result));
+  }
+  return result;
+}
+
+/**
+ * @brief Accounts I/O submitted on the port descriptor outside Serial
+ *
+ * Used by SerialReactor for io_uring completions, which never pass
+ * through the call helpers: counts the call and its bytes and hands the
+ * chunk to the capture and the tap.
  *
- * Allows injection of custom poll function for testing.
+ * @param direction CaptureDirection::RX for a read, TX for a write
+ * @param data Pointer to the bytes moved
+ * @param size Number of bytes moved, greater than zero
  */
-std::function<int(struct pollfd*, nfds_t, int)> poll_ =
-  [](struct pollfd* f, nfds_t n, int t) {
-    return ::poll(f, n, t);
-  };
+void recordExternalIo(CaptureDirection direction, const void* data, size_t size) {
+  if (direction == CaptureDirection::RX) {
+    stats_.add(StatsCounter::READ_CALLS);
+    stats_.add(StatsCounter::BYTES_READ, size);
+  }
+  else {
+    stats_.add(StatsCounter::WRITE_CALLS);
+    stats_.add(StatsCounter::BYTES_WRITTEN, size);
+  }
+  if (capture_ || tap_) {
+    this->teeTraffic(direction, data, size);
+  }
+}
+
+/**
+ * @brief Hands a chunk moved by a system call to the capture and the tap
+ */
+void teeTraffic(CaptureDirection direction, const void* data, size_t size) {
+  if (capture_) {
+    capture_->record(direction, data, size);
+  }
+  if (tap_) {
+    tap_->publish(direction, data, size);
+  }
+}
+
+void teeTraffic(CaptureDirection direction, const struct iovec* segments, int count,
+                size_t size) {
+  if (capture_) {
+    capture_->record(direction, segments, count, size);
+  }
+  if (tap_) {
+    tap_->publish(direction, segments, count, size);
+  }
+}
 
 /**
- * @brief Read system call function wrapper
+ * @brief Polls descriptors, the port among them
  *
- * Allows injection of custom read function for testing.
+ * Tests can override it with setPollSystemFunction().
  */
-std::function<ssize_t(int, void*, size_t)> read_ =
-  [](int fd, void* buf, size_t sz) {
-    return ::read(fd, buf, sz);
-  };
+int callPoll(struct pollfd* fds, nfds_t count, int timeout_ms) {
+  stats_.add(StatsCounter::POLL_CALLS);
+  if (overrides_ && overrides_->poll) {
+    return overrides_->poll(fds, count, timeout_ms);
+  }
+  return PosixSystemCalls::poll(fds, count, timeout_ms);
+}
+
+/**
+ * @brief Issues an ioctl request on the port descriptor
+ *
+ * Tests can override it with setIoctlSystemFunction().
+ */
+int callIoctl(unsigned long request, void* arg) const {  // NOLINT
+  stats_.add(StatsCounter::IOCTL_CALLS);
+  if (overrides_ && overrides_->ioctl) {
+    return overrides_->ioctl(fd_serial_port_, request, arg);
+  }
+  return PosixSystemCalls::ioctl(fd_serial_port_, request, arg);
+}
+
+/**
+ * @brief Changes or reads the file status flags of the port descriptor
+ *
+ * Counted with the ioctl calls in the statistics.
+ */
+int callFcntl(int command, int arg) {
+  stats_.add(StatsCounter::IOCTL_CALLS);
+  return PosixSystemCalls::fcntl(fd_serial_port_, command, arg);
+}
 
 /**
  * @brief Applies terminal settings to the port
  *
- * Internal method to write the termios2 configuration
- * to the serial port file descriptor.
+ * Internal method to write a staged termios2 configuration to the
+ * serial port file descriptor. The cache in options_ is only updated
+ * once the kernel has accepted the new settings.
  *
+ * @param options The configuration to apply
  * @throws SerialException if ioctl operation fails
  */
-void setTermios2();
+void setTermios2(struct termios2 options);
 
 /**
  * @brief Retrieves current terminal settings
  *
  * Internal method to read the current termios2 configuration
- * from the serial port file descriptor.
+ * from the serial port file descriptor into options_.
  *
  * @throws SerialException if ioctl operation fails
  */
-void getTermios2() const;
+void getTermios2();
+
+/**
+ * @brief Busy-polls the port for up to spin_time_
+ *
+ * @param fd_poll Descriptor and events to poll for
+ * @return The last poll() result: positive once ready, 0 when the spin
+ *         time ran out or spinning is off, negative on error
+ */
+int spinForInput(struct pollfd* fd_poll);
+
+/**
+ * @brief Sets or clears ASYNC_LOW_LATENCY on the driver, where supported
+ *
+ * @param enable true to set the flag
+ * @throws SerialException if a supported driver rejects the change
+ */
+void setKernelLowLatency(bool enable);
+
+/**
+ * @brief Waits until the port is readable, bounded by the read timeout
+ *
+ * @return OK once readable; TIMEOUT, WOULD_BLOCK (zero timeout) or SYSTEM_ERROR
+ */
+IoResult pollInput();
+
+/**
+ * @brief Waits until the port is readable, bounded by the read timeout
+ *
+ * @throws IOException if poll fails or on timeout
+ */
+void waitForInput();
+
+/**
+ * @brief Throws the exception read() reports for a failed result
+ *
+ * @param result Result of pollInput() or fillForRead()
+ * @throws IOException if result is not OK
+ */
+void checkRead(const IoResult& result) const;
+
+/**
+ * @brief Waits for data and refills the receive buffer for read()
+ *
+ * Does nothing when the receive buffer already holds data.
+ *
+ * @return OK, or the failure of poll or read
+ */
+IoResult fillForRead();
+
+/**
+ * @brief Refills the receive buffer for readBytes()
+ *
+ * Does nothing when the receive buffer already holds data. On the
+ * default blocking descriptor the read waits according to VMIN/VTIME.
+ * On a non-blocking descriptor, and in low latency mode, a read that
+ * finds nothing queued waits in poll() for up to the read timeout.
+ *
+ * @return OK once data is buffered; TIMEOUT or WOULD_BLOCK when none
+ *         arrived in time, or the failure of poll or read
+ */
+IoResult fillForReadBytes();
+
+/**
+ * @brief Waits for data and pulls it into the receive buffer, for readUntil() and readLines()
+ *
+ * Honors the read timeout counted from start_time; with no timeout the
+ * read blocks. A read that finds no data yet returns OK.
+ *
+ * @param start_time When the calling read operation started
+ * @return OK, or the failure of poll or read, the timeout or end of file
+ */
+IoResult pullUntilData(std::chrono::steady_clock::time_point start_time);
+
+/**
+ * @brief Validates the delimiter passed to readUntil()
+ *
+ * @param delimiter The byte sequence to stop reading at
+ * @throws IOException if delimiter is empty or longer than the maximum read size
+ */
+void checkDelimiter(std::string_view delimiter) const;
+
+/**
+ * @brief Throws the exception readUntil() reports for a failed result
+ *
+ * @param result Result of readUntilImpl()
+ * @param limit The limit passed to readUntilImpl()
+ * @return Number of bytes delivered
+ * @throws IOException if result is not OK
+ */
+size_t checkReadUntil(const IoResult& result, size_t limit) const;
+
+/**
+ * @brief Core loop shared by the readUntil() overloads
+ *
+ * Hands every chunk of data up to and including the delimiter to
+ * append, pulling from the port in bulk as needed. Without a match the
+ * last delimiter.size() - 1 bytes stay buffered, since they may start a
+ * delimiter completed by the next read.
+ *
+ * @param delimiter The byte sequence to stop reading at, not empty
+ * @param limit Maximum number of bytes to deliver, delimiter included
+ * @param append Callable invoked as append(const char* data, size_t size)
+ * @return Number of bytes delivered, or the failure with the bytes delivered so far
+ */
+template <typename Append>
+IoResult readUntilImpl(std::string_view delimiter, size_t limit, Append append);
+
+/**
+ * @brief Core of writev() and tryWrite()
+ *
+ * Switches a blocking descriptor to O_NONBLOCK around a timed write.
+ *
+ * @param segments Array of segments to write, in order
+ * @param count Number of entries in segments
+ * @param size Sum of all segment lengths
+ * @return Number of bytes written, or the failure with the bytes written so far
+ */
+IoResult writevImpl(const struct iovec* segments, size_t count, size_t size);
+
+/**
+ * @brief Writes every segment, waiting on POLLOUT whenever the output queue is full
+ *
+ * @param segments Array of segments to write, in order
+ * @param count Number of entries in segments
+ * @param size Sum of all segment lengths
+ * @return Number of bytes written, or the failure with the bytes written so far
+ */
+IoResult writevLoop(const struct iovec* segments, size_t count, size_t size);
+
+/**
+ * @brief Non-throwing core of setNonBlocking()
+ *
+ * @param enable true for O_NONBLOCK, false for blocking mode
+ * @return OK, or the failure of fcntl
+ */
+IoResult applyNonBlocking(bool enable);
+
+/**
+ * @brief Body of the background reader thread
+ *
+ * @param terminator The line terminator captured by startAsyncRead()
+ */
+void asyncReadLoop(char terminator);
+
+/**
+ * @brief Runs the async callbacks on freshly read bytes
+ *
+ * @param data Pointer to the bytes read
+ * @param size Number of bytes read
+ * @param terminator The line terminator
+ * @param line Partial line carried across reads
+ */
+void dispatchAsyncData(const char* data, size_t size, char terminator, std::string& line);
+
+/**
+ * @brief Moves up to size bytes out of the receive buffer
+ *
+ * @param buffer Destination memory
+ * @param size Maximum number of bytes to move
+ * @return Number of bytes moved
+ */
+size_t takeRx(char* buffer, size_t size);
+
+/**
+ * @brief Refills the internal receive buffer from the port
+ *
+ * Compacts the receive buffer and issues a single read() for as many
+ * bytes as fit in the remaining space.
+ *
+ * @return The value returned by the read system call; errno is preserved
+ */
+ssize_t fillRxBuffer();
+
+/**
+ * @brief Number of bytes held in the internal receive buffer
+ *
+ * @return Bytes received from the port but not yet handed to the caller
+ */
+size_t rxAvailable() const {
+  return rx_end_ - rx_begin_;
+}
+
+/**
+ * @brief Discards every byte held in the internal receive buffer
+ */
+void clearRxBuffer() {
+  rx_begin_ = 0;
+  rx_end_ = 0;
+}
 
 /**
  * @brief Terminal configuration structure
  *
- * Holds the current serial port configuration including
- * baud rate, data bits, parity, stop bits, and other settings.
+ * Authoritative cache of the configuration applied to the port,
+ * including baud rate, data bits, parity, stop bits, and other
+ * settings. Getters read it without issuing any system call.
  */
-mutable struct termios2 options_;
+struct termios2 options_{};
 
 /**
  * @brief File descriptor for the serial port
@@ -460,6 +1387,19 @@ mutable struct termios2 options_;
  */
 int fd_serial_port_{-1};
 
+/**
+ * @brief Whether the descriptor is currently in O_NONBLOCK mode
+ */
+bool non_blocking_{false};
+
+/**
+ * @brief File status flags last set on the descriptor
+ *
+ * Only open() and applyNonBlocking() change them, so switching the mode
+ * takes a single F_SETFL without reading the flags back.
+ */
+int status_flags_{0};
+
 /**
  * @brief Read timeout in milliseconds
  *
@@ -468,6 +1408,17 @@ int fd_serial_port_{-1};
  */
 std::chrono::milliseconds read_timeout_ms_{1000};    ///< Read timeout in milliseconds (default 1000ms)
 
+/**
+ * @brief Low latency mode state, see setLowLatencyMode()
+ *
+ * The VMIN/VTIME values in place before the mode was enabled are kept
+ * to be restored when it is disabled.
+ */
+bool low_latency_{false};
+std::chrono::microseconds spin_time_{0};
+cc_t saved_vmin_{0};
+cc_t saved_vtime_{0};
+
 /**
  * @brief Write timeout in milliseconds
  *
@@ -505,6 +1456,88 @@ CanonicalMode canonical_mode_{CanonicalMode::ENABLE};
  * Specifies the character used to terminate lines (default LF).
  */
 Terminator terminator_{Terminator::LF};
+
+/**
+ * @brief Default busy-poll window of low latency mode
+ */
+static constexpr std::chrono::microseconds kDefaultSpinTime{50};
+
+/**
+ * @brief Maximum number of segments handed to a single writev() call
+ *
+ * Longer segment lists are sent in windows of this size.
+ */
+static constexpr size_t kMaxWriteSegments{64};
+
+/**
+ * @brief Default capacity of the internal receive buffer
+ *
+ * The buffer grows to max_safe_read_size_ when that is larger.
+ */
+static constexpr size_t kRxBufferSize{4096};
+
+/**
+ * @brief Internal receive buffer
+ *
+ * Holds bytes read from the port in bulk until they are consumed by
+ * read(), readBytes() or readUntil().
+ */
+std::vector<char> rx_buffer_;
+
+/**
+ * @brief Offset of the first unread byte in rx_buffer_
+ */
+size_t rx_begin_{0};
+
+/**
+ * @brief Offset one past the last unread byte in rx_buffer_
+ */
+size_t rx_end_{0};
+
+/**
+ * @brief Lines returned by the last readLines() call, reused across calls
+ */
+std::vector<std::string_view> lines_;
+
+/**
+ * @brief Runtime statistics, updated by const methods too
+ */
+mutable StatsRecorder stats_;
+
+/**
+ * @brief Capture the traffic is teed into, see setCapture()
+ */
+std::shared_ptr<CaptureWriter> capture_;
+
+/**
+ * @brief Tap the traffic is published to, see setTap()
+ */
+std::shared_ptr<TrafficTap> tap_;
+
+/**
+ * @brief Async mode data callback
+ */
+std::function<void(const char*, size_t)> on_data_;
+
+/**
+ * @brief Async mode line callback
+ */
+std::function<void(const std::string&)> on_line_;
+
+/**
+ * @brief Async mode error callback
+ */
+std::function<void(const SerialException&)> on_error_;
+
+/**
+ * @brief The background reader thread
+ */
+std::thread reader_thread_;
+
+/**
+ * @brief Eventfd used by stopAsyncRead() to interrupt the reader's poll()
+ */
+int reader_stop_fd_{-1};
 };
 
 }  // namespace libserial
@@ -0,0 +1,229 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_SERIAL_AWAITABLE_HPP_
+#define INCLUDE_LIBSERIAL_SERIAL_AWAITABLE_HPP_
+
+#include <cstddef>
+#include <exception>
+#include <string>
+
+namespace libserial {
+
+class Serial;
+class SerialExecutor;
+
+/**
+ * @brief Common machinery of the Serial coroutine awaitables
+ *
+ * An awaitable first tries to complete without blocking. If it cannot,
+ * it parks the awaiting coroutine on the SerialExecutor running the
+ * current thread until the port is ready, makes as much progress as it
+ * can, and only resumes the coroutine once the operation is complete or
+ * has failed. Errors are rethrown from co_await.
+ *
+ * await_suspend() is a template over the coroutine handle type, so this
+ * header compiles as C++17; the awaitables can only be co_awaited from
+ * C++20 code.
+ *
+ * @author Nestor Pereira Neto
+ */
+class SerialAwaitable {
+public:
+SerialAwaitable(const SerialAwaitable&) = delete;
+SerialAwaitable& operator=(const SerialAwaitable&) = delete;
+
+/**
+ * @brief Attempts to complete the operation without suspending
+ *
+ * @return true if the operation completed or failed immediately
+ */
+bool await_ready() {
+  return this->tryComplete();
+}
+
+/**
+ * @brief Parks the awaiting coroutine on the current SerialExecutor
+ *
+ * @param handle The awaiting coroutine
+ * @throws SerialException if no SerialExecutor runs on this thread
+ */
+template <typename Handle>
+void await_suspend(Handle handle) {
+  this->suspend(handle.address(), [](void* address) {
+      Handle::from_address(address).resume();
+    });
+}
+
+protected:
+/**
+ * @brief Constructor of the SerialAwaitable class
+ *
+ * @param serial The port the operation runs on
+ * @param write true if the operation waits for writability
+ */
+SerialAwaitable(Serial& serial, bool write);
+
+/**
+ * @brief Destructor of the SerialAwaitable class
+ */
+~SerialAwaitable() = default;
+
+/**
+ * @brief Makes as much progress as possible without blocking
+ *
+ * @return true when the operation is complete
+ * @throws SerialException on failure
+ */
+virtual bool step() = 0;
+
+/**
+ * @brief Rethrows the error captured while completing the operation
+ */
+void rethrowIfFailed() const;
+
+/**
+ * @brief The port the operation runs on
+ */
+Serial& serial_;
+
+private:
+/**
+ * @brief Runs step(), capturing any error
+ *
+ * @return true if the operation completed or failed
+ */
+bool tryComplete();
+
+/**
+ * @brief Registers with the executor until the operation completes
+ *
+ * @param handle Address of the awaiting coroutine
+ * @param resume Resumes the coroutine at handle
+ */
+void suspend(void* handle, void (*resume)(void*));
+
+/**
+ * @brief Executor continuation: makes progress, then resumes or waits again
+ *
+ * @param self The awaitable
+ * @param hung_up Whether the port reported POLLHUP or POLLERR
+ */
+static void onReady(void* self, bool hung_up);
+
+/**
+ * @brief Executor the coroutine is parked on
+ */
+SerialExecutor* executor_{nullptr};
+
+/**
+ * @brief Address of the awaiting coroutine
+ */
+void* handle_{nullptr};
+
+/**
+ * @brief Resumes the awaiting coroutine
+ */
+void (*resume_)(void*){nullptr};
+
+/**
+ * @brief Error captured while completing the operation
+ */
+std::exception_ptr error_;
+
+/**
+ * @brief Whether the operation waits for writability
+ */
+bool write_{false};
+};
+
+/**
+ * @brief Awaitable returned by Serial::asyncReadUntil()
+ */
+class ReadUntilAwaitable : public SerialAwaitable {
+public:
+/**
+ * @brief Constructor of the ReadUntilAwaitable class
+ *
+ * @param serial The port to read from
+ * @param terminator The character that ends the read
+ */
+ReadUntilAwaitable(Serial& serial, char terminator);
+
+/**
+ * @brief Gets the result of co_await
+ *
+ * @return The data read, terminator included
+ * @throws IOException if the read failed or the line was too long
+ */
+std::string await_resume();
+
+protected:
+bool step() override;
+
+private:
+std::string data_;
+char terminator_;
+};
+
+/**
+ * @brief Awaitable returned by Serial::asyncReadBytes()
+ */
+class ReadBytesAwaitable : public SerialAwaitable {
+public:
+/**
+ * @brief Constructor of the ReadBytesAwaitable class
+ *
+ * @param serial The port to read from
+ * @param num_bytes Number of bytes to read
+ */
+ReadBytesAwaitable(Serial& serial, size_t num_bytes);
+
+/**
+ * @brief Gets the result of co_await
+ *
+ * @return Exactly num_bytes bytes
+ * @throws IOException if the read failed
+ */
+std::string await_resume();
+
+protected:
+bool step() override;
+
+private:
+std::string data_;
+size_t num_bytes_;
+};
+
+/**
+ * @brief Awaitable returned by Serial::asyncWrite()
+ */
+class WriteAwaitable : public SerialAwaitable {
+public:
+/**
+ * @brief Constructor of the WriteAwaitable class
+ *
+ * @param serial The port to write to
+ * @param data Pointer to the bytes to write; must stay valid until resumed
+ * @param size Number of bytes to write
+ */
+WriteAwaitable(Serial& serial, const void* data, size_t size);
+
+/**
+ * @brief Gets the result of co_await
+ *
+ * @return Number of bytes written, always size
+ * @throws IOException if the write failed
+ */
+size_t await_resume();
+
+protected:
+bool step() override;
+
+private:
+const char* data_;
+size_t size_;
+size_t written_{0};
+};
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_SERIAL_AWAITABLE_HPP_
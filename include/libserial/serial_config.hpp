@@ -0,0 +1,205 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_SERIAL_CONFIG_HPP_
+#define INCLUDE_LIBSERIAL_SERIAL_CONFIG_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#include "libserial/serial_types.hpp"
+
+namespace libserial {
+
+/**
+ * @brief A value type describing a serial port configuration
+ *
+ * The SerialConfig class collects the line settings of a port so they can
+ * be built offline and applied in one transaction with
+ * Serial::applyConfig() or Serial::open(). Only the settings that were
+ * explicitly set are changed on the port; everything else keeps its
+ * current value.
+ *
+ * @author Nestor Pereira Neto
+ */
+class SerialConfig {
+public:
+/**
+ * @brief Default constructor of the SerialConfig class
+ *
+ * Creates an empty configuration that leaves every setting untouched.
+ */
+SerialConfig() = default;
+
+/**
+ * @brief Default destructor of the SerialConfig class
+ *
+ */
+~SerialConfig() = default;
+
+/**
+ * @brief Sets the baud rate
+ *
+ * @param baud_rate The desired baud rate (e.g., 9600, 115200)
+ */
+void setBaudRate(unsigned int baud_rate);
+
+/**
+ * @brief Sets the baud rate using BaudRate enum
+ *
+ * @param baud_rate The baud rate from BaudRate enum
+ */
+void setBaudRate(BaudRate baud_rate);
+
+/**
+ * @brief Sets the number of data bits per byte
+ *
+ * @param nbits The desired number of data bits
+ */
+void setDataLength(DataLength nbits);
+
+/**
+ * @brief Sets the parity configuration
+ *
+ * @param parity The desired parity setting
+ */
+void setParity(Parity parity);
+
+/**
+ * @brief Sets the stop bits configuration
+ *
+ * @param stop_bits The desired stop bits setting
+ */
+void setStopBits(StopBits stop_bits);
+
+/**
+ * @brief Sets canonical mode for input processing
+ *
+ * @param mode The desired canonical mode setting
+ */
+void setCanonicalMode(CanonicalMode mode);
+
+/**
+ * @brief Sets the read timeout
+ *
+ * Applied like Serial::setReadTimeout(): it bounds poll() waits and sets
+ * VTIME in deciseconds.
+ *
+ * @param timeout Timeout in milliseconds
+ */
+void setReadTimeout(std::chrono::milliseconds timeout);
+
+/**
+ * @brief Sets the write timeout
+ *
+ * @param timeout Timeout in milliseconds
+ */
+void setWriteTimeout(std::chrono::milliseconds timeout);
+
+/**
+ * @brief Sets the minimum number of characters to read (VMIN)
+ *
+ * @param num Minimum number of characters to read
+ */
+void setMinNumberCharRead(uint16_t num);
+
+/**
+ * @brief Retrieves the baud rate, if set
+ *
+ * @return std::optional<unsigned int> The baud rate or std::nullopt
+ */
+std::optional<unsigned int> getBaudRate() const;
+
+/**
+ * @brief Retrieves the data length, if set
+ *
+ * @return std::optional<DataLength> The data length or std::nullopt
+ */
+std::optional<DataLength> getDataLength() const;
+
+/**
+ * @brief Retrieves the parity, if set
+ *
+ * @return std::optional<Parity> The parity or std::nullopt
+ */
+std::optional<Parity> getParity() const;
+
+/**
+ * @brief Retrieves the stop bits, if set
+ *
+ * @return std::optional<StopBits> The stop bits or std::nullopt
+ */
+std::optional<StopBits> getStopBits() const;
+
+/**
+ * @brief Retrieves the canonical mode, if set
+ *
+ * @return std::optional<CanonicalMode> The canonical mode or std::nullopt
+ */
+std::optional<CanonicalMode> getCanonicalMode() const;
+
+/**
+ * @brief Retrieves the read timeout, if set
+ *
+ * @return std::optional<std::chrono::milliseconds> The read timeout or std::nullopt
+ */
+std::optional<std::chrono::milliseconds> getReadTimeout() const;
+
+/**
+ * @brief Retrieves the write timeout, if set
+ *
+ * @return std::optional<std::chrono::milliseconds> The write timeout or std::nullopt
+ */
+std::optional<std::chrono::milliseconds> getWriteTimeout() const;
+
+/**
+ * @brief Retrieves the minimum number of characters to read, if set
+ *
+ * @return std::optional<uint16_t> The VMIN value or std::nullopt
+ */
+std::optional<uint16_t> getMinNumberCharRead() const;
+
+private:
+/**
+ * @brief Baud rate in bits per second
+ */
+std::optional<unsigned int> baud_rate_;
+
+/**
+ * @brief Number of data bits per byte
+ */
+std::optional<DataLength> data_length_;
+
+/**
+ * @brief Parity setting
+ */
+std::optional<Parity> parity_;
+
+/**
+ * @brief Stop bits setting
+ */
+std::optional<StopBits> stop_bits_;
+
+/**
+ * @brief Canonical mode setting
+ */
+std::optional<CanonicalMode> canonical_mode_;
+
+/**
+ * @brief Read timeout in milliseconds
+ */
+std::optional<std::chrono::milliseconds> read_timeout_;
+
+/**
+ * @brief Write timeout in milliseconds
+ */
+std::optional<std::chrono::milliseconds> write_timeout_;
+
+/**
+ * @brief Minimum number of characters to read
+ */
+std::optional<uint16_t> min_number_char_read_;
+};
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_SERIAL_CONFIG_HPP_
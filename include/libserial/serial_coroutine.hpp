@@ -0,0 +1,243 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_SERIAL_COROUTINE_HPP_
+#define INCLUDE_LIBSERIAL_SERIAL_COROUTINE_HPP_
+
+#if !defined(__cpp_impl_coroutine)
+#error "libserial/serial_coroutine.hpp requires C++20 coroutine support"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include "libserial/serial.hpp"
+#include "libserial/serial_executor.hpp"
+
+namespace libserial {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/**
+ * @brief Promise state shared by Task<T> and Task<void>
+ */
+class TaskPromiseBase {
+public:
+std::suspend_always initial_suspend() noexcept {
+  return {};
+}
+
+/**
+ * @brief Resumes the awaiting coroutine by symmetric transfer
+ */
+struct FinalAwaiter {
+  bool await_ready() noexcept {
+    return false;
+  }
+
+  template <typename Promise>
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+    std::coroutine_handle<> continuation = handle.promise().continuation_;
+    return continuation ? continuation : std::noop_coroutine();
+  }
+
+  void await_resume() noexcept {
+  }
+};
+
+FinalAwaiter final_suspend() noexcept {
+  return {};
+}
+
+void unhandled_exception() noexcept {
+  error_ = std::current_exception();
+}
+
+std::coroutine_handle<> continuation_;
+std::exception_ptr error_;
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+public:
+Task<T> get_return_object() noexcept;
+
+template <typename U>
+void return_value(U&& value) {
+  value_.emplace(std::forward<U>(value));
+}
+
+T result() {
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  return std::move(*value_);
+}
+
+private:
+std::optional<T> value_;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+public:
+Task<void> get_return_object() noexcept;
+
+void return_void() noexcept {
+}
+
+void result() {
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+};
+
+/**
+ * @brief Fire-and-forget coroutine used by spawn()
+ *
+ * Suspends before running so the executor can start it, and frees its
+ * own frame when it finishes.
+ */
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() noexcept {
+      return Detached{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+
+    std::suspend_always initial_suspend() noexcept {
+      return {};
+    }
+
+    std::suspend_never final_suspend() noexcept {
+      return {};
+    }
+
+    void return_void() noexcept {
+    }
+
+    void unhandled_exception() noexcept {
+      std::terminate();
+    }
+  };
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+}  // namespace detail
+
+/**
+ * @brief A lazily started coroutine returning T
+ *
+ * The coroutine body runs when the Task is co_awaited (or handed to
+ * spawn()), and the awaiting coroutine is resumed by symmetric transfer
+ * when it finishes. Exceptions propagate to the awaiter.
+ *
+ * @author Nestor Pereira Neto
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+using promise_type = detail::TaskPromise<T>;
+
+explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+  : handle_(handle) {
+}
+
+Task(Task&& other) noexcept
+  : handle_(std::exchange(other.handle_, nullptr)) {
+}
+
+Task& operator=(Task&& other) noexcept {
+  if (this != &other) {
+    if (handle_) {
+      handle_.destroy();
+    }
+    handle_ = std::exchange(other.handle_, nullptr);
+  }
+  return *this;
+}
+
+Task(const Task&) = delete;
+Task& operator=(const Task&) = delete;
+
+~Task() {
+  if (handle_) {
+    handle_.destroy();
+  }
+}
+
+/**
+ * @brief Awaiter that starts the task and yields its result
+ */
+struct Awaiter {
+  std::coroutine_handle<promise_type> handle;
+
+  bool await_ready() noexcept {
+    return !handle || handle.done();
+  }
+
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+    handle.promise().continuation_ = awaiting;
+    return handle;
+  }
+
+  T await_resume() {
+    return handle.promise().result();
+  }
+};
+
+Awaiter operator co_await() && noexcept {
+  return Awaiter{handle_};
+}
+
+Awaiter operator co_await() & noexcept {
+  return Awaiter{handle_};
+}
+
+private:
+std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+  return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+  return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+inline Detached runDetached(Task<void> task) {
+  co_await std::move(task);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Starts a task on an executor without waiting for it
+ *
+ * The task starts on the executor's next iteration and its frame is
+ * released when it finishes. Like an exception escaping a std::thread,
+ * an exception escaping the task calls std::terminate(); handle errors
+ * inside the task.
+ *
+ * @param executor The executor to run the task on
+ * @param task The task to start
+ */
+inline void spawn(SerialExecutor& executor, Task<void> task) {
+  detail::Detached detached = detail::runDetached(std::move(task));
+  executor.post([](void* address, bool) {
+      std::coroutine_handle<>::from_address(address).resume();
+    }, detached.handle.address());
+}
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_SERIAL_COROUTINE_HPP_
@@ -3,6 +3,7 @@
 #ifndef INCLUDE_LIBSERIAL_SERIAL_EXCEPTION_HPP_
 #define INCLUDE_LIBSERIAL_SERIAL_EXCEPTION_HPP_
 
+#include <cstddef>
 #include <exception>
 #include <string>
 #include <utility>
@@ -64,12 +65,22 @@ explicit PermissionDeniedException(std::string message)
  *
  * The TimeoutException class is derived from SerialException
  * and is used to indicate that a serial port operation has timed out.
+ * Operations that may complete partially record how many bytes were
+ * transferred before the deadline expired.
  */
 class TimeoutException : public SerialException {
 public:
-explicit TimeoutException(std::string message)
-  : SerialException(std::move(message)) {
+explicit TimeoutException(std::string message, size_t bytes_transferred = 0)
+  : SerialException(std::move(message)), bytes_transferred_(bytes_transferred) {
+}
+/**
+ * @brief Number of bytes transferred before the timeout expired
+ */
+size_t bytesTransferred() const noexcept {
+  return bytes_transferred_;
 }
+private:
+size_t bytes_transferred_;
 };  // class TimeoutException
 
 /**
@@ -87,6 +98,22 @@ explicit IOException(std::string message)
 }
 };  // class IOException
 
+/**
+ * @class FramingException
+ * @brief Exception class for malformed frames
+ *
+ * The FramingException class is derived from SerialException
+ * and describes a frame that a framing codec had to discard. It is
+ * handed to the codec's error callback rather than thrown, so the
+ * stream keeps running.
+ */
+class FramingException : public SerialException {
+public:
+explicit FramingException(std::string message)
+  : SerialException(std::move(message)) {
+}
+};  // class FramingException
+
 }  // namespace libserial
 
 #endif  // INCLUDE_LIBSERIAL_SERIAL_EXCEPTION_HPP_
@@ -0,0 +1,200 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_SERIAL_EXECUTOR_HPP_
+#define INCLUDE_LIBSERIAL_SERIAL_EXECUTOR_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace libserial {
+
+/**
+ * @brief A minimal single-threaded executor driven by epoll
+ *
+ * The SerialExecutor class parks continuations until a file descriptor
+ * becomes readable or writable and resumes them from run(). It is the
+ * scheduler behind the Serial::asyncReadUntil(), Serial::asyncReadBytes()
+ * and Serial::asyncWrite() awaitables, but it only deals in plain
+ * function pointers, so it can also be used from C++17 code.
+ *
+ * A wait costs one small map entry and no allocation per operation;
+ * epoll interest changes are batched and applied once per iteration, so
+ * a continuation that immediately waits again costs no system call.
+ * Apart from stop(), the executor is not thread-safe.
+ *
+ * @author Nestor Pereira Neto
+ */
+class SerialExecutor {
+public:
+/**
+ * @brief Continuation invoked by the executor
+ *
+ * The second argument is true when the descriptor reported POLLHUP or
+ * POLLERR.
+ */
+using ResumeFunction = void (*)(void* context, bool hung_up);
+
+/**
+ * @brief Constructor of the SerialExecutor class
+ *
+ * @throws SerialException if the epoll or wakeup descriptors cannot be created
+ */
+SerialExecutor();
+SerialExecutor(const SerialExecutor&) = delete;
+SerialExecutor& operator=(const SerialExecutor&) = delete;
+
+/**
+ * @brief Destructor of the SerialExecutor class
+ *
+ * Pending continuations are dropped without being resumed.
+ */
+~SerialExecutor() noexcept;
+
+/**
+ * @brief Resumes a continuation once fd becomes readable
+ *
+ * @param fd The descriptor to watch
+ * @param resume The continuation
+ * @param context Argument passed to the continuation
+ * @throws SerialException if another read wait is pending on fd
+ */
+void waitReadable(int fd, ResumeFunction resume, void* context);
+
+/**
+ * @brief Resumes a continuation once fd becomes writable
+ *
+ * @param fd The descriptor to watch
+ * @param resume The continuation
+ * @param context Argument passed to the continuation
+ * @throws SerialException if another write wait is pending on fd
+ */
+void waitWritable(int fd, ResumeFunction resume, void* context);
+
+/**
+ * @brief Resumes a continuation on the next iteration
+ *
+ * @param resume The continuation, invoked with hung_up set to false
+ * @param context Argument passed to the continuation
+ */
+void post(ResumeFunction resume, void* context);
+
+/**
+ * @brief Waits for readiness once and resumes the ready continuations
+ *
+ * @param timeout Maximum time to wait; negative values wait indefinitely
+ * @return Number of continuations resumed
+ * @throws SerialException if epoll_wait fails
+ */
+size_t runOnce(std::chrono::milliseconds timeout);
+
+/**
+ * @brief Runs until stop() is called or no continuation is pending
+ *
+ * @throws SerialException if epoll_wait fails
+ */
+void run();
+
+/**
+ * @brief Makes run() return as soon as possible
+ *
+ * Thread-safe; interrupts a blocked epoll_wait immediately.
+ */
+void stop();
+
+/**
+ * @brief Gets the number of parked continuations
+ *
+ * @return Number of pending waits and posted continuations
+ */
+size_t getPendingCount() const;
+
+/**
+ * @brief Gets the executor running on the calling thread
+ *
+ * @return The executor whose runOnce() is on the stack, or nullptr
+ */
+static SerialExecutor* current();
+
+private:
+/**
+ * @brief A parked continuation
+ */
+struct Waiter {
+  ResumeFunction resume{nullptr};  ///< Continuation, null when unused
+  void* context{nullptr};          ///< Argument of the continuation
+  bool hung_up{false};             ///< Passed to a posted continuation
+};
+
+/**
+ * @brief Waits registered on one descriptor
+ */
+struct FdState {
+  Waiter reader;          ///< Continuation waiting for EPOLLIN
+  Waiter writer;          ///< Continuation waiting for EPOLLOUT
+  uint32_t events{0};     ///< Interest currently registered with epoll
+  bool dirty{false};      ///< Interest must be synced before the next wait
+};
+
+/**
+ * @brief Parks a continuation on a descriptor
+ *
+ * @param fd The descriptor to watch
+ * @param write true to wait for EPOLLOUT, false for EPOLLIN
+ * @param resume The continuation
+ * @param context Argument passed to the continuation
+ */
+void wait(int fd, bool write, ResumeFunction resume, void* context);
+
+/**
+ * @brief Applies pending interest changes to the epoll set
+ */
+void syncInterest();
+
+/**
+ * @brief The epoll instance
+ */
+int epoll_fd_{-1};
+
+/**
+ * @brief Eventfd used by stop() to interrupt epoll_wait
+ */
+int wake_fd_{-1};
+
+/**
+ * @brief Set by stop(), cleared when run() returns
+ */
+std::atomic<bool> stop_requested_{false};
+
+/**
+ * @brief Waits by descriptor
+ */
+std::unordered_map<int, FdState> fds_;
+
+/**
+ * @brief Descriptors whose interest changed since the last sync
+ */
+std::vector<int> dirty_;
+
+/**
+ * @brief Continuations posted for the next iteration
+ */
+std::deque<Waiter> posted_;
+
+/**
+ * @brief Number of pending descriptor waits
+ */
+size_t pending_waits_{0};
+
+/**
+ * @brief Maximum number of events collected per epoll_wait
+ */
+static constexpr int kMaxEvents{256};
+};
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_SERIAL_EXECUTOR_HPP_
@@ -0,0 +1,463 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_SERIAL_REACTOR_HPP_
+#define INCLUDE_LIBSERIAL_SERIAL_REACTOR_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "libserial/io_uring.hpp"
+#include "libserial/serial.hpp"
+#include "libserial/serial_exception.hpp"
+
+namespace libserial {
+
+/**
+ * @brief I/O mechanism used by SerialReactor
+ */
+enum class ReactorBackend {
+  EPOLL,     ///< Readiness via epoll, then read()/write() per port
+  IO_URING   ///< Reads and writes of all ports batched through io_uring
+};
+
+/**
+ * @brief Callbacks and timeouts for a port registered with SerialReactor
+ *
+ * Every handler is optional. on_data sees every chunk exactly as it was
+ * read; on_line sees complete lines, reassembled across wakeups, split
+ * on the port's configured Terminator (the terminator is included).
+ */
+struct PortHandlers {
+/**
+ * @brief Called with every chunk of data read from the port
+ */
+std::function<void(Serial&, const char*, size_t)> on_data;
+
+/**
+ * @brief Called with every complete terminator-delimited line
+ */
+std::function<void(Serial&, const std::string&)> on_line;
+
+/**
+ * @brief Called when no data arrived within read_timeout
+ */
+std::function<void(Serial&)> on_read_timeout;
+
+/**
+ * @brief Called when queued output could not be sent within write_timeout
+ *
+ * The second argument is the number of bytes that were discarded.
+ */
+std::function<void(Serial&, size_t)> on_write_timeout;
+
+/**
+ * @brief Called when an I/O error occurs on the port
+ *
+ * A port that hangs up or fails is removed from the reactor after this
+ * handler returns.
+ */
+std::function<void(Serial&, const SerialException&)> on_error;
+
+/**
+ * @brief Maximum idle time between two reads; 0 disables the timeout
+ */
+std::chrono::milliseconds read_timeout{0};
+
+/**
+ * @brief Maximum time queued output may wait; 0 disables the timeout
+ */
+std::chrono::milliseconds write_timeout{0};
+};
+
+/**
+ * @brief An epoll-based event loop driving many Serial ports from one thread
+ *
+ * The SerialReactor class registers any number of open Serial instances
+ * on a single epoll set and dispatches readiness to per-port handlers.
+ * Partial lines are buffered per port until their terminator arrives.
+ * All per-port read and write timeouts are driven by one timerfd armed
+ * for the earliest pending deadline, instead of per-call poll timeouts.
+ *
+ * With ReactorBackend::IO_URING every port keeps a linked POLL_ADD+READ
+ * pair in flight on a registered buffer, and the reads and writes of all
+ * ports are submitted together in one io_uring_enter(2) per runOnce().
+ * When io_uring is unavailable at runtime the reactor falls back to
+ * epoll; getBackend() reports which one is active.
+ *
+ * The reactor does not own the Serial objects; they must outlive their
+ * registration, and their blocking read and write calls must not be
+ * used while registered. Apart from stop(), the reactor is not thread-safe and is
+ * meant to be used from the thread that runs it.
+ *
+ * @author Nestor Pereira Neto
+ */
+class SerialReactor {
+public:
+/**
+ * @brief Constructor of the SerialReactor class
+ *
+ * @param backend Preferred I/O mechanism; IO_URING falls back to EPOLL
+ * when the kernel does not support it
+ * @throws SerialException if the epoll, timer or wakeup descriptors cannot be created
+ */
+explicit SerialReactor(ReactorBackend backend = ReactorBackend::EPOLL);
+SerialReactor(const SerialReactor&) = delete;
+SerialReactor& operator=(const SerialReactor&) = delete;
+
+/**
+ * @brief Destructor of the SerialReactor class
+ *
+ * Releases the reactor's own descriptors. Registered ports stay open.
+ * With the io_uring backend, in-flight operations are cancelled and
+ * reaped first.
+ */
+~SerialReactor() noexcept;
+
+/**
+ * @brief Registers an open port with the reactor
+ *
+ * Bytes already held in the port's receive buffer, e.g. left over from
+ * an earlier readUntil(), are handed to the handlers before returning.
+ *
+ * @param serial The port to watch; must stay alive while registered
+ * @param handlers Callbacks and timeouts for this port
+ * @throws SerialException if the port is not open or already registered
+ */
+void addPort(Serial& serial, PortHandlers handlers);
+
+/**
+ * @brief Unregisters a port
+ *
+ * Safe to call from within a handler, including the port's own.
+ * Pending output and partial lines are discarded.
+ *
+ * @param serial The port to remove
+ */
+void removePort(Serial& serial);
+
+/**
+ * @brief Queues data for asynchronous transmission on a registered port
+ *
+ * As much as possible is written immediately; the rest is kept in a
+ * per-port queue and flushed when the port becomes writable. The port's
+ * write_timeout starts when data first has to be queued. With the
+ * io_uring backend nothing is written immediately: the data is submitted
+ * with the next runOnce() batch.
+ *
+ * @param serial The registered port to write to
+ * @param data Pointer to the bytes to send
+ * @param size Number of bytes to send
+ * @throws SerialException if the port is not registered or the write fails
+ */
+void send(Serial& serial, const void* data, size_t size);
+
+/**
+ * @brief Waits for events once and dispatches them
+ *
+ * @param timeout Maximum time to wait; negative values wait indefinitely
+ * @return Number of readiness events dispatched
+ * @throws SerialException if epoll_wait fails
+ */
+size_t runOnce(std::chrono::milliseconds timeout);
+
+/**
+ * @brief Dispatches events until stop() is called
+ *
+ * @throws SerialException if epoll_wait fails
+ */
+void run();
+
+/**
+ * @brief Makes run() return as soon as possible
+ *
+ * Thread-safe; interrupts a blocked epoll_wait immediately.
+ */
+void stop();
+
+/**
+ * @brief Gets the number of registered ports
+ *
+ * @return The number of ports currently registered
+ */
+size_t getPortCount() const;
+
+/**
+ * @brief Gets the I/O mechanism actually in use
+ *
+ * @return The active backend, EPOLL if IO_URING was requested but unavailable
+ */
+ReactorBackend getBackend() const;
+
+/**
+ * @brief Gets the number of system calls issued by the event loop
+ *
+ * Counts waits (epoll_wait or io_uring_enter), reads, writes and
+ * interest or timer updates. Useful to compare backends.
+ *
+ * @return The number of system calls since construction
+ */
+uint64_t getSystemCallCount() const;
+
+private:
+/**
+ * @brief Per-port registration state
+ */
+struct Port : std::enable_shared_from_this<Port> {
+  Serial* serial{nullptr};      ///< The registered port
+  int fd{-1};                   ///< Descriptor the port was registered with
+  PortHandlers handlers;        ///< User callbacks and timeouts
+  std::string line;             ///< Partial line carried across wakeups
+  std::string tx_queue;         ///< Output waiting for POLLOUT
+  size_t tx_offset{0};          ///< Bytes of tx_queue already sent
+  bool want_write{false};       ///< Whether EPOLLOUT is in the interest set
+  bool removed{false};          ///< Set once the port has been unregistered
+  std::chrono::steady_clock::time_point read_deadline;   ///< When on_read_timeout fires
+  std::chrono::steady_clock::time_point write_deadline;  ///< When on_write_timeout fires
+
+  // io_uring backend only
+  char* read_data{nullptr};     ///< Destination of the in-flight read
+  int buffer_slot{-1};          ///< Registered buffer index, -1 for a plain read
+  std::vector<char> own_buffer; ///< Read buffer when no registered slot is free
+  std::string tx_inflight;      ///< Output owned by the in-flight write
+  bool read_armed{false};       ///< Whether a POLL_ADD+READ pair is in flight
+  bool write_armed{false};      ///< Whether a POLL_ADD+WRITE pair is in flight
+  bool tx_cancelled{false};     ///< In-flight write was dropped by a timeout
+  bool hung_up{false};          ///< The read poll reported POLLHUP or POLLERR
+  unsigned int pending_ops{0};  ///< Submitted operations not yet completed
+};
+
+/**
+ * @brief Reads everything available on a port and runs its handlers
+ *
+ * @param port The port that became readable
+ */
+void handleReadable(const std::shared_ptr<Port>& port);
+
+/**
+ * @brief Runs the handlers on bytes already held in the port's receive buffer
+ *
+ * @param port The port just registered
+ */
+void deliverBuffered(const std::shared_ptr<Port>& port);
+
+/**
+ * @brief Runs the data and line handlers of a port on freshly read bytes
+ *
+ * @param port The port the data was read from
+ * @param data Pointer to the bytes read
+ * @param size Number of bytes read
+ */
+void deliver(const std::shared_ptr<Port>& port, const char* data, size_t size);
+
+/**
+ * @brief Flushes as much queued output as the port accepts
+ *
+ * @param port The port that became writable
+ */
+void handleWritable(const std::shared_ptr<Port>& port);
+
+/**
+ * @brief Fires expired read and write timeouts
+ */
+void handleTimers();
+
+/**
+ * @brief Reports an error on a port and unregisters it
+ *
+ * @param port The failing port
+ * @param error The error passed to on_error
+ */
+void failPort(const std::shared_ptr<Port>& port, const SerialException& error);
+
+/**
+ * @brief Updates the epoll interest set of a port
+ *
+ * @param port The port whose EPOLLOUT interest changed
+ */
+void updateInterest(const Port& port);
+
+/**
+ * @brief Arms the timerfd for the earliest pending deadline
+ */
+void armTimer();
+
+/**
+ * @brief Closes the reactor's own descriptors
+ */
+void closeDescriptors();
+
+/**
+ * @brief Discards all pending output of a port
+ *
+ * @param port The port whose output is dropped
+ * @return Number of bytes discarded
+ */
+size_t dropOutput(Port& port);
+
+/**
+ * @brief Sets up the io_uring backend
+ *
+ * @return true if io_uring is usable, false to fall back to epoll
+ */
+bool initUring();
+
+/**
+ * @brief One runOnce() iteration of the io_uring backend
+ *
+ * @param timeout Maximum time to wait; negative values wait indefinitely
+ * @return Number of port completions dispatched
+ */
+size_t runOnceUring(std::chrono::milliseconds timeout);
+
+/**
+ * @brief Handles one io_uring completion
+ *
+ * @param cqe The completion to handle
+ * @return 1 if a port read or write completed, 0 otherwise
+ */
+size_t handleCompletion(const struct io_uring_cqe& cqe);
+
+/**
+ * @brief Queues a linked POLL_ADD+READ pair for a port
+ *
+ * @param port The port to read from
+ */
+void armRead(Port& port);
+
+/**
+ * @brief Queues a linked POLL_ADD+WRITE pair for the pending output of a port
+ *
+ * @param port The port to write to
+ */
+void armWrite(Port& port);
+
+/**
+ * @brief Queues a POLL_ADD on one of the reactor's own descriptors
+ *
+ * @param fd The timer or wakeup descriptor
+ * @param tag The user data tag identifying the descriptor
+ */
+void armInternalPoll(int fd, uint64_t tag);
+
+/**
+ * @brief Queues cancellation of an in-flight operation
+ *
+ * @param user_data The user data of the operation to cancel
+ */
+void cancelOperation(uint64_t user_data);
+
+/**
+ * @brief Makes sure enough submission entries are free for a linked pair
+ *
+ * @param count Number of entries needed
+ * @return Pointer to the first of count consecutive entries
+ */
+struct io_uring_sqe* reserveSqes(unsigned int count);
+
+/**
+ * @brief Releases the resources of an unregistered io_uring port
+ *
+ * @param port The port whose operations have all completed
+ */
+void releaseUringPort(Port* port);
+
+/**
+ * @brief The backend actually in use
+ */
+ReactorBackend backend_{ReactorBackend::EPOLL};
+
+/**
+ * @brief The io_uring instance, null with the epoll backend
+ */
+std::unique_ptr<IoUring> ring_;
+
+/**
+ * @brief Memory backing the registered read buffers
+ */
+std::vector<char> buffer_arena_;
+
+/**
+ * @brief Registered buffer slots not assigned to a port
+ */
+std::vector<int> free_slots_;
+
+/**
+ * @brief Unregistered ports whose io_uring operations are still in flight
+ */
+std::vector<std::shared_ptr<Port>> retired_;
+
+/**
+ * @brief Whether the timer and wakeup polls are in flight
+ */
+bool timer_armed_{false};
+bool wake_armed_{false};
+
+/**
+ * @brief Deadline the timerfd is currently armed for
+ */
+std::chrono::steady_clock::time_point timer_deadline_{std::chrono::steady_clock::time_point::max()};
+
+/**
+ * @brief Number of system calls issued by the event loop
+ */
+uint64_t syscalls_{0};
+
+/**
+ * @brief The epoll instance
+ */
+int epoll_fd_{-1};
+
+/**
+ * @brief The single timer source for every port timeout
+ */
+int timer_fd_{-1};
+
+/**
+ * @brief Eventfd used by stop() to interrupt epoll_wait
+ */
+int wake_fd_{-1};
+
+/**
+ * @brief Set by stop(), cleared when run() returns
+ */
+std::atomic<bool> stop_requested_{false};
+
+/**
+ * @brief Registered ports by file descriptor
+ */
+std::unordered_map<int, std::shared_ptr<Port>> ports_;
+
+/**
+ * @brief Scratch buffer for reads, shared by all ports
+ */
+std::vector<char> read_buffer_;
+
+/**
+ * @brief Maximum number of events collected per epoll_wait
+ */
+static constexpr int kMaxEvents{64};
+
+/**
+ * @brief Size of the shared read scratch buffer
+ */
+static constexpr size_t kReadBufferSize{4096};
+
+/**
+ * @brief Submission queue size of the io_uring backend
+ */
+static constexpr unsigned int kUringEntries{256};
+
+/**
+ * @brief Number of registered read buffers of the io_uring backend
+ */
+static constexpr int kUringBufferSlots{64};
+};
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_SERIAL_REACTOR_HPP_
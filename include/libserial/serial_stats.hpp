@@ -0,0 +1,252 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_SERIAL_STATS_HPP_
+#define INCLUDE_LIBSERIAL_SERIAL_STATS_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+
+#include "libserial/config.hpp"
+
+namespace libserial {
+
+/**
+ * @brief Distribution of call durations in power-of-two buckets
+ *
+ * Bucket i counts the calls that took from 2^i up to 2^(i+1) - 1
+ * nanoseconds; bucket 0 also counts calls under one nanosecond and the
+ * last bucket every call longer than its lower bound (about one second).
+ *
+ * @author Nestor Pereira Neto
+ */
+struct LatencyHistogram {
+/**
+ * @brief Number of buckets
+ */
+static constexpr size_t kBuckets = 32;
+
+/**
+ * @brief Number of calls per bucket
+ */
+std::array<uint64_t, kBuckets> buckets{};
+
+/**
+ * @brief Gets the number of calls recorded
+ *
+ * @return Sum of all buckets
+ */
+uint64_t getCount() const;
+
+/**
+ * @brief Gets an upper bound of the given percentile
+ *
+ * @param percentile Value between 0 and 100
+ * @return Upper limit of the bucket holding the percentile, zero when empty
+ */
+std::chrono::nanoseconds getPercentile(double percentile) const;
+};
+
+/**
+ * @brief Snapshot of the runtime statistics of a Serial port
+ *
+ * Returned by Serial::getStats(). All counts start at zero when the
+ * port object is created or Serial::resetStats() is called. Without
+ * BUILD_STATS_ON every count stays zero.
+ *
+ * @author Nestor Pereira Neto
+ */
+struct SerialStats {
+/**
+ * @brief Bytes received from and sent to the port
+ */
+uint64_t bytes_read{0};
+uint64_t bytes_written{0};
+
+/**
+ * @brief System calls issued on the port descriptor; ioctl_calls includes fcntl()
+ */
+uint64_t read_calls{0};
+uint64_t write_calls{0};
+uint64_t poll_calls{0};
+uint64_t ioctl_calls{0};
+
+/**
+ * @brief Reads and writes that found the port not ready (EAGAIN)
+ */
+uint64_t eagain_retries{0};
+
+/**
+ * @brief Read and write operations that ran out of time
+ */
+uint64_t timeouts{0};
+
+/**
+ * @brief Exceptions thrown by the read and write calls
+ */
+uint64_t exceptions{0};
+
+/**
+ * @brief Duration of the read*() calls and of the write calls
+ */
+LatencyHistogram read_latency;
+LatencyHistogram write_latency;
+};
+
+/**
+ * @brief Counters of the statistics recorded by Serial
+ */
+enum class StatsCounter {
+  BYTES_READ,
+  BYTES_WRITTEN,
+  READ_CALLS,
+  WRITE_CALLS,
+  POLL_CALLS,
+  IOCTL_CALLS,
+  EAGAIN_RETRIES,
+  TIMEOUTS,
+  EXCEPTIONS,
+  COUNT
+};
+
+/**
+ * @brief Latency histograms recorded by Serial
+ */
+enum class StatsLatency {
+  READ,
+  WRITE,
+  COUNT
+};
+
+/**
+ * @brief Lock-free recorder behind Serial::getStats()
+ *
+ * Counters are relaxed atomics: recording costs one uncontended atomic
+ * add and a snapshot may be taken from any thread while the port is in
+ * use. The counts of a snapshot are individually exact but not taken
+ * at a single instant. Unless libserial/config.hpp defines BUILD_STATS_ON
+ * (the BUILD_STATS CMake option) the class holds no data and every
+ * method compiles to nothing.
+ *
+ * @author Nestor Pereira Neto
+ */
+class StatsRecorder {
+public:
+/**
+ * @brief Whether statistics are compiled in
+ */
+#ifdef BUILD_STATS_ON
+static constexpr bool kEnabled = true;
+#else
+static constexpr bool kEnabled = false;
+#endif
+
+/**
+ * @brief Adds to a counter
+ *
+ * @param counter The counter to increase
+ * @param value Amount to add
+ */
+void add(StatsCounter counter, uint64_t value = 1) {
+#ifdef BUILD_STATS_ON
+  counters_[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+#else
+  (void)counter;
+  (void)value;
+#endif
+}
+
+/**
+ * @brief Records the duration of a call
+ *
+ * @param latency The histogram to update
+ * @param duration How long the call took
+ */
+void record(StatsLatency latency, std::chrono::nanoseconds duration) {
+#ifdef BUILD_STATS_ON
+  const uint64_t ns = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 1));
+  size_t bucket = static_cast<size_t>(63 - __builtin_clzll(ns));
+  bucket = std::min(bucket, LatencyHistogram::kBuckets - 1);
+  latencies_[static_cast<size_t>(latency)][bucket].fetch_add(1, std::memory_order_relaxed);
+#else
+  (void)latency;
+  (void)duration;
+#endif
+}
+
+/**
+ * @brief Copies the current counts
+ *
+ * @return The statistics, all zero when statistics are compiled out
+ */
+SerialStats snapshot() const;
+
+/**
+ * @brief Sets every count back to zero
+ */
+void reset();
+
+private:
+#ifdef BUILD_STATS_ON
+std::array<std::atomic<uint64_t>, static_cast<size_t>(StatsCounter::COUNT)> counters_{};
+std::array<std::array<std::atomic<uint64_t>, LatencyHistogram::kBuckets>,
+           static_cast<size_t>(StatsLatency::COUNT)> latencies_{};
+#endif
+};
+
+/**
+ * @brief Times a read or write call and counts the exception it throws, if any
+ *
+ * @author Nestor Pereira Neto
+ */
+class StatsScope {
+public:
+/**
+ * @brief Starts timing a call
+ *
+ * @param recorder The recorder of the port
+ * @param latency The histogram the call belongs to
+ */
+StatsScope(StatsRecorder& recorder, StatsLatency latency)
+#ifdef BUILD_STATS_ON
+  : recorder_(recorder), latency_(latency), exceptions_(std::uncaught_exceptions()),
+  start_(std::chrono::steady_clock::now()) {
+}
+#else
+{
+  (void)recorder;
+  (void)latency;
+}
+#endif
+
+StatsScope(const StatsScope&) = delete;
+StatsScope& operator=(const StatsScope&) = delete;
+
+/**
+ * @brief Records the duration of the call
+ */
+~StatsScope() {
+#ifdef BUILD_STATS_ON
+  recorder_.record(latency_, std::chrono::steady_clock::now() - start_);
+  if (std::uncaught_exceptions() > exceptions_) {
+    recorder_.add(StatsCounter::EXCEPTIONS);
+  }
+#endif
+}
+
+private:
+#ifdef BUILD_STATS_ON
+StatsRecorder& recorder_;
+StatsLatency latency_;
+int exceptions_;
+std::chrono::steady_clock::time_point start_;
+#endif
+};
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_SERIAL_STATS_HPP_
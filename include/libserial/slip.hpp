@@ -0,0 +1,127 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_SLIP_HPP_
+#define INCLUDE_LIBSERIAL_SLIP_HPP_
+
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "libserial/stream_framer.hpp"
+
+namespace libserial {
+
+/**
+ * @brief SLIP (RFC 1055) framing on top of Serial
+ *
+ * Frames are delimited by END (0xC0); END and ESC (0xDB) inside a frame
+ * travel as ESC ESC_END and ESC ESC_ESC. Outgoing frames are written as
+ * a list of segments pointing into the caller's payload, with the escape
+ * pairs taken from constant storage, so no escaped copy is built;
+ * writeFrames() sends a whole batch of frames with one writev(). Escape
+ * sequences split across reads are decoded incrementally.
+ *
+ * Unlike RFC 1055, which passes an invalid escape through unchanged, an
+ * ESC followed by anything but ESC_END or ESC_ESC drops the frame and is
+ * reported as a framing error, as does a frame longer than the maximum
+ * size. Empty frames (back-to-back END bytes) are ignored.
+ *
+ * @author Nestor Pereira Neto
+ */
+class SlipFramer : public StreamFramer {
+public:
+/**
+ * @brief Frame delimiter
+ */
+static constexpr uint8_t kEnd = 0xC0;
+
+/**
+ * @brief Escape byte
+ */
+static constexpr uint8_t kEsc = 0xDB;
+
+/**
+ * @brief Escaped END, follows kEsc
+ */
+static constexpr uint8_t kEscEnd = 0xDC;
+
+/**
+ * @brief Escaped ESC, follows kEsc
+ */
+static constexpr uint8_t kEscEsc = 0xDD;
+
+/**
+ * @brief Constructor of the SlipFramer class
+ *
+ * @param serial The port frames are read from and written to
+ * @param max_frame_size Largest decoded frame accepted, in bytes
+ * @throws SerialException if max_frame_size is zero
+ */
+explicit SlipFramer(Serial& serial, size_t max_frame_size = kDefaultMaxFrameSize);
+
+using StreamFramer::writeFrame;
+
+/**
+ * @brief Escapes a frame and writes it with a single writev()
+ *
+ * The frame is preceded and followed by END, so line noise received
+ * before it is flushed as a separate (dropped) frame.
+ *
+ * @param data Pointer to the frame payload
+ * @param size Number of payload bytes
+ * @return Number of bytes written, END bytes included
+ * @throws IOException if write operation fails
+ * @throws IOException if data is null while size is not zero
+ * @throws TimeoutException if the write timeout expires
+ */
+size_t writeFrame(const void* data, size_t size) override;
+
+/**
+ * @brief Escapes a batch of frames and writes them with a single writev()
+ *
+ * Consecutive frames share their END delimiter.
+ *
+ * @param frames Array of frame payloads
+ * @param count Number of entries in frames
+ * @return Number of bytes written, END bytes included
+ * @throws IOException if write operation fails
+ * @throws IOException if frames is null while count is not zero
+ * @throws TimeoutException if the write timeout expires
+ */
+size_t writeFrames(const struct iovec* frames, size_t count);
+
+protected:
+size_t decode(const uint8_t* data, size_t size, bool* frame_done) override;
+void resetFrame() override;
+
+private:
+/**
+ * @brief Reports a dropped frame and resets the decoder
+ *
+ * @param message Description of the error
+ * @param skip_to_end Whether input up to the next END must be skipped
+ */
+void dropFrame(const std::string& message, bool skip_to_end);
+
+/**
+ * @brief Whether the previous byte was an ESC
+ */
+bool escaped_{false};
+
+/**
+ * @brief Whether input is skipped until the next END
+ */
+bool discarding_{false};
+
+/**
+ * @brief Segments of the frames being written, reused across calls
+ */
+std::vector<struct iovec> segments_;
+};
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_SLIP_HPP_
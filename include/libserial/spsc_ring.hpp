@@ -0,0 +1,220 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_SPSC_RING_HPP_
+#define INCLUDE_LIBSERIAL_SPSC_RING_HPP_
+
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace libserial {
+
+/**
+ * @brief A lock-free single-producer/single-consumer byte ring
+ *
+ * Hands bytes from an I/O thread to a decoding thread without locks or
+ * intermediate copies. The producer asks for the free space as (at most)
+ * two regions, fills them - e.g. straight from the descriptor with
+ * Serial::readInto() - and publishes them with commitWrite(). The
+ * consumer sees the stored bytes as two contiguous regions, parses them
+ * in place and releases them with consume().
+ *
+ * The producer and consumer indices live on separate cache lines, and
+ * each side keeps a private copy of the other side's index so that the
+ * shared line is only touched when the cached value runs out.
+ *
+ * Exactly one thread may call the producer functions and exactly one
+ * thread the consumer functions. Watermarks must be configured before
+ * either thread starts.
+ *
+ * @author Nestor Pereira Neto
+ */
+class SpscRing {
+public:
+/**
+ * @brief Size of a cache line, used to keep the indices apart
+ */
+static constexpr size_t kCacheLineSize = 64;
+
+/**
+ * @brief Constructor of the SpscRing class
+ *
+ * @param capacity Requested capacity in bytes, rounded up to a power of two
+ * @throws SerialException if capacity is zero or too large
+ */
+explicit SpscRing(size_t capacity);
+SpscRing(const SpscRing&) = delete;
+SpscRing& operator=(const SpscRing&) = delete;
+
+/**
+ * @brief Gets the capacity of the ring
+ *
+ * @return Capacity in bytes
+ */
+size_t getCapacity() const;
+
+/**
+ * @brief Gets the number of bytes stored
+ *
+ * Exact when called from the producer or consumer thread, a snapshot
+ * from anywhere else.
+ *
+ * @return Number of bytes ready to be consumed
+ */
+size_t size() const;
+
+/**
+ * @brief Checks whether the ring holds no bytes
+ *
+ * @return true if size() is zero
+ */
+bool empty() const;
+
+/**
+ * @brief Sets the level at which the producer is notified that the ring is filling up
+ *
+ * The callback runs on the producer thread, inside commitWrite(), each
+ * time the fill level rises from below level to level or above.
+ *
+ * @param level Fill level in bytes; 0 disables the notification
+ * @param callback Callable invoked as callback(size_t fill_level)
+ */
+void setHighWatermark(size_t level, std::function<void(size_t)> callback);
+
+/**
+ * @brief Sets the level at which the consumer is notified that the ring has drained
+ *
+ * The callback runs on the consumer thread, inside consume(), each time
+ * the fill level falls from above level to level or below.
+ *
+ * @param level Fill level in bytes
+ * @param callback Callable invoked as callback(size_t fill_level)
+ */
+void setLowWatermark(size_t level, std::function<void(size_t)> callback);
+
+/**
+ * @brief Gets the free space as up to two regions (producer side)
+ *
+ * The second region is only non-empty when the free space wraps around
+ * the end of the storage. Both can be passed to readv() as they are.
+ *
+ * @param regions Receives the free regions, in order
+ * @return Total number of free bytes
+ */
+size_t writableRegions(struct iovec (&regions)[2]);
+
+/**
+ * @brief Publishes bytes written into the writable regions (producer side)
+ *
+ * @param count Number of bytes written, from the start of the first region
+ * @throws SerialException if count exceeds the free space
+ */
+void commitWrite(size_t count);
+
+/**
+ * @brief Copies bytes into the ring (producer side)
+ *
+ * @param data Pointer to the bytes to store
+ * @param size Number of bytes to store
+ * @return Number of bytes stored; less than size if the ring is full
+ */
+size_t write(const void* data, size_t size);
+
+/**
+ * @brief Gets the stored bytes as up to two regions (consumer side)
+ *
+ * The second region is only non-empty when the data wraps around the
+ * end of the storage. The regions stay valid until consume().
+ *
+ * @param regions Receives the readable regions, in order
+ * @return Total number of readable bytes
+ */
+size_t readableRegions(struct iovec (&regions)[2]);
+
+/**
+ * @brief Releases bytes at the front of the ring (consumer side)
+ *
+ * @param count Number of bytes to release
+ * @throws SerialException if count exceeds the stored bytes
+ */
+void consume(size_t count);
+
+/**
+ * @brief Copies bytes out of the ring and releases them (consumer side)
+ *
+ * @param buffer Pointer to the memory where data will be stored
+ * @param size Capacity of buffer in bytes
+ * @return Number of bytes copied
+ */
+size_t read(void* buffer, size_t size);
+
+private:
+/**
+ * @brief Gets the free space, refreshing cached_tail_ only if it shows less than wanted
+ */
+size_t writableSpace(size_t wanted);
+
+/**
+ * @brief Gets the stored byte count, refreshing cached_head_ only if it shows less than wanted
+ */
+size_t readableSpace(size_t wanted);
+
+/**
+ * @brief Splits [begin, begin + count) of the storage into regions
+ */
+void fillRegions(size_t begin, size_t count, struct iovec (&regions)[2]) const;
+
+/**
+ * @brief Storage, capacity_ bytes
+ */
+std::unique_ptr<char[]> data_;
+
+/**
+ * @brief Capacity in bytes, a power of two
+ */
+size_t capacity_;
+
+/**
+ * @brief capacity_ - 1, turns a running index into a storage offset
+ */
+size_t mask_;
+
+/**
+ * @brief High watermark level and callback (producer side)
+ */
+size_t high_watermark_{0};
+std::function<void(size_t)> on_high_watermark_;
+
+/**
+ * @brief Low watermark level and callback (consumer side)
+ */
+size_t low_watermark_{0};
+std::function<void(size_t)> on_low_watermark_;
+
+/**
+ * @brief Running count of bytes written, owned by the producer
+ */
+alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+
+/**
+ * @brief Producer's copy of tail_, refreshed when the ring looks full
+ */
+size_t cached_tail_{0};
+
+/**
+ * @brief Running count of bytes consumed, owned by the consumer
+ */
+alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+
+/**
+ * @brief Consumer's copy of head_, refreshed when the ring looks empty
+ */
+size_t cached_head_{0};
+};
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_SPSC_RING_HPP_
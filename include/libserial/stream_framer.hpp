@@ -0,0 +1,257 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_STREAM_FRAMER_HPP_
+#define INCLUDE_LIBSERIAL_STREAM_FRAMER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "libserial/serial_exception.hpp"
+
+namespace libserial {
+
+class Serial;
+
+/**
+ * @brief Common machinery of the framing codecs layered on Serial
+ *
+ * A framer turns the byte stream of a Serial port into frames. Derived
+ * classes provide the wire format: writeFrame() encodes and writes one
+ * frame, decode() consumes received bytes incrementally into the frame
+ * buffer. This class provides the two ways of receiving frames:
+ *
+ * - pull: readFrame() reads from the port until a frame is complete and
+ *   keeps the bytes that follow it for the next call;
+ * - push: feed() decodes bytes read elsewhere (e.g. by Serial::onData())
+ *   and hands every complete frame to the onFrame() callback.
+ *
+ * Use one of the two on a given framer, not both. Malformed frames are
+ * dropped and reported to the onFrameError() callback; they never end
+ * the stream.
+ *
+ * @author Nestor Pereira Neto
+ */
+class StreamFramer {
+public:
+/**
+ * @brief Default maximum decoded frame size in bytes
+ */
+static constexpr size_t kDefaultMaxFrameSize = 4096;
+
+StreamFramer(const StreamFramer&) = delete;
+StreamFramer& operator=(const StreamFramer&) = delete;
+
+/**
+ * @brief Destructor of the StreamFramer class
+ */
+virtual ~StreamFramer() = default;
+
+/**
+ * @brief Encodes a frame and writes it to the serial port
+ *
+ * @param data Pointer to the frame payload
+ * @param size Number of payload bytes
+ * @return Number of bytes written on the wire
+ * @throws IOException if write operation fails
+ * @throws IOException if data is null while size is not zero
+ * @throws TimeoutException if the write timeout expires
+ */
+virtual size_t writeFrame(const void* data, size_t size) = 0;
+
+/**
+ * @brief Encodes a frame and writes it to the serial port
+ *
+ * @param frame The frame payload
+ * @return Number of bytes written on the wire
+ * @throws IOException if write operation fails
+ * @throws TimeoutException if the write timeout expires
+ */
+size_t writeFrame(const std::string& frame);
+
+/**
+ * @brief Reads and decodes the next complete frame
+ *
+ * Reads from the port (see Serial::readSome()) until a frame is
+ * complete. Bytes following the frame are kept for the next call.
+ * Malformed frames are reported to the error callback and skipped.
+ *
+ * @param frame String the decoded frame is assigned to
+ * @return Size of the frame
+ * @throws IOException if reading fails or times out
+ * @throws IOException if frame is null
+ */
+size_t readFrame(std::shared_ptr<std::string> frame);
+
+/**
+ * @brief Reads and decodes the next complete frame into caller memory
+ *
+ * @param buffer Pointer to the memory where the frame will be stored
+ * @param size Capacity of buffer in bytes
+ * @return Size of the frame
+ * @throws IOException if reading fails or times out
+ * @throws IOException if buffer is null
+ * @throws IOException if the frame does not fit; the frame is dropped
+ */
+size_t readFrame(void* buffer, size_t size);
+
+/**
+ * @brief Decodes received bytes and delivers every complete frame
+ *
+ * @param data Pointer to the received bytes
+ * @param size Number of bytes
+ * @return Number of frames delivered to the onFrame() callback
+ */
+size_t feed(const void* data, size_t size);
+
+/**
+ * @brief Registers the callback invoked by feed() for every complete frame
+ *
+ * The frame points into the framer and is only valid during the call.
+ *
+ * @param callback Callable invoked as callback(const char* frame, size_t size)
+ */
+void onFrame(std::function<void(const char*, size_t)> callback);
+
+/**
+ * @brief Registers the callback invoked for every dropped frame
+ *
+ * @param callback Callable invoked as callback(const FramingException& error)
+ */
+void onFrameError(std::function<void(const FramingException&)> callback);
+
+/**
+ * @brief Gets the number of frames dropped as malformed
+ *
+ * @return Number of framing errors since construction
+ */
+size_t getFrameErrorCount() const;
+
+/**
+ * @brief Gets the largest decoded frame accepted
+ *
+ * @return Maximum frame size in bytes
+ */
+size_t getMaxFrameSize() const;
+
+protected:
+/**
+ * @brief Constructor of the StreamFramer class
+ *
+ * @param serial The port frames are read from and written to
+ * @param max_frame_size Largest decoded frame accepted, in bytes
+ * @param read_chunk_size Bytes requested from the port per read by readFrame()
+ * @throws SerialException if max_frame_size is zero
+ */
+StreamFramer(Serial& serial, size_t max_frame_size, size_t read_chunk_size);
+
+/**
+ * @brief Decodes bytes until a frame completes or the input runs out
+ *
+ * On completion frame_ holds the frame; the caller consumes it and then
+ * calls resetFrame().
+ *
+ * @param data Pointer to the encoded bytes
+ * @param size Number of bytes
+ * @param frame_done Set to true when frame_ holds a complete frame
+ * @return Number of bytes consumed
+ */
+virtual size_t decode(const uint8_t* data, size_t size, bool* frame_done) = 0;
+
+/**
+ * @brief Starts decoding a new frame
+ *
+ * Overrides must call the base implementation.
+ */
+virtual void resetFrame();
+
+/**
+ * @brief Checks whether decode() can make progress without new input
+ *
+ * Codecs that keep received bytes across frames (e.g. to resynchronize)
+ * return true while those bytes may still hold a complete frame.
+ *
+ * @return false by default
+ */
+virtual bool hasPendingInput() const;
+
+/**
+ * @brief Appends decoded bytes to the frame
+ *
+ * @return false, leaving the frame untouched, if it would exceed the maximum size
+ */
+bool append(const uint8_t* data, size_t size) {
+  if (size > max_frame_size_ - frame_size_) {
+    return false;
+  }
+  std::copy(data, data + size, frame_.data() + frame_size_);
+  frame_size_ += size;
+  return true;
+}
+
+/**
+ * @brief Counts a dropped frame and reports it to the error callback
+ *
+ * @param message Description of the error
+ */
+void reportFrameError(const std::string& message);
+
+/**
+ * @brief The port frames are read from and written to
+ */
+Serial& serial_;
+
+/**
+ * @brief Largest decoded frame accepted
+ */
+size_t max_frame_size_;
+
+/**
+ * @brief Decoded bytes of the current frame, max_frame_size_ long
+ */
+std::vector<uint8_t> frame_;
+
+/**
+ * @brief Offset of the decoded frame in frame_
+ */
+size_t frame_begin_{0};
+
+/**
+ * @brief Number of valid bytes in frame_, from frame_begin_
+ */
+size_t frame_size_{0};
+
+private:
+/**
+ * @brief Reads until frame_ holds a complete frame
+ *
+ * @throws IOException if reading fails or times out
+ */
+void readNextFrame();
+
+/**
+ * @brief Encoded bytes read by readFrame() and not decoded yet
+ */
+std::vector<uint8_t> rx_chunk_;
+size_t rx_begin_{0};
+size_t rx_end_{0};
+
+/**
+ * @brief Frame and error callbacks
+ */
+std::function<void(const char*, size_t)> on_frame_;
+std::function<void(const FramingException&)> on_frame_error_;
+
+/**
+ * @brief Number of frames dropped as malformed
+ */
+size_t frame_errors_{0};
+};
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_STREAM_FRAMER_HPP_
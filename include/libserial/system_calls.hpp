@@ -0,0 +1,78 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_SYSTEM_CALLS_HPP_
+#define INCLUDE_LIBSERIAL_SYSTEM_CALLS_HPP_
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <functional>
+
+namespace libserial {
+
+/**
+ * @brief The POSIX system calls Serial issues on its descriptor
+ *
+ * Static, inline forwarders resolved at compile time: a call through
+ * this policy compiles to the plain libc call, with no indirection and
+ * no per-object state. Tests can still replace read, poll and ioctl on
+ * a given Serial object through SystemCallOverrides.
+ *
+ * @author Nestor Pereira Neto
+ */
+struct PosixSystemCalls {
+static ssize_t read(int fd, void* buffer, size_t size) {
+  return ::read(fd, buffer, size);
+}
+
+static ssize_t readv(int fd, const struct iovec* segments, int count) {
+  return ::readv(fd, segments, count);
+}
+
+static ssize_t write(int fd, const void* data, size_t size) {
+  return ::write(fd, data, size);
+}
+
+static ssize_t writev(int fd, const struct iovec* segments, int count) {
+  return ::writev(fd, segments, count);
+}
+
+static int poll(struct pollfd* fds, nfds_t count, int timeout_ms) {
+  return ::poll(fds, count, timeout_ms);
+}
+
+static int ioctl(int fd, unsigned long request, void* arg) {  // NOLINT
+  return ::ioctl(fd, request, arg);
+}
+
+static int fcntl(int fd, int command, int arg) {
+  return ::fcntl(fd, command, arg);
+}
+};
+
+/**
+ * @brief Replacements for the system calls of one Serial object
+ *
+ * Installed by the test helpers (Serial::setReadSystemFunction() and
+ * friends, compiled in with BUILD_TESTING_ON). Serial holds a pointer to
+ * it in every build, so its layout does not depend on that definition;
+ * production objects keep the pointer null and call PosixSystemCalls.
+ * An empty function falls back to the real call.
+ *
+ * @author Nestor Pereira Neto
+ */
+struct SystemCallOverrides {
+/* *INDENT-OFF* */
+std::function<int(int, unsigned long, void*)> ioctl;  // NOLINT
+/* *INDENT-ON* */
+std::function<int(struct pollfd*, nfds_t, int)> poll;
+std::function<ssize_t(int, void*, size_t)> read;
+};
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_SYSTEM_CALLS_HPP_
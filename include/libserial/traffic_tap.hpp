@@ -0,0 +1,214 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#ifndef INCLUDE_LIBSERIAL_TRAFFIC_TAP_HPP_
+#define INCLUDE_LIBSERIAL_TRAFFIC_TAP_HPP_
+
+#include <sys/uio.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "libserial/capture.hpp"
+
+namespace libserial {
+
+/**
+ * @brief What TrafficTap does with a chunk published while its queue is full
+ */
+enum class TapOverflow {
+  DROP_NEWEST,  ///< Discard the chunk being published; observers see the oldest traffic
+  DROP_OLDEST   ///< Discard the oldest queued chunk; observers see the latest traffic
+};
+
+/**
+ * @brief Counters of a TrafficTap
+ *
+ * @author Nestor Pereira Neto
+ */
+struct TapStats {
+/**
+ * @brief Chunks accepted into the queue
+ */
+uint64_t published{0};
+
+/**
+ * @brief Chunks handed to the observers
+ */
+uint64_t delivered{0};
+
+/**
+ * @brief Chunks discarded because the queue was full, and their bytes
+ */
+uint64_t dropped{0};
+uint64_t dropped_bytes{0};
+};
+
+/**
+ * @brief Hands the traffic of a port to diagnostic observers on a separate thread
+ *
+ * publish() copies a chunk into a bounded queue of reusable slots under
+ * a short lock and returns; it never waits for an observer. A drain
+ * thread takes the queued chunks in batches and calls every observer
+ * with each of them, in publication order. When the queue is full the
+ * TapOverflow policy decides which chunk is lost, and the loss is
+ * counted in getStats(), so a slow observer costs data, not latency.
+ *
+ * Slots keep their memory once grown, so a warm tap does not allocate.
+ * Observers run on the drain thread and must not throw.
+ *
+ * @author Nestor Pereira Neto
+ */
+class TrafficTap {
+public:
+/**
+ * @brief Callable invoked with every chunk
+ */
+using Observer = std::function<void(const CaptureRecord&)>;
+
+/**
+ * @brief Default number of queue slots
+ */
+static constexpr size_t kDefaultQueueSize = 1024;
+
+/**
+ * @brief Constructor of the TrafficTap class; starts the drain thread
+ *
+ * @param queue_size Most chunks waiting for the observers
+ * @param overflow What to drop when queue_size chunks are waiting
+ * @throws SerialException if queue_size is zero
+ */
+explicit TrafficTap(size_t queue_size = kDefaultQueueSize,
+                    TapOverflow overflow = TapOverflow::DROP_NEWEST);
+
+/**
+ * @brief Destructor; delivers the queued chunks and joins the drain thread
+ */
+~TrafficTap();
+
+TrafficTap(const TrafficTap&) = delete;
+TrafficTap& operator=(const TrafficTap&) = delete;
+
+/**
+ * @brief Registers an observer
+ *
+ * The observer sees every chunk delivered after this returns, which may
+ * include chunks queued shortly before.
+ *
+ * @param observer Callable invoked as observer(const CaptureRecord& chunk)
+ * @return Id to pass to removeObserver()
+ */
+int addObserver(Observer observer);
+
+/**
+ * @brief Unregisters an observer
+ *
+ * Once this returns the observer is not called again. Unknown ids are
+ * ignored.
+ *
+ * @param id Id returned by addObserver()
+ * @throws SerialException if called from an observer
+ */
+void removeObserver(int id);
+
+/**
+ * @brief Queues a chunk for the observers, timestamped now
+ *
+ * @param direction Whether the bytes were received or transmitted
+ * @param data Pointer to the bytes
+ * @param size Number of bytes
+ */
+void publish(CaptureDirection direction, const void* data, size_t size);
+
+/**
+ * @brief Queues the first size bytes of a segment list as one chunk
+ *
+ * @param direction Whether the bytes were received or transmitted
+ * @param segments Segments of a readv() or writev() call
+ * @param count Number of entries in segments
+ * @param size Bytes moved by the call, at most the sum of the segment lengths
+ */
+void publish(CaptureDirection direction, const struct iovec* segments, int count, size_t size);
+
+/**
+ * @brief Waits until every chunk queued so far has been delivered or dropped
+ *
+ * @throws SerialException if called from an observer
+ */
+void flush();
+
+/**
+ * @brief Gets the counters of the tap
+ *
+ * @return Snapshot of the counters
+ */
+TapStats getStats() const;
+
+/**
+ * @brief Gets the number of queue slots
+ *
+ * @return The queue size passed to the constructor
+ */
+size_t getQueueSize() const;
+
+/**
+ * @brief Gets the overflow policy
+ *
+ * @return The policy passed to the constructor
+ */
+TapOverflow getOverflow() const;
+
+private:
+/**
+ * @brief Body of the drain thread
+ */
+void drainLoop();
+
+/**
+ * @brief Claims the slot for a new chunk, applying the overflow policy; mutex_ must be held
+ *
+ * @param direction Whether the bytes were received or transmitted
+ * @param size Size of the chunk
+ * @return The slot to fill, nullptr when the chunk is dropped
+ */
+CaptureRecord* claimSlot(CaptureDirection direction, size_t size);
+
+/**
+ * @brief Marks the claimed slot as queued and wakes the drain thread
+ *
+ * @param lock Lock of mutex_, released before signaling
+ */
+void commitSlot(std::unique_lock<std::mutex>& lock);
+
+TapOverflow overflow_;
+
+mutable std::mutex mutex_;
+std::condition_variable queued_cv_;
+std::condition_variable drained_cv_;
+std::vector<CaptureRecord> slots_;  ///< Circular queue of chunks
+size_t head_{0};                    ///< Slot of the oldest queued chunk
+size_t count_{0};                   ///< Queued chunks
+uint64_t retired_{0};               ///< Published chunks delivered or dropped from the queue
+TapStats stats_;
+bool stop_{false};
+
+/**
+ * @brief Registered observers, guarded by observers_mutex_
+ *
+ * Held by the drain thread while it delivers a batch.
+ */
+std::mutex observers_mutex_;
+std::vector<std::pair<int, Observer>> observers_;
+int next_observer_id_{0};
+
+std::thread thread_;
+};
+
+}  // namespace libserial
+
+#endif  // INCLUDE_LIBSERIAL_TRAFFIC_TAP_HPP_
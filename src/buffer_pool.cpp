@@ -0,0 +1,134 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/buffer_pool.hpp"
+
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace libserial {
+
+namespace {
+
+constexpr size_t kMinSlabShift = 8;  // log2(BufferPool::kMinSlabSize)
+constexpr size_t kSizeClasses = 9;   // kMinSlabSize up to kMaxSlabSize
+
+static_assert((BufferPool::kMinSlabSize << (kSizeClasses - 1)) == BufferPool::kMaxSlabSize,
+              "Size classes must span kMinSlabSize to kMaxSlabSize");
+
+// Index of the size class holding capacity; capacity <= kMaxSlabSize
+size_t sizeClass(size_t capacity) {
+  size_t index = 0;
+  while ((BufferPool::kMinSlabSize << index) < capacity) {
+    ++index;
+  }
+  return index;
+}
+
+// Set once the free lists of this thread are gone, for buffers
+// released later on by destructors of static objects
+thread_local bool lists_destroyed = false;
+
+// Free slabs of one thread, freed when the thread exits
+struct FreeLists {
+  std::array<std::vector<char*>, kSizeClasses> slabs;
+
+  FreeLists() {
+    // Reserve up front so releasing a slab never allocates
+    for (auto& list : slabs) {
+      list.reserve(BufferPool::kMaxCachedSlabs);
+    }
+  }
+
+  ~FreeLists() {
+    clear();
+    lists_destroyed = true;
+  }
+
+  void clear() {
+    for (auto& list : slabs) {
+      for (char* data : list) {
+        delete[] data;
+      }
+      list.clear();
+    }
+  }
+};
+
+FreeLists& freeLists() {
+  thread_local FreeLists lists;
+  return lists;
+}
+
+}  // namespace
+
+PooledBuffer BufferPool::acquire(size_t capacity) {
+  if (capacity > kMaxSlabSize) {
+    return PooledBuffer(new char[capacity], capacity);
+  }
+
+  size_t index = sizeClass(capacity);
+  size_t slab_size = kMinSlabSize << index;
+  auto& list = freeLists().slabs[index];
+  if (list.empty()) {
+    // Default-initialized: the slab is not zero-filled
+    return PooledBuffer(new char[slab_size], slab_size);
+  }
+
+  char* data = list.back();
+  list.pop_back();
+  return PooledBuffer(data, slab_size);
+}
+
+size_t BufferPool::getCachedCount(size_t capacity) {
+  if (capacity > kMaxSlabSize) {
+    return 0;
+  }
+  return freeLists().slabs[sizeClass(capacity)].size();
+}
+
+void BufferPool::trim() {
+  freeLists().clear();
+}
+
+void BufferPool::release(char* data, size_t capacity) {
+  if (capacity <= kMaxSlabSize && !lists_destroyed) {
+    auto& list = freeLists().slabs[sizeClass(capacity)];
+    if (list.size() < kMaxCachedSlabs) {
+      list.push_back(data);
+      return;
+    }
+  }
+  delete[] data;
+}
+
+PooledBuffer::~PooledBuffer() {
+  this->reset();
+}
+
+PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept
+  : data_(std::exchange(other.data_, nullptr)),
+  size_(std::exchange(other.size_, 0)),
+  capacity_(std::exchange(other.capacity_, 0)) {
+}
+
+PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept {
+  if (this != &other) {
+    this->reset();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+  }
+  return *this;
+}
+
+void PooledBuffer::reset() {
+  if (data_) {
+    BufferPool::release(data_, capacity_);
+    data_ = nullptr;
+  }
+  size_ = 0;
+  capacity_ = 0;
+}
+
+}  // namespace libserial
@@ -0,0 +1,164 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/byte_scan.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace libserial {
+
+namespace {
+
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+#if defined(__x86_64__)
+const char* findByteSse2(const char* p, size_t size, char byte) {
+  if (size < 16) {
+    return findByteScalar(p, size, byte);
+  }
+  const __m128i needle = _mm_set1_epi8(byte);
+  const char* last = p + size - 16;
+  while (true) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+    if (mask != 0) {
+      return p + __builtin_ctz(static_cast<unsigned int>(mask));
+    }
+    if (p == last) {
+      return nullptr;
+    }
+    // The final load overlaps bytes already known not to match
+    p = p + 16 < last ? p + 16 : last;
+  }
+}
+
+__attribute__((target("avx2")))
+uint32_t matchMask(const char* p, __m256i needle) {
+  __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+}
+
+__attribute__((target("avx2")))
+const char* findByteAvx2(const char* p, size_t size, char byte) {
+  if (size < 32) {
+    return findByteSse2(p, size, byte);
+  }
+  const __m256i needle = _mm256_set1_epi8(byte);
+
+  // Short lines usually end within the first vector
+  uint32_t mask = matchMask(p, needle);
+  if (mask != 0) {
+    return p + __builtin_ctz(mask);
+  }
+  const char* end = p + size;
+
+  // Continue from the next 32-byte boundary, rescanning a few checked bytes
+  p = reinterpret_cast<const char*>((reinterpret_cast<uintptr_t>(p) + 32) &
+                                    ~static_cast<uintptr_t>(31));
+
+  // Four vectors per iteration, with a single branch on the combined result
+  while (end - p >= 128) {
+    const __m256i* v = reinterpret_cast<const __m256i*>(p);
+    __m256i m0 = _mm256_cmpeq_epi8(_mm256_load_si256(v), needle);
+    __m256i m1 = _mm256_cmpeq_epi8(_mm256_load_si256(v + 1), needle);
+    __m256i m2 = _mm256_cmpeq_epi8(_mm256_load_si256(v + 2), needle);
+    __m256i m3 = _mm256_cmpeq_epi8(_mm256_load_si256(v + 3), needle);
+    __m256i any = _mm256_or_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m2, m3));
+    if (!_mm256_testz_si256(any, any)) {
+      uint64_t low = static_cast<uint32_t>(_mm256_movemask_epi8(m0)) |
+                     static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(m1))) << 32;
+      if (low != 0) {
+        return p + __builtin_ctzll(low);
+      }
+      uint64_t high = static_cast<uint32_t>(_mm256_movemask_epi8(m2)) |
+                      static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(m3))) << 32;
+      return p + 64 + __builtin_ctzll(high);
+    }
+    p += 128;
+  }
+  while (end - p >= 32) {
+    mask = matchMask(p, needle);
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 32;
+  }
+  if (p == end) {
+    return nullptr;
+  }
+
+  // The final load overlaps bytes already known not to match
+  p = end - 32;
+  mask = matchMask(p, needle);
+  return mask != 0 ? p + __builtin_ctz(mask) : nullptr;
+}
+
+using FindFunction = const char* (*)(const char*, size_t, char);
+
+FindFunction selectFindByte() {
+  return __builtin_cpu_supports("avx2") ? findByteAvx2 : findByteSse2;
+}
+#endif
+
+}  // namespace
+
+const char* findByteScalar(const char* p, size_t size, char byte) {
+  const uint64_t pattern = kOnes * static_cast<uint8_t>(byte);
+  while (size >= 8) {
+    uint64_t word;
+    std::memcpy(&word, p, 8);
+    word ^= pattern;
+    // Sets the high bit of each zero byte; the lowest one is always exact
+    uint64_t zero = (word - kOnes) & ~word & kHighBits;
+    if (zero != 0) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      return p + (__builtin_ctzll(zero) >> 3);
+#else
+      break;
+#endif
+    }
+    p += 8;
+    size -= 8;
+  }
+  for (size_t i = 0; i < size; ++i) {
+    if (p[i] == byte) {
+      return p + i;
+    }
+  }
+  return nullptr;
+}
+
+const char* findByte(const char* data, size_t size, char byte) {
+#if defined(__x86_64__)
+  static const FindFunction find = selectFindByte();
+  return find(data, size, byte);
+#else
+  return findByteScalar(data, size, byte);
+#endif
+}
+
+const char* findSequence(const char* data, size_t size, std::string_view sequence) {
+  const size_t length = sequence.size();
+  if (length == 0 || length > size) {
+    return nullptr;
+  }
+
+  const char last = sequence[length - 1];
+  const char* end = data + size;
+  const char* p = data + length - 1;
+  while (const char* candidate = findByte(p, static_cast<size_t>(end - p), last)) {
+    const char* match = candidate - (length - 1);
+    if (std::memcmp(match, sequence.data(), length - 1) == 0) {
+      return match;
+    }
+    p = candidate + 1;
+  }
+  return nullptr;
+}
+
+}  // namespace libserial
@@ -0,0 +1,356 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/capture.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <asm/termbits.h>
+#include <sys/ioctl.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "libserial/serial_exception.hpp"
+
+namespace libserial {
+
+namespace {
+
+constexpr size_t kMagicSize = sizeof(kCaptureMagic) - 1;
+constexpr size_t kRecordHeaderSize = 13;
+constexpr size_t kReadChunk = 4096;
+
+void putLittleEndian(char* out, uint64_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+  }
+}
+
+uint64_t getLittleEndian(const char* in, size_t bytes) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < bytes; ++i) {
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+  }
+  return value;
+}
+
+// Writes everything, retrying short writes and EINTR; returns 0 or errno
+int writeAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    ssize_t result = ::write(fd, data, size);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return errno;
+    }
+    data += result;
+    size -= static_cast<size_t>(result);
+  }
+  return 0;
+}
+
+}  // namespace
+
+CaptureWriter::CaptureWriter(const std::string& path, size_t max_pending)
+  : path_(path), max_pending_(max_pending), wake_size_(max_pending / 4) {
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    throw SerialException("Error opening capture file " + path + ": " + strerror(errno));
+  }
+
+  // New files get the magic; existing ones must already carry it
+  char magic[kMagicSize];
+  ssize_t header = ::pread(fd_, magic, kMagicSize, 0);
+  int error = 0;
+  if (header == 0) {
+    error = writeAll(fd_, kCaptureMagic, kMagicSize);
+  }
+  else if (header != static_cast<ssize_t>(kMagicSize) ||
+           memcmp(magic, kCaptureMagic, kMagicSize) != 0) {
+    ::close(fd_);
+    throw SerialException("Not a capture file: " + path);
+  }
+  if (error != 0) {
+    ::close(fd_);
+    throw SerialException("Error writing capture file " + path + ": " + strerror(error));
+  }
+
+  pending_.reserve(max_pending_);
+  thread_ = std::thread(&CaptureWriter::writerLoop, this);
+}
+
+CaptureWriter::~CaptureWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  pending_cv_.notify_one();
+  thread_.join();
+  ::close(fd_);
+}
+
+void CaptureWriter::record(CaptureDirection direction, const void* data, size_t size) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  size_t before = pending_.size();
+  if (!this->appendHeader(direction, size)) {
+    return;
+  }
+  const char* bytes = static_cast<const char*>(data);
+  pending_.insert(pending_.end(), bytes, bytes + size);
+  this->finishRecord(lock, before);
+}
+
+void CaptureWriter::record(CaptureDirection direction, const struct iovec* segments, int count,
+                           size_t size) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  size_t before = pending_.size();
+  if (!this->appendHeader(direction, size)) {
+    return;
+  }
+  size_t left = size;
+  for (int i = 0; i < count && left > 0; ++i) {
+    const char* bytes = static_cast<const char*>(segments[i].iov_base);
+    size_t take = std::min(left, segments[i].iov_len);
+    pending_.insert(pending_.end(), bytes, bytes + take);
+    left -= take;
+  }
+  this->finishRecord(lock, before);
+}
+
+bool CaptureWriter::appendHeader(CaptureDirection direction, size_t size) {
+  if (pending_.size() + kRecordHeaderSize + size > max_pending_ || size > UINT32_MAX) {
+    dropped_++;
+    return false;
+  }
+
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  char header[kRecordHeaderSize];
+  putLittleEndian(header, static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()), 8);
+  putLittleEndian(header + 8, size, 4);
+  header[12] = static_cast<char>(direction);
+  pending_.insert(pending_.end(), header, header + kRecordHeaderSize);
+  return true;
+}
+
+void CaptureWriter::finishRecord(std::unique_lock<std::mutex>& lock, size_t before) {
+  size_t after = pending_.size();
+  appended_ += after - before;
+  lock.unlock();
+  if (before == 0 || (before < wake_size_ && after >= wake_size_)) {
+    pending_cv_.notify_one();
+  }
+}
+
+void CaptureWriter::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  uint64_t target = appended_;
+  flush_requested_ = true;
+  pending_cv_.notify_one();
+  written_cv_.wait(lock, [this, target]() {
+      return written_ >= target || write_error_ != 0;
+    });
+  if (write_error_ != 0) {
+    throw SerialException("Error writing capture file " + path_ + ": " +
+                          strerror(write_error_));
+  }
+}
+
+uint64_t CaptureWriter::getDroppedRecords() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropped_;
+}
+
+const std::string& CaptureWriter::getPath() const {
+  return path_;
+}
+
+void CaptureWriter::writerLoop() {
+  std::vector<char> batch;
+  batch.reserve(max_pending_);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    pending_cv_.wait(lock, [this]() {
+        return stop_ || !pending_.empty();
+      });
+    if (pending_.empty()) {
+      return;  // stop_ with nothing left
+    }
+
+    // Let the batch grow before paying for a write
+    pending_cv_.wait_for(lock, kBatchInterval, [this]() {
+        return stop_ || flush_requested_ || pending_.size() >= wake_size_;
+      });
+
+    // Take the whole batch and write it without holding the lock
+    flush_requested_ = false;
+    batch.swap(pending_);
+    lock.unlock();
+    int error = write_error_ == 0 ? writeAll(fd_, batch.data(), batch.size()) : write_error_;
+    size_t batch_size = batch.size();
+    batch.clear();
+    lock.lock();
+
+    written_ += batch_size;
+    write_error_ = error;
+    written_cv_.notify_all();
+  }
+}
+
+CaptureReader::CaptureReader(const std::string& path)
+  : file_(path, std::ios::binary) {
+  if (!file_) {
+    throw SerialException("Error opening capture file " + path + ": " + strerror(errno));
+  }
+
+  char magic[kMagicSize];
+  if (!file_.read(magic, kMagicSize) || memcmp(magic, kCaptureMagic, kMagicSize) != 0) {
+    throw SerialException("Not a capture file: " + path);
+  }
+}
+
+bool CaptureReader::next(CaptureRecord& record) {
+  char header[kRecordHeaderSize];
+  if (!file_.read(header, kRecordHeaderSize)) {
+    return false;
+  }
+
+  size_t size = static_cast<size_t>(getLittleEndian(header + 8, 4));
+  record.timestamp = std::chrono::nanoseconds(static_cast<int64_t>(getLittleEndian(header, 8)));
+  record.direction = static_cast<CaptureDirection>(header[12]);
+  record.data.resize(size);
+  return static_cast<bool>(file_.read(record.data.data(), static_cast<std::streamsize>(size)));
+}
+
+CaptureReplayer::CaptureReplayer() {
+  master_fd_ = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+  if (master_fd_ < 0 || grantpt(master_fd_) != 0 || unlockpt(master_fd_) != 0) {
+    int error = errno;
+    if (master_fd_ >= 0) {
+      ::close(master_fd_);
+    }
+    throw SerialException("Error creating pseudo-terminal: " + std::string(strerror(error)));
+  }
+  port_name_ = ptsname(master_fd_);
+
+  // Keep the slave open so the master never sees a hangup between the
+  // port under test closing and reopening it, and make the line raw so
+  // replayed bytes arrive unchanged
+  slave_fd_ = ::open(port_name_.c_str(), O_RDWR | O_NOCTTY | O_CLOEXEC);
+  struct termios2 tty;
+  if (slave_fd_ < 0 || ioctl(slave_fd_, TCGETS2, &tty) != 0) {
+    int error = errno;
+    if (slave_fd_ >= 0) {
+      ::close(slave_fd_);
+    }
+    ::close(master_fd_);
+    throw SerialException("Error opening pseudo-terminal " + port_name_ + ": " + strerror(error));
+  }
+  tty.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
+  tty.c_oflag &= ~OPOST;
+  tty.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+  ioctl(slave_fd_, TCSETS2, &tty);
+
+  fcntl(master_fd_, F_SETFL, fcntl(master_fd_, F_GETFL) | O_NONBLOCK);
+}
+
+CaptureReplayer::~CaptureReplayer() {
+  if (slave_fd_ >= 0) {
+    ::close(slave_fd_);
+    slave_fd_ = -1;
+  }
+  if (master_fd_ >= 0) {
+    ::close(master_fd_);
+    master_fd_ = -1;
+  }
+}
+
+const std::string& CaptureReplayer::getPortName() const {
+  return port_name_;
+}
+
+size_t CaptureReplayer::replay(const std::string& path, ReplayTiming timing) {
+  CaptureReader reader(path);
+  CaptureRecord record;
+  size_t bytes_written = 0;
+
+  bool first = true;
+  std::chrono::nanoseconds first_timestamp{0};
+  auto start = std::chrono::steady_clock::now();
+
+  while (reader.next(record)) {
+    if (record.direction != CaptureDirection::RX) {
+      continue;
+    }
+    if (first) {
+      first_timestamp = record.timestamp;
+      first = false;
+    }
+    if (timing == ReplayTiming::ORIGINAL) {
+      this->drainUntil(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                         record.timestamp - first_timestamp));
+    }
+    this->writeChunk(record.data.data(), record.data.size());
+    bytes_written += record.data.size();
+  }
+  return bytes_written;
+}
+
+void CaptureReplayer::writeChunk(const char* data, size_t size) {
+  char sink[kReadChunk];
+  while (size > 0) {
+    struct pollfd pfd;
+    pfd.fd = master_fd_;
+    pfd.events = POLLIN | POLLOUT;
+    if (poll(&pfd, 1, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw SerialException("Error in poll(): " + std::string(strerror(errno)));
+    }
+
+    if (pfd.revents & POLLIN) {
+      while (::read(master_fd_, sink, sizeof(sink)) > 0) {
+      }
+    }
+    if (pfd.revents & POLLOUT) {
+      ssize_t result = ::write(master_fd_, data, size);
+      if (result > 0) {
+        data += result;
+        size -= static_cast<size_t>(result);
+      }
+      else if (result < 0 && errno != EAGAIN && errno != EINTR) {
+        throw SerialException("Error writing to pseudo-terminal: " +
+                              std::string(strerror(errno)));
+      }
+    }
+  }
+}
+
+void CaptureReplayer::drainUntil(std::chrono::steady_clock::time_point deadline) {
+  char sink[kReadChunk];
+  while (true) {
+    auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+      deadline - std::chrono::steady_clock::now()).count();
+    if (remaining <= 0) {
+      return;
+    }
+
+    struct pollfd pfd;
+    pfd.fd = master_fd_;
+    pfd.events = POLLIN;
+    int pr = poll(&pfd, 1, static_cast<int>(remaining));
+    if (pr > 0 && (pfd.revents & POLLIN)) {
+      while (::read(master_fd_, sink, sizeof(sink)) > 0) {
+      }
+    }
+  }
+}
+
+}  // namespace libserial
@@ -0,0 +1,163 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/cobs.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "libserial/serial.hpp"
+
+namespace libserial {
+
+namespace {
+
+// Longest run of non-zero bytes a single code byte can describe
+constexpr size_t kMaxRun = 254;
+
+constexpr uint8_t kDelimiter = 0x00;
+
+}  // namespace
+
+CobsFramer::CobsFramer(Serial& serial, size_t max_frame_size)
+  : StreamFramer(serial, max_frame_size,
+                 std::min(getMaxEncodedSize(max_frame_size), kDefaultMaxFrameSize)) {
+}
+
+size_t CobsFramer::getMaxEncodedSize(size_t size) {
+  // One code byte per started block of 254, plus the delimiter
+  return size + size / kMaxRun + 2;
+}
+
+size_t CobsFramer::writeFrame(const void* data, size_t size) {
+  if (!data && size > 0) {
+    throw IOException("Null pointer passed to writeFrame function");
+  }
+
+  const uint8_t* payload = static_cast<const uint8_t*>(data);
+  codes_.clear();
+  segments_.clear();
+
+  // Each block is a code byte followed by a slice of the caller's payload;
+  // the zero ending the block is implied by the code and never sent
+  size_t pos = 0;
+  while (true) {
+    size_t limit = std::min(size - pos, kMaxRun);
+    const void* zero = limit > 0 ? std::memchr(payload + pos, 0, limit) : nullptr;
+    size_t run = zero ? static_cast<size_t>(static_cast<const uint8_t*>(zero) - (payload + pos)) :
+                 limit;
+
+    codes_.push_back(static_cast<uint8_t>(run == kMaxRun ? 0xFF : run + 1));
+    segments_.push_back({nullptr, 1});
+    segments_.push_back({const_cast<uint8_t*>(payload + pos), run});
+
+    if (run == kMaxRun) {
+      pos += run;
+      if (pos == size) {
+        break;
+      }
+      continue;
+    }
+    if (pos + run == size) {
+      break;
+    }
+    pos += run + 1;
+  }
+
+  // codes_ is complete, so its storage no longer moves
+  for (size_t i = 0; i < codes_.size(); ++i) {
+    segments_[2 * i].iov_base = &codes_[i];
+  }
+  segments_.push_back({const_cast<uint8_t*>(&kDelimiter), 1});
+
+  return serial_.writev(segments_.data(), segments_.size());
+}
+
+size_t CobsFramer::decode(const uint8_t* data, size_t size, bool* frame_done) {
+  size_t pos = 0;
+  while (pos < size) {
+    if (discarding_) {
+      const void* zero = std::memchr(data + pos, kDelimiter, size - pos);
+      if (!zero) {
+        return size;
+      }
+      pos = static_cast<size_t>(static_cast<const uint8_t*>(zero) - data) + 1;
+      discarding_ = false;
+      this->resetFrame();
+      continue;
+    }
+
+    // Inside a block: copy the run in one go, stopping at a stray delimiter
+    if (block_left_ > 0) {
+      size_t run = std::min(block_left_, size - pos);
+      const void* zero = std::memchr(data + pos, kDelimiter, run);
+      if (zero) {
+        run = static_cast<size_t>(static_cast<const uint8_t*>(zero) - (data + pos));
+      }
+      if (!this->appendOrDrop(data + pos, run)) {
+        continue;
+      }
+      pos += run;
+      block_left_ -= run;
+      if (zero) {
+        // The delimiter starts the next frame, so nothing more is skipped
+        pos++;
+        this->dropFrame("COBS frame truncated: delimiter inside a block", false);
+        continue;
+      }
+      if (block_left_ == 0) {
+        pending_zero_ = !full_block_;
+      }
+      continue;
+    }
+
+    uint8_t code = data[pos++];
+    if (code == kDelimiter) {
+      if (in_frame_) {
+        *frame_done = true;
+        return pos;
+      }
+      // Back-to-back delimiters are idle fill, not empty frames
+      continue;
+    }
+
+    if (pending_zero_) {
+      pending_zero_ = false;
+      if (!this->appendOrDrop(&kDelimiter, 1)) {
+        continue;
+      }
+    }
+    in_frame_ = true;
+    full_block_ = code == 0xFF;
+    block_left_ = code - 1;
+    if (block_left_ == 0) {
+      pending_zero_ = !full_block_;
+    }
+  }
+  return pos;
+}
+
+bool CobsFramer::appendOrDrop(const uint8_t* data, size_t size) {
+  if (!this->append(data, size)) {
+    this->dropFrame("COBS frame exceeds maximum size of " + std::to_string(max_frame_size_) +
+                    " bytes", true);
+    return false;
+  }
+  return true;
+}
+
+void CobsFramer::dropFrame(const std::string& message, bool skip_to_delimiter) {
+  this->resetFrame();
+  discarding_ = skip_to_delimiter;
+  this->reportFrameError(message);
+}
+
+void CobsFramer::resetFrame() {
+  StreamFramer::resetFrame();
+  block_left_ = 0;
+  pending_zero_ = false;
+  full_block_ = false;
+  in_frame_ = false;
+}
+
+}  // namespace libserial
@@ -0,0 +1,171 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/crc.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace libserial {
+
+namespace {
+
+using SliceTables = std::array<std::array<uint32_t, 256>, 8>;
+
+// tables[0] is the classic byte-wise table of the reflected polynomial;
+// tables[k][n] advances the CRC of byte n by k further zero bytes
+constexpr SliceTables makeSliceTables(uint32_t polynomial) {
+  SliceTables tables{};
+  for (uint32_t n = 0; n < 256; ++n) {
+    uint32_t crc = n;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+    }
+    tables[0][n] = crc;
+  }
+  for (uint32_t n = 0; n < 256; ++n) {
+    for (size_t k = 1; k < 8; ++k) {
+      uint32_t previous = tables[k - 1][n];
+      tables[k][n] = (previous >> 8) ^ tables[0][previous & 0xFF];
+    }
+  }
+  return tables;
+}
+
+constexpr std::array<uint16_t, 256> makeCrc16Table() {
+  std::array<uint16_t, 256> table{};
+  for (uint32_t n = 0; n < 256; ++n) {
+    uint16_t crc = static_cast<uint16_t>(n << 8);
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+    }
+    table[n] = crc;
+  }
+  return table;
+}
+
+constexpr SliceTables kCrc32Tables = makeSliceTables(0xEDB88320);
+constexpr SliceTables kCrc32cTables = makeSliceTables(0x82F63B78);
+constexpr std::array<uint16_t, 256> kCrc16Table = makeCrc16Table();
+
+// Operates on the inverted register; callers do the pre- and post-inversion
+uint32_t sliceBy8(const SliceTables& t, const uint8_t* p, size_t size, uint32_t crc) {
+  // Byte-wise until the pointer is 8-byte aligned
+  while (size > 0 && (reinterpret_cast<uintptr_t>(p) & 7) != 0) {
+    crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    size--;
+  }
+
+  while (size >= 8) {
+    uint32_t low;
+    uint32_t high;
+    std::memcpy(&low, p, 4);
+    std::memcpy(&high, p + 4, 4);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    low = __builtin_bswap32(low);
+    high = __builtin_bswap32(high);
+#endif
+    low ^= crc;
+    crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^
+          t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+          t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^
+          t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+    p += 8;
+    size -= 8;
+  }
+
+  while (size > 0) {
+    crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    size--;
+  }
+  return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2")))
+uint32_t crc32cSse42(const uint8_t* p, size_t size, uint32_t crc) {
+  while (size > 0 && (reinterpret_cast<uintptr_t>(p) & 7) != 0) {
+    crc = _mm_crc32_u8(crc, *p++);
+    size--;
+  }
+  uint64_t crc64 = crc;
+  while (size >= 8) {
+    uint64_t word;
+    std::memcpy(&word, p, 8);
+    crc64 = _mm_crc32_u64(crc64, word);
+    p += 8;
+    size -= 8;
+  }
+  crc = static_cast<uint32_t>(crc64);
+  while (size > 0) {
+    crc = _mm_crc32_u8(crc, *p++);
+    size--;
+  }
+  return crc;
+}
+
+bool hasSse42() {
+  static const bool supported = __builtin_cpu_supports("sse4.2");
+  return supported;
+}
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+// castagnoli selects CRC32C* over CRC32* instructions
+uint32_t crc32Arm(const uint8_t* p, size_t size, uint32_t crc, bool castagnoli) {
+  while (size >= 8) {
+    uint64_t word;
+    std::memcpy(&word, p, 8);
+    crc = castagnoli ? __crc32cd(crc, word) : __crc32d(crc, word);
+    p += 8;
+    size -= 8;
+  }
+  while (size > 0) {
+    crc = castagnoli ? __crc32cb(crc, *p) : __crc32b(crc, *p);
+    p++;
+    size--;
+  }
+  return crc;
+}
+#endif
+
+}  // namespace
+
+uint16_t crc16Ccitt(const void* data, size_t size, uint16_t crc) {
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    crc = static_cast<uint16_t>((crc << 8) ^ kCrc16Table[((crc >> 8) ^ p[i]) & 0xFF]);
+  }
+  return crc;
+}
+
+uint32_t crc32(const void* data, size_t size, uint32_t crc) {
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+  return ~crc32Arm(p, size, ~crc, false);
+#else
+  // The x86 CRC32 instruction only implements the Castagnoli polynomial
+  return ~sliceBy8(kCrc32Tables, p, size, ~crc);
+#endif
+}
+
+uint32_t crc32c(const void* data, size_t size, uint32_t crc) {
+  const uint8_t* p = static_cast<const uint8_t*>(data);
+#if defined(__x86_64__)
+  if (hasSse42()) {
+    return ~crc32cSse42(p, size, ~crc);
+  }
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+  return ~crc32Arm(p, size, ~crc, true);
+#endif
+  return ~sliceBy8(kCrc32cTables, p, size, ~crc);
+}
+
+}  // namespace libserial
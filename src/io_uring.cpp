@@ -0,0 +1,188 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/io_uring.hpp"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include <algorithm>
+#include <string>
+
+#include "libserial/serial_exception.hpp"
+
+namespace libserial {
+
+std::function<int(unsigned int, struct io_uring_params*)> IoUring::defaultSetup() {
+  return [](unsigned int entries, struct io_uring_params* params) {
+           return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+         };
+}
+
+std::function<int(unsigned int, struct io_uring_params*)> IoUring::setup_ =
+  IoUring::defaultSetup();
+
+IoUring::IoUring(unsigned int entries) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+
+  ring_fd_ = setup_(entries, &params);
+  if (ring_fd_ < 0) {
+    throw SerialException("Error in io_uring_setup(): " + std::string(strerror(errno)));
+  }
+  if (!(params.features & IORING_FEAT_EXT_ARG)) {
+    this->release();
+    throw SerialException("io_uring is too old: IORING_FEAT_EXT_ARG is required");
+  }
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED) {
+    sq_ring_ = nullptr;
+    std::string error = strerror(errno);
+    this->release();
+    throw SerialException("Error mapping io_uring submission ring: " + error);
+  }
+
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  }
+  else {
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED) {
+      cq_ring_ = nullptr;
+      std::string error = strerror(errno);
+      this->release();
+      throw SerialException("Error mapping io_uring completion ring: " + error);
+    }
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    std::string error = strerror(errno);
+    this->release();
+    throw SerialException("Error mapping io_uring submission entries: " + error);
+  }
+  sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+  char* sq = static_cast<char*>(sq_ring_);
+  sq_head_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+  sq_entries_ = params.sq_entries;
+  sqe_tail_ = *sq_tail_;
+
+  char* cq = static_cast<char*>(cq_ring_);
+  cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+}
+
+IoUring::~IoUring() noexcept {
+  this->release();
+}
+
+void IoUring::release() {
+  if (sqes_) {
+    munmap(sqes_, sqes_size_);
+    sqes_ = nullptr;
+  }
+  if (cq_ring_ && cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  cq_ring_ = nullptr;
+  if (sq_ring_) {
+    munmap(sq_ring_, sq_ring_size_);
+    sq_ring_ = nullptr;
+  }
+  if (ring_fd_ != -1) {
+    ::close(ring_fd_);
+    ring_fd_ = -1;
+  }
+}
+
+bool IoUring::isSupported() {
+  static const bool supported = []() {
+      try {
+        IoUring probe(2);
+        return true;
+      }
+      catch (const SerialException&) {
+        return false;
+      }
+    }();
+  return supported;
+}
+
+bool IoUring::registerBuffers(const struct iovec* buffers, unsigned int count) {
+  return ::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS,
+                   buffers, count) == 0;
+}
+
+struct io_uring_sqe* IoUring::getSqe() {
+  if (this->getFreeSqes() == 0) {
+    return nullptr;
+  }
+
+  uint32_t index = sqe_tail_ & *sq_mask_;
+  struct io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  sqe_tail_++;
+  return sqe;
+}
+
+unsigned int IoUring::getFreeSqes() const {
+  return sq_entries_ - (sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE));
+}
+
+unsigned int IoUring::submitAndWait(unsigned int min_complete, std::chrono::nanoseconds timeout) {
+  __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+  unsigned int to_submit = sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+
+  unsigned int flags = 0;
+  const void* arg = nullptr;
+  size_t argsz = 0;
+
+  struct __kernel_timespec ts {};
+  struct io_uring_getevents_arg getevents {};
+  if (min_complete > 0) {
+    flags |= IORING_ENTER_GETEVENTS;
+    if (timeout.count() >= 0) {
+      ts.tv_sec = timeout.count() / 1000000000;
+      ts.tv_nsec = timeout.count() % 1000000000;
+      getevents.ts = reinterpret_cast<uint64_t>(&ts);
+      flags |= IORING_ENTER_EXT_ARG;
+      arg = &getevents;
+      argsz = sizeof(getevents);
+    }
+  }
+
+  // Direct system call: this is the hot path of every reactor wakeup
+  int result = static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd_, to_submit,
+                                          min_complete, flags, arg, argsz));
+  if (result < 0) {
+    // Timeouts and signals only end the wait, submissions are not lost
+    if (errno == ETIME || errno == EINTR || errno == EBUSY || errno == EAGAIN) {
+      return 0;
+    }
+    throw SerialException("Error in io_uring_enter(): " + std::string(strerror(errno)));
+  }
+  return static_cast<unsigned int>(result);
+}
+
+}  // namespace libserial
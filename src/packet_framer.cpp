@@ -0,0 +1,190 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/packet_framer.hpp"
+
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "libserial/crc.hpp"
+#include "libserial/serial.hpp"
+
+namespace libserial {
+
+namespace {
+
+size_t crcSize(FrameCheck check) {
+  return check == FrameCheck::CRC16_CCITT ? 2 : 4;
+}
+
+size_t validatedFrameSize(size_t max_frame_size) {
+  if (max_frame_size > PacketFramer::kMaxPayloadSize) {
+    throw SerialException("Maximum frame size of a packet cannot exceed " +
+                          std::to_string(PacketFramer::kMaxPayloadSize) + " bytes");
+  }
+  return max_frame_size;
+}
+
+}  // namespace
+
+PacketFramer::PacketFramer(Serial& serial, FrameCheck check, size_t max_frame_size)
+  : StreamFramer(serial, validatedFrameSize(max_frame_size), kDefaultMaxFrameSize),
+    check_(check), crc_size_(crcSize(check)) {
+  // frame_ holds the raw packet; the payload is delivered from inside it
+  frame_.resize(kHeaderSize + max_frame_size_ + crc_size_);
+}
+
+FrameCheck PacketFramer::getFrameCheck() const {
+  return check_;
+}
+
+uint32_t PacketFramer::checksum(const uint8_t* length_field, const uint8_t* payload,
+                                size_t size) const {
+  switch (check_) {
+    case FrameCheck::CRC16_CCITT:
+      return crc16Ccitt(payload, size, crc16Ccitt(length_field, 2));
+    case FrameCheck::CRC32:
+      return crc32(payload, size, crc32(length_field, 2));
+    case FrameCheck::CRC32C:
+      return crc32c(payload, size, crc32c(length_field, 2));
+  }
+  return 0;
+}
+
+size_t PacketFramer::writeFrame(const void* data, size_t size) {
+  if (!data && size > 0) {
+    throw IOException("Null pointer passed to writeFrame function");
+  }
+  if (size > max_frame_size_) {
+    throw IOException("Frame of " + std::to_string(size) +
+                      " bytes exceeds maximum frame size of " +
+                      std::to_string(max_frame_size_) + " bytes");
+  }
+
+  tx_header_[0] = kSync[0];
+  tx_header_[1] = kSync[1];
+  tx_header_[2] = static_cast<uint8_t>(size & 0xFF);
+  tx_header_[3] = static_cast<uint8_t>(size >> 8);
+
+  uint32_t crc = this->checksum(tx_header_ + 2, static_cast<const uint8_t*>(data), size);
+  const size_t crc_size = std::min(crc_size_, sizeof(tx_crc_));
+  for (size_t i = 0; i < crc_size; ++i) {
+    tx_crc_[i] = static_cast<uint8_t>(crc >> (8 * i));
+  }
+
+  struct iovec segments[3] = {
+    {tx_header_, kHeaderSize},
+    {const_cast<void*>(data), size},
+    {tx_crc_, crc_size_}
+  };
+  return serial_.writev(segments, 3);
+}
+
+size_t PacketFramer::needed() const {
+  if (raw_size_ < kHeaderSize || !header_valid_) {
+    return kHeaderSize;
+  }
+  size_t length = frame_[2] | (static_cast<size_t>(frame_[3]) << 8);
+  return kHeaderSize + length + crc_size_;
+}
+
+bool PacketFramer::hasPendingInput() const {
+  return packet_end_ == 0 && raw_size_ > 0 && raw_size_ >= this->needed();
+}
+
+void PacketFramer::resync() {
+  // Look for the next sync word inside what is already buffered
+  size_t next = 1;
+  while (next < raw_size_) {
+    const void* found = std::memchr(frame_.data() + next, kSync[0], raw_size_ - next);
+    if (!found) {
+      next = raw_size_;
+      break;
+    }
+    next = static_cast<size_t>(static_cast<const uint8_t*>(found) - frame_.data());
+    if (next + 1 == raw_size_ || frame_[next + 1] == kSync[1]) {
+      break;
+    }
+    next++;
+  }
+
+  std::memmove(frame_.data(), frame_.data() + next, raw_size_ - next);
+  raw_size_ -= next;
+  header_valid_ = false;
+}
+
+size_t PacketFramer::decode(const uint8_t* data, size_t size, bool* frame_done) {
+  size_t pos = 0;
+  while (true) {
+    const size_t need = this->needed();
+
+    if (raw_size_ < need) {
+      if (pos == size) {
+        return pos;
+      }
+      // Between packets, skip noise up to the next candidate sync word
+      if (raw_size_ == 0) {
+        const void* found = std::memchr(data + pos, kSync[0], size - pos);
+        if (!found) {
+          return size;
+        }
+        pos = static_cast<size_t>(static_cast<const uint8_t*>(found) - data);
+      }
+      size_t take = std::min(need - raw_size_, size - pos);
+      std::memcpy(frame_.data() + raw_size_, data + pos, take);
+      raw_size_ += take;
+      pos += take;
+      continue;
+    }
+
+    if (!header_valid_) {
+      if (frame_[0] != kSync[0] || frame_[1] != kSync[1]) {
+        this->resync();
+        continue;
+      }
+      size_t length = frame_[2] | (static_cast<size_t>(frame_[3]) << 8);
+      if (length > max_frame_size_) {
+        this->reportFrameError("Packet length of " + std::to_string(length) +
+                               " bytes exceeds maximum frame size of " +
+                               std::to_string(max_frame_size_) + " bytes");
+        this->resync();
+        continue;
+      }
+      header_valid_ = true;
+      continue;
+    }
+
+    const size_t length = need - kHeaderSize - crc_size_;
+    const uint8_t* trailer = frame_.data() + kHeaderSize + length;
+    uint32_t received = 0;
+    for (size_t i = 0; i < crc_size_; ++i) {
+      received |= static_cast<uint32_t>(trailer[i]) << (8 * i);
+    }
+    if (received != this->checksum(frame_.data() + 2, frame_.data() + kHeaderSize, length)) {
+      this->reportFrameError("Packet CRC mismatch");
+      this->resync();
+      continue;
+    }
+
+    frame_begin_ = kHeaderSize;
+    frame_size_ = length;
+    packet_end_ = need;
+    *frame_done = true;
+    return pos;
+  }
+}
+
+void PacketFramer::resetFrame() {
+  // Bytes buffered past the delivered packet belong to the next one
+  if (packet_end_ > 0) {
+    std::memmove(frame_.data(), frame_.data() + packet_end_, raw_size_ - packet_end_);
+    raw_size_ -= packet_end_;
+    packet_end_ = 0;
+    header_valid_ = false;
+  }
+  StreamFramer::resetFrame();
+}
+
+}  // namespace libserial
@@ -2,212 +2,1198 @@
 
 #include "libserial/serial.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <memory>
 #include <poll.h>
+#include <linux/serial.h>
+#include <sys/eventfd.h>
+
+#include "libserial/byte_scan.hpp"
 
 namespace libserial {
 
+namespace {
+
+void applyBaudRate(struct termios2& options, unsigned int baud_rate) {
+  options.c_cflag &= ~CBAUD;
+  options.c_cflag |= BOTHER;
+  options.c_ispeed = baud_rate;
+  options.c_ospeed = baud_rate;
+}
+
+void applyDataLength(struct termios2& options, DataLength nbits) {
+  options.c_cflag &= ~CSIZE;
+  switch (nbits) {
+  case DataLength::FIVE:
+    options.c_cflag |= CS5;
+    break;
+  case DataLength::SIX:
+    options.c_cflag |= CS6;
+    break;
+  case DataLength::SEVEN:
+    options.c_cflag |= CS7;
+    break;
+  case DataLength::EIGHT:
+    options.c_cflag |= CS8;
+    break;
+  }
+}
+
+void applyParity(struct termios2& options, Parity parity) {
+  switch (parity) {
+  case Parity::DISABLE:
+    options.c_cflag &= ~PARENB;
+    break;
+  case Parity::ENABLE:
+    options.c_cflag |= PARENB;
+    break;
+  }
+}
+
+void applyStopBits(struct termios2& options, StopBits stop_bits) {
+  switch (stop_bits) {
+  case StopBits::ONE:
+    options.c_cflag &= ~CSTOPB;
+    break;
+  case StopBits::TWO:
+    options.c_cflag |= CSTOPB;
+    break;
+  }
+}
+
+void applyCanonicalMode(struct termios2& options, CanonicalMode mode) {
+  switch (mode) {
+  case CanonicalMode::ENABLE:
+    options.c_lflag |=  (ICANON);
+    break;
+  case CanonicalMode::DISABLE:
+    options.c_lflag &= ~(ICANON);
+    break;
+  }
+}
+
+// Appends readUntil() data to caller memory
+struct CopyOut {
+  char* out;
+
+  void operator()(const char* data, size_t size) {
+    std::memcpy(out, data, size);
+    out += size;
+  }
+};
+
+// Whether a read failed only because no data arrived in time
+bool timedOut(const IoResult& result) {
+  return result.getStatus() == IoStatus::TIMEOUT || result.getStatus() == IoStatus::WOULD_BLOCK;
+}
+
+// Raises the exception the throwing API reports for a failed result
+[[noreturn]] void throwIoError(const IoResult& result) {
+  if (result.getStatus() == IoStatus::SYSTEM_ERROR) {
+    throw IOException(std::string(result.getMessage()) + ": " + strerror(result.getErrno()));
+  }
+  throw IOException(result.getMessage());
+}
+
+}  // namespace
+
 Serial::Serial(const std::string& port) {
   this->open(port);
   this->setBaudRate(BaudRate::BAUD_RATE_9600);
 }
 
-Serial::~Serial() {
-  if (fd_serial_port_ != -1) {
-    ::close(fd_serial_port_);
-    fd_serial_port_ = -1;
+Serial::~Serial() {
+  try {
+    this->stopAsyncRead();
+  }
+  catch (const SerialException&) {
+  }
+  if (fd_serial_port_ != -1) {
+    ::close(fd_serial_port_);
+    fd_serial_port_ = -1;
+  }
+}
+
+Serial::Serial(const std::string& port, const SerialConfig& config) {
+  this->open(port, config);
+}
+
+void Serial::open(const std::string& port, const SerialConfig& config) {
+  this->open(port);
+  try {
+    this->applyConfig(config);
+  }
+  catch (...) {
+    this->close();
+    throw;
+  }
+}
+
+void Serial::open(const std::string& port) {
+  this->clearRxBuffer();
+  fd_serial_port_ = ::open(port.c_str(), O_RDWR | O_NOCTTY | O_NDELAY | O_NONBLOCK);
+
+  if (fd_serial_port_ == -1) {
+    throw SerialException("Error opening port " + port + ": " + strerror(errno));
+  }
+  else {
+    this->callFcntl(F_SETFL, 0);
+    status_flags_ = 0;
+    non_blocking_ = false;
+  }
+
+  // Seed the configuration cache; from here on it is only updated by
+  // the setters and refreshConfig()
+  try {
+    this->refreshConfig();
+  }
+  catch (...) {
+    this->close();
+    throw;
+  }
+}
+
+void Serial::close() {
+  this->stopAsyncRead();
+  if (fd_serial_port_ != -1) {
+    ssize_t error = ::close(fd_serial_port_);
+    if (error < 0) {
+      throw SerialException("Error closing port: " + std::string(strerror(errno)));
+    }
+    fd_serial_port_ = -1;
+  }
+  non_blocking_ = false;
+  low_latency_ = false;
+  spin_time_ = std::chrono::microseconds(0);
+  this->clearRxBuffer();
+}
+
+void Serial::write(std::shared_ptr<std::string> data) {
+  if (!data) {
+    throw IOException("Null pointer passed to write function");
+  }
+
+  this->write(data->data(), data->size());
+}
+
+size_t Serial::write(const void* data, size_t size) {
+  if (!data) {
+    throw IOException("Null pointer passed to write function");
+  }
+
+  struct iovec segment;
+  segment.iov_base = const_cast<void*>(data);
+  segment.iov_len = size;
+  return this->writev(&segment, 1);
+}
+
+size_t Serial::writev(const struct iovec* segments, size_t count) {
+  StatsScope scope(stats_, StatsLatency::WRITE);
+  if (!segments && count > 0) {
+    throw IOException("Null pointer passed to writev function");
+  }
+
+  size_t size = 0;
+  for (size_t i = 0; i < count; ++i) {
+    size += segments[i].iov_len;
+  }
+
+  IoResult result = this->writevImpl(segments, count, size);
+  if (result.getStatus() == IoStatus::TIMEOUT) {
+    throw TimeoutException("Write operation timed out after " +
+                           std::to_string(write_timeout_ms_.count()) + " milliseconds: " +
+                           std::to_string(result.getBytes()) + " of " + std::to_string(size) +
+                           " bytes written", result.getBytes());
+  }
+  if (!result) {
+    throwIoError(result);
+  }
+  return result.getBytes();
+}
+
+IoResult Serial::tryWrite(const void* data, size_t size) {
+  StatsScope scope(stats_, StatsLatency::WRITE);
+  if (!data) {
+    return IoResult(IoStatus::INVALID_ARGUMENT, "Null pointer passed to write function");
+  }
+
+  struct iovec segment;
+  segment.iov_base = const_cast<void*>(data);
+  segment.iov_len = size;
+  return this->writevImpl(&segment, 1, size);
+}
+
+IoResult Serial::writevImpl(const struct iovec* segments, size_t count, size_t size) {
+  // A bounded write must never block inside ::writev(), so a blocking
+  // descriptor is switched to O_NONBLOCK for this call only and waits on
+  // POLLOUT; reads keep their blocking VMIN/VTIME behaviour. Without a
+  // timeout the kernel is left to block.
+  bool timed = write_timeout_ms_.count() > 0;
+  bool restore_blocking = timed && !non_blocking_;
+  if (restore_blocking) {
+    IoResult mode = this->applyNonBlocking(true);
+    if (!mode) {
+      return mode;
+    }
+  }
+
+  IoResult result = this->writevLoop(segments, count, size);
+
+  if (restore_blocking) {
+    IoResult mode = this->applyNonBlocking(false);
+    if (!mode && result) {
+      return mode;
+    }
+  }
+  return result;
+}
+
+IoResult Serial::writevLoop(const struct iovec* segments, size_t count, size_t size) {
+  bool timed = write_timeout_ms_.count() > 0;
+  size_t bytes_written = 0;
+  size_t index = 0;   // First segment not completely written
+  size_t offset = 0;  // Bytes of segments[index] already written
+  auto deadline = std::chrono::steady_clock::now() + write_timeout_ms_;
+
+  while (bytes_written < size) {
+    // Skip segments that are empty or fully written
+    while (segments[index].iov_len == offset) {
+      ++index;
+      offset = 0;
+    }
+
+    // Window of remaining segments, the first one trimmed by what already went out
+    struct iovec window[kMaxWriteSegments];
+    size_t window_count = std::min(count - index, kMaxWriteSegments);
+    std::copy(segments + index, segments + index + window_count, window);
+    window[0].iov_base = static_cast<char*>(window[0].iov_base) + offset;
+    window[0].iov_len -= offset;
+
+    ssize_t result = this->callWritev(window, static_cast<int>(window_count));
+
+    if (result > 0) {
+      bytes_written += static_cast<size_t>(result);
+      stats_.add(StatsCounter::BYTES_WRITTEN, static_cast<size_t>(result));
+
+      // Advance the segment cursor past the accepted bytes
+      size_t advance = static_cast<size_t>(result);
+      while (advance > 0) {
+        size_t left = segments[index].iov_len - offset;
+        if (advance < left) {
+          offset += advance;
+          break;
+        }
+        advance -= left;
+        ++index;
+        offset = 0;
+      }
+      continue;
+    }
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+      return IoResult(IoStatus::SYSTEM_ERROR, "Error writing to serial port", errno,
+                      bytes_written);
+    }
+    if (result < 0) {
+      stats_.add(StatsCounter::EAGAIN_RETRIES);
+    }
+
+    // Output queue is full: wait until the driver accepts more data
+    int timeout_ms = -1;
+    if (timed) {
+      auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now()).count();
+      timeout_ms = static_cast<int>(std::max<int64_t>(remaining, 0));
+    }
+
+    struct pollfd pfd;
+    pfd.fd = fd_serial_port_;
+    pfd.events = POLLOUT;
+
+    int poll_result = 0;
+    if (timeout_ms != 0) {
+      poll_result = this->callPoll(&pfd, 1, timeout_ms);
+    }
+    if (poll_result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return IoResult(IoStatus::SYSTEM_ERROR, "Error in poll()", errno, bytes_written);
+    }
+    if (poll_result == 0) {
+      stats_.add(StatsCounter::TIMEOUTS);
+      return IoResult(IoStatus::TIMEOUT, "Write operation timed out", 0, bytes_written);
+    }
+  }
+
+  return IoResult(bytes_written);
+}
+
+size_t Serial::read(std::shared_ptr<std::string> buffer) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (canonical_mode_ == CanonicalMode::DISABLE) {
+    throw IOException(
+            "read() is not supported in non-canonical mode; use readBytes() or readUntil() instead");
+  }
+
+  if (!buffer) {
+    throw IOException("Null pointer passed to read function");
+  }
+
+  this->checkRead(this->fillForRead());
+
+  size_t bytes_read = std::min(this->rxAvailable(), max_safe_read_size_);
+  buffer->assign(rx_buffer_.data() + rx_begin_, bytes_read);
+  rx_begin_ += bytes_read;
+  return bytes_read;
+}
+
+size_t Serial::read(void* buffer, size_t size) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (canonical_mode_ == CanonicalMode::DISABLE) {
+    throw IOException(
+            "read() is not supported in non-canonical mode; use readBytes() or readUntil() instead");
+  }
+
+  if (!buffer) {
+    throw IOException("Null pointer passed to read function");
+  }
+
+  this->checkRead(this->fillForRead());
+
+  return this->takeRx(static_cast<char*>(buffer), size);
+}
+
+IoResult Serial::tryRead(void* buffer, size_t size) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (canonical_mode_ == CanonicalMode::DISABLE) {
+    return IoResult(IoStatus::INVALID_ARGUMENT,
+                    "read() is not supported in non-canonical mode; use readBytes() or readUntil() instead");
+  }
+
+  if (!buffer) {
+    return IoResult(IoStatus::INVALID_ARGUMENT, "Null pointer passed to read function");
+  }
+
+  IoResult result = this->fillForRead();
+  if (!result) {
+    return result;
+  }
+
+  return IoResult(this->takeRx(static_cast<char*>(buffer), size));
+}
+
+size_t Serial::readBytes(std::shared_ptr<std::string> buffer, size_t num_bytes) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (canonical_mode_ == CanonicalMode::ENABLE) {
+    throw IOException(
+            "readBytes() is not supported in canonical mode; use read() or readUntil() instead");
+  }
+
+  if (!buffer) {
+    throw IOException("Null pointer passed to readBytes function");
+  }
+
+  if (num_bytes == 0) {
+    throw IOException("Number of bytes requested must be greater than zero");
+  }
+
+  IoResult result = this->fillForReadBytes();
+  if (!result && !timedOut(result)) {
+    throwIoError(result);
+  }
+
+  size_t bytes_read = std::min(this->rxAvailable(), num_bytes);
+  buffer->assign(rx_buffer_.data() + rx_begin_, bytes_read);
+  rx_begin_ += bytes_read;
+  return bytes_read;
+}
+
+size_t Serial::readBytes(void* buffer, size_t num_bytes) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (canonical_mode_ == CanonicalMode::ENABLE) {
+    throw IOException(
+            "readBytes() is not supported in canonical mode; use read() or readUntil() instead");
+  }
+
+  if (!buffer) {
+    throw IOException("Null pointer passed to readBytes function");
+  }
+
+  if (num_bytes == 0) {
+    throw IOException("Number of bytes requested must be greater than zero");
+  }
+
+  IoResult result = this->fillForReadBytes();
+  if (!result && !timedOut(result)) {
+    throwIoError(result);
+  }
+
+  return this->takeRx(static_cast<char*>(buffer), num_bytes);
+}
+
+IoResult Serial::tryReadBytes(void* buffer, size_t num_bytes) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (canonical_mode_ == CanonicalMode::ENABLE) {
+    return IoResult(IoStatus::INVALID_ARGUMENT,
+                    "readBytes() is not supported in canonical mode; use read() or readUntil() instead");
+  }
+
+  if (!buffer) {
+    return IoResult(IoStatus::INVALID_ARGUMENT, "Null pointer passed to readBytes function");
+  }
+
+  if (num_bytes == 0) {
+    return IoResult(IoStatus::INVALID_ARGUMENT,
+                    "Number of bytes requested must be greater than zero");
+  }
+
+  IoResult result = this->fillForReadBytes();
+  if (!result) {
+    return result;
+  }
+
+  return IoResult(this->takeRx(static_cast<char*>(buffer), num_bytes));
+}
+
+size_t Serial::readUntil(std::shared_ptr<std::string> buffer, char terminator) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (!buffer) {
+    throw IOException("Null pointer passed to readUntil function");
+  }
+
+  buffer->clear();
+
+  return this->checkReadUntil(
+    this->readUntilImpl(std::string_view(&terminator, 1), max_safe_read_size_,
+                        [&buffer](const char* data, size_t size) {
+      buffer->append(data, size);
+    }), max_safe_read_size_);
+}
+
+size_t Serial::readUntil(void* buffer, size_t size, char terminator) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (!buffer) {
+    throw IOException("Null pointer passed to readUntil function");
+  }
+
+  size_t limit = std::min(size, max_safe_read_size_);
+  return this->checkReadUntil(
+    this->readUntilImpl(std::string_view(&terminator, 1), limit,
+                        CopyOut{static_cast<char*>(buffer)}), limit);
+}
+
+size_t Serial::readUntil(std::shared_ptr<std::string> buffer, std::string_view delimiter) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (!buffer) {
+    throw IOException("Null pointer passed to readUntil function");
+  }
+  this->checkDelimiter(delimiter);
+
+  buffer->clear();
+
+  return this->checkReadUntil(
+    this->readUntilImpl(delimiter, max_safe_read_size_,
+                        [&buffer](const char* data, size_t size) {
+      buffer->append(data, size);
+    }), max_safe_read_size_);
+}
+
+size_t Serial::readUntil(void* buffer, size_t size, std::string_view delimiter) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (!buffer) {
+    throw IOException("Null pointer passed to readUntil function");
+  }
+  this->checkDelimiter(delimiter);
+
+  size_t limit = std::min(size, max_safe_read_size_);
+  return this->checkReadUntil(
+    this->readUntilImpl(delimiter, limit, CopyOut{static_cast<char*>(buffer)}), limit);
+}
+
+IoResult Serial::tryReadUntil(void* buffer, size_t size, char terminator) {
+  return this->tryReadUntil(buffer, size, std::string_view(&terminator, 1));
+}
+
+IoResult Serial::tryReadUntil(void* buffer, size_t size, std::string_view delimiter) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (!buffer) {
+    return IoResult(IoStatus::INVALID_ARGUMENT, "Null pointer passed to readUntil function");
+  }
+  if (delimiter.empty()) {
+    return IoResult(IoStatus::INVALID_ARGUMENT, "Empty delimiter passed to readUntil function");
+  }
+  if (delimiter.size() > max_safe_read_size_) {
+    return IoResult(IoStatus::INVALID_ARGUMENT, "Delimiter exceeds maximum read size");
+  }
+
+  return this->readUntilImpl(delimiter, std::min(size, max_safe_read_size_),
+                             CopyOut{static_cast<char*>(buffer)});
+}
+
+void Serial::checkDelimiter(std::string_view delimiter) const {
+  if (delimiter.empty()) {
+    throw IOException("Empty delimiter passed to readUntil function");
+  }
+  if (delimiter.size() > max_safe_read_size_) {
+    throw IOException("Delimiter of " + std::to_string(delimiter.size()) +
+                      " bytes exceeds maximum read size of " +
+                      std::to_string(max_safe_read_size_) + " bytes");
+  }
+}
+
+size_t Serial::checkReadUntil(const IoResult& result, size_t limit) const {
+  if (result.getStatus() == IoStatus::LIMIT_EXCEEDED) {
+    throw IOException("Read buffer exceeded maximum size limit of " + std::to_string(limit) +
+                      " bytes without finding terminator");
+  }
+  if (!result) {
+    throwIoError(result);
+  }
+  return result.getBytes();
+}
+
+template <typename Append>
+IoResult Serial::readUntilImpl(std::string_view delimiter, size_t limit, Append append) {
+  size_t total = 0;
+
+  auto start_time = std::chrono::steady_clock::now();
+
+  while (true) {
+    // Serve as much as possible from the receive buffer before touching the port
+    size_t available = this->rxAvailable();
+    if (available > 0) {
+      const char* begin = rx_buffer_.data() + rx_begin_;
+      const char* found = delimiter.size() == 1 ?
+                          findByte(begin, available, delimiter[0]) :
+                          findSequence(begin, available, delimiter);
+
+      // Without a match, keep back the bytes that may start a delimiter
+      size_t take = found ? static_cast<size_t>(found - begin) + delimiter.size() :
+                    available - std::min(available, delimiter.size() - 1);
+
+      // Check buffer size limit to prevent excessive memory usage. Without a
+      // delimiter at least one more byte is still needed.
+      size_t needed = found ? take : available + 1;
+      if (total + needed > limit) {
+        rx_begin_ += take;
+        return IoResult(IoStatus::LIMIT_EXCEEDED,
+                        "Read buffer exceeded maximum size limit without finding terminator",
+                        0, total);
+      }
+
+      // Hand the data over (including delimiter); leftovers stay buffered
+      if (take > 0) {
+        append(begin, take);
+      }
+      total += take;
+      rx_begin_ += take;
+      if (found) {
+        break;
+      }
+    }
+
+    IoResult result = this->pullUntilData(start_time);
+    if (!result) {
+      return IoResult(result.getStatus(), result.getMessage(), result.getErrno(), total);
+    }
+  }
+
+  return IoResult(total);
+}
+
+IoResult Serial::pullUntilData(std::chrono::steady_clock::time_point start_time) {
+  struct pollfd pfd;
+  pfd.fd = fd_serial_port_;
+  pfd.events = POLLIN;
+
+  // In low latency mode busy-poll first; data found there skips the wait
+  int poll_result = this->spinForInput(&pfd);
+
+  // Check timeout if enabled (0 means no timeout)
+  if (poll_result == 0 && read_timeout_ms_.count() == 0) {
+    // No timeout: the default blocking descriptor waits in the read
+    // itself, a non-blocking one or VMIN/VTIME of zero would return at once
+    if (non_blocking_ || low_latency_) {
+      poll_result = this->callPoll(&pfd, 1, -1);
+    }
+  }
+  else if (poll_result == 0) {
+    auto current_time = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(current_time -
+                                                                         start_time).count();
+
+    if (elapsed >= static_cast<int64_t>(read_timeout_ms_.count())) {
+      stats_.add(StatsCounter::TIMEOUTS);
+      return IoResult(IoStatus::TIMEOUT, "Read timeout exceeded while waiting for terminator");
+    }
+
+    // Use poll() to check if data is available with remaining timeout.
+    // poll() does not have the FD_SETSIZE limitation that select() has
+    // and is more robust for larger file descriptor values.
+    int64_t remaining_timeout = read_timeout_ms_.count() - elapsed;
+    int timeout_ms = static_cast<int>(remaining_timeout);
+
+    poll_result = this->callPoll(&pfd, 1, timeout_ms);
+    if (poll_result == 0) {
+      stats_.add(StatsCounter::TIMEOUTS);
+      return IoResult(IoStatus::TIMEOUT, "Read timeout exceeded while waiting for data");
+    }
+  }
+  if (poll_result < 0) {
+    return IoResult(IoStatus::SYSTEM_ERROR, "Error in poll()", errno);
+  }
+
+  // Data is available, pull everything the kernel has in one read
+  ssize_t bytes_read = this->fillRxBuffer();
+
+  if (bytes_read < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      // Non-blocking read, no data available right now
+      stats_.add(StatsCounter::EAGAIN_RETRIES);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return IoResult();
+    }
+    return IoResult(IoStatus::SYSTEM_ERROR, "Error reading from serial port", errno);
+  }
+  else if (bytes_read == 0) {
+    // End of file or connection closed
+    return IoResult(IoStatus::CLOSED, "Connection closed while reading: no terminator found");
+  }
+  return IoResult(static_cast<size_t>(bytes_read));
+}
+
+PooledBuffer Serial::readPooled() {
+  PooledBuffer buffer = BufferPool::acquire(max_safe_read_size_);
+  buffer.resize(this->read(buffer.data(), max_safe_read_size_));
+  return buffer;
+}
+
+PooledBuffer Serial::readBytesPooled(size_t num_bytes) {
+  PooledBuffer buffer = BufferPool::acquire(num_bytes);
+  buffer.resize(this->readBytes(buffer.data(), num_bytes));
+  return buffer;
+}
+
+PooledBuffer Serial::readUntilPooled(char terminator) {
+  PooledBuffer buffer = BufferPool::acquire(max_safe_read_size_);
+  buffer.resize(this->readUntil(buffer.data(), max_safe_read_size_, terminator));
+  return buffer;
+}
+
+PooledBuffer Serial::readUntilPooled(std::string_view delimiter) {
+  PooledBuffer buffer = BufferPool::acquire(max_safe_read_size_);
+  buffer.resize(this->readUntil(buffer.data(), max_safe_read_size_, delimiter));
+  return buffer;
+}
+
+const std::vector<std::string_view>& Serial::readLines() {
+  StatsScope scope(stats_, StatsLatency::READ);
+  const char terminator = static_cast<char>(terminator_);
+  lines_.clear();
+
+  auto start_time = std::chrono::steady_clock::now();
+
+  // Bytes before rx_begin_ + scanned are known to hold no terminator
+  size_t scanned = 0;
+  while (true) {
+    const char* begin = rx_buffer_.data() + rx_begin_;
+    const char* end = rx_buffer_.data() + rx_end_;
+    const char* line = begin;
+    const char* found = findByte(begin + scanned, this->rxAvailable() - scanned, terminator);
+    while (found) {
+      lines_.emplace_back(line, static_cast<size_t>(found - line) + 1);
+      line = found + 1;
+      found = findByte(line, static_cast<size_t>(end - line), terminator);
+    }
+
+    if (!lines_.empty()) {
+      // The partial trailing line stays buffered for the next call
+      rx_begin_ += static_cast<size_t>(line - begin);
+      return lines_;
+    }
+
+    scanned = this->rxAvailable();
+    if (scanned + 1 > max_safe_read_size_) {
+      rx_begin_ = rx_end_;
+      throw IOException("Read buffer exceeded maximum size limit of " +
+                        std::to_string(max_safe_read_size_) +
+                        " bytes without finding terminator");
+    }
+
+    IoResult result = this->pullUntilData(start_time);
+    if (!result) {
+      throwIoError(result);
+    }
+  }
+}
+
+IoResult Serial::pollInput() {
+  struct pollfd fd_poll;
+  fd_poll.fd = fd_serial_port_;
+  fd_poll.events = POLLIN;
+
+  // 0 => no wait (immediate return), -1 => block forever, positive => wait specified milliseconds
+  int timeout_ms = static_cast<int>(read_timeout_ms_.count());
+  int pr = timeout_ms != 0 ? this->spinForInput(&fd_poll) : 0;
+  if (pr == 0) {
+    pr = this->callPoll(&fd_poll, 1, timeout_ms);
+  }
+  if (pr < 0) {
+    return IoResult(IoStatus::SYSTEM_ERROR, "Error in poll()", errno);
+  }
+  if (pr == 0) {
+    stats_.add(StatsCounter::TIMEOUTS);
+    if (timeout_ms == 0) {
+      return IoResult(IoStatus::WOULD_BLOCK, "No data available");
+    }
+    return IoResult(IoStatus::TIMEOUT, "Read operation timed out");
+  }
+  return IoResult();
+}
+
+void Serial::waitForInput() {
+  this->checkRead(this->pollInput());
+}
+
+void Serial::checkRead(const IoResult& result) const {
+  if (timedOut(result)) {
+    throw IOException("Read operation timed out after " +
+                      std::to_string(static_cast<int>(read_timeout_ms_.count())) +
+                      " milliseconds");
+  }
+  if (!result) {
+    throwIoError(result);
+  }
+}
+
+IoResult Serial::fillForRead() {
+  if (this->rxAvailable() > 0) {
+    return IoResult();
+  }
+
+  IoResult result = this->pollInput();
+  if (!result) {
+    return result;
+  }
+
+  // Data available: refill the receive buffer
+  if (this->fillRxBuffer() < 0) {
+    return IoResult(IoStatus::SYSTEM_ERROR, "Error reading from serial port", errno);
   }
+  return IoResult();
 }
 
-void Serial::open(const std::string& port) {
-  fd_serial_port_ = ::open(port.c_str(), O_RDWR | O_NOCTTY | O_NDELAY | O_NONBLOCK);
+IoResult Serial::fillForReadBytes() {
+  if (this->rxAvailable() > 0) {
+    return IoResult();
+  }
 
-  if (fd_serial_port_ == -1) {
-    throw SerialException("Error opening port " + port + ": " + strerror(errno));
+  // The default blocking descriptor waits in the read according to VMIN/VTIME. A
+  // non-blocking one is read first and only waits in poll() when nothing
+  // is queued: the read timeout bounds the wait, and with no timeout and
+  // VMIN set it lasts until the first byte, as the blocking read would.
+  bool poll_wait = non_blocking_ || low_latency_;
+  ssize_t bytes_read = this->fillRxBuffer();
+  bool nothing_queued = (bytes_read < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) ||
+                        (bytes_read == 0 && options_.c_cc[VMIN] == 0 && options_.c_cc[VTIME] == 0);
+  if (poll_wait && nothing_queued) {
+    if (bytes_read < 0) {
+      stats_.add(StatsCounter::EAGAIN_RETRIES);
+    }
+    if (read_timeout_ms_.count() == 0 && !low_latency_ && options_.c_cc[VMIN] > 0) {
+      struct pollfd pfd;
+      pfd.fd = fd_serial_port_;
+      pfd.events = POLLIN;
+      if (this->callPoll(&pfd, 1, -1) < 0) {
+        return IoResult(IoStatus::SYSTEM_ERROR, "Error in poll()", errno);
+      }
+    }
+    else {
+      IoResult result = this->pollInput();
+      if (!result) {
+        return result;
+      }
+    }
+    bytes_read = this->fillRxBuffer();
   }
-  else {
-    fcntl(fd_serial_port_, F_SETFL, 0);
+
+  if (bytes_read < 0) {
+    if (poll_wait && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return IoResult(IoStatus::WOULD_BLOCK, "No data available");
+    }
+    return IoResult(IoStatus::SYSTEM_ERROR, "Error reading from serial port", errno);
   }
-}
 
-void Serial::close() {
-  if (fd_serial_port_ != -1) {
-    ssize_t error = ::close(fd_serial_port_);
-    if (error < 0) {
-      throw SerialException("Error closing port: " + std::string(strerror(errno)));
+  // The read came back empty: VTIME expired, or with VTIME and VMIN
+  // both zero there was simply nothing to read
+  if (bytes_read == 0) {
+    if (options_.c_cc[VTIME] == 0) {
+      return IoResult(IoStatus::WOULD_BLOCK, "No data available");
     }
-    fd_serial_port_ = -1;
+    stats_.add(StatsCounter::TIMEOUTS);
+    return IoResult(IoStatus::TIMEOUT, "Read timeout exceeded while waiting for data");
   }
+  return IoResult(static_cast<size_t>(bytes_read));
 }
 
-void Serial::write(std::shared_ptr<std::string> data) {
-  if (!data) {
-    throw IOException("Null pointer passed to write function");
+int Serial::spinForInput(struct pollfd* fd_poll) {
+  if (spin_time_.count() == 0) {
+    return 0;
   }
 
-  ssize_t bytes_written = ::write(fd_serial_port_, data->c_str(), data->size());
+  // Busy-poll without sleeping, so data arriving within the spin window
+  // is picked up without a scheduler wakeup
+  auto deadline = std::chrono::steady_clock::now() + spin_time_;
+  do {
+    int pr = this->callPoll(fd_poll, 1, 0);
+    if (pr != 0) {
+      return pr;
+    }
+  } while (std::chrono::steady_clock::now() < deadline);
+  return 0;
+}
 
-  if (bytes_written < 0) {
-    throw IOException("Error writing to serial port: " + std::string(strerror(errno)));
+void Serial::setNonBlocking(bool enable) {
+  IoResult result = this->applyNonBlocking(enable);
+  if (!result) {
+    throwIoError(result);
   }
 }
 
-size_t Serial::read(std::shared_ptr<std::string> buffer) {
-  if (canonical_mode_ == CanonicalMode::DISABLE) {
-    throw IOException(
-            "read() is not supported in non-canonical mode; use readBytes() or readUntil() instead");
+IoResult Serial::applyNonBlocking(bool enable) {
+  if (enable == non_blocking_) {
+    return IoResult();
   }
 
-  if (!buffer) {
-    throw IOException("Null pointer passed to read function");
+  // The flags were set by open() and are only changed here, so a single
+  // F_SETFL switches the mode
+  int flags = enable ? (status_flags_ | O_NONBLOCK) : (status_flags_ & ~O_NONBLOCK);
+  if (this->callFcntl(F_SETFL, flags) < 0) {
+    return IoResult(IoStatus::SYSTEM_ERROR, "Error setting file status flags", errno);
   }
+  status_flags_ = flags;
+  non_blocking_ = enable;
+  return IoResult();
+}
 
-  buffer->clear();
-  buffer->resize(max_safe_read_size_);
+size_t Serial::takeRx(char* buffer, size_t size) {
+  size_t count = std::min(this->rxAvailable(), size);
+  std::memcpy(buffer, rx_buffer_.data() + rx_begin_, count);
+  rx_begin_ += count;
+  return count;
+}
 
-  struct pollfd fd_poll;
-  fd_poll.fd = fd_serial_port_;
-  fd_poll.events = POLLIN;
+ssize_t Serial::fillRxBuffer() {
+  size_t capacity = std::max(kRxBufferSize, max_safe_read_size_);
+  if (rx_buffer_.size() < capacity) {
+    rx_buffer_.resize(capacity);
+  }
 
-  // 0 => no wait (immediate return), -1 => block forever, positive => wait specified milliseconds
-  int timeout_ms = static_cast<int>(read_timeout_ms_.count());
-  int pr = poll_(&fd_poll, 1, timeout_ms);
-  if (pr < 0) {
-    throw IOException(std::string("Error in poll(): ") + strerror(errno));
+  // Move unread bytes to the front so the read gets the largest window
+  if (rx_begin_ == rx_end_) {
+    this->clearRxBuffer();
   }
-  if (pr == 0) {
-    throw IOException("Read operation timed out after " + std::to_string(timeout_ms) +
-                      " milliseconds");
+  else if (rx_begin_ > 0) {
+    std::memmove(rx_buffer_.data(), rx_buffer_.data() + rx_begin_, this->rxAvailable());
+    rx_end_ -= rx_begin_;
+    rx_begin_ = 0;
+  }
+
+  ssize_t bytes_read = this->callRead(rx_buffer_.data() + rx_end_,
+                                      rx_buffer_.size() - rx_end_);
+  if (bytes_read > 0) {
+    rx_end_ += static_cast<size_t>(bytes_read);
+    stats_.add(StatsCounter::BYTES_READ, static_cast<size_t>(bytes_read));
+  }
+  return bytes_read;
+}
+
+size_t Serial::readAvailable(void* buffer, size_t size) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (!buffer) {
+    throw IOException("Null pointer passed to readAvailable function");
   }
 
-  // Data available: do the read
-  ssize_t bytes_read = read_(fd_serial_port_, const_cast<char*>(buffer->data()),
-                             max_safe_read_size_);
+  if (this->rxAvailable() > 0) {
+    return this->takeRx(static_cast<char*>(buffer), size);
+  }
+
+  this->setNonBlocking(true);
+  ssize_t bytes_read = this->callRead(buffer, size);
   if (bytes_read < 0) {
-    throw IOException(std::string("Error reading from serial port: ") + strerror(errno));
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+      stats_.add(StatsCounter::EAGAIN_RETRIES);
+      return 0;
+    }
+    throw IOException("Error reading from serial port: " + std::string(strerror(errno)));
   }
-  buffer->resize(static_cast<size_t>(bytes_read));
+  stats_.add(StatsCounter::BYTES_READ, static_cast<size_t>(bytes_read));
   return static_cast<size_t>(bytes_read);
 }
 
-size_t Serial::readBytes(std::shared_ptr<std::string> buffer, size_t num_bytes) {
-  if (canonical_mode_ == CanonicalMode::ENABLE) {
-    throw IOException(
-            "readBytes() is not supported in canonical mode; use read() or readUntil() instead");
+size_t Serial::readSome(void* buffer, size_t size) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  if (!buffer) {
+    throw IOException("Null pointer passed to readSome function");
   }
 
-  if (!buffer) {
-    throw IOException("Null pointer passed to readBytes function");
+  if (this->rxAvailable() > 0) {
+    return this->takeRx(static_cast<char*>(buffer), size);
   }
 
-  if (num_bytes == 0) {
-    throw IOException("Number of bytes requested must be greater than zero");
+  this->waitForInput();
+
+  ssize_t bytes_read = this->callRead(buffer, size);
+  if (bytes_read < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+      stats_.add(StatsCounter::EAGAIN_RETRIES);
+      return 0;
+    }
+    throw IOException("Error reading from serial port: " + std::string(strerror(errno)));
   }
+  stats_.add(StatsCounter::BYTES_READ, static_cast<size_t>(bytes_read));
+  return static_cast<size_t>(bytes_read);
+}
 
-  buffer->clear();
-  buffer->resize(num_bytes);
+size_t Serial::readInto(SpscRing& ring) {
+  StatsScope scope(stats_, StatsLatency::READ);
+  struct iovec regions[2];
+  if (ring.writableRegions(regions) == 0) {
+    return 0;
+  }
+
+  // Bytes already pulled into the receive buffer must keep their order
+  if (this->rxAvailable() > 0) {
+    size_t stored = ring.write(rx_buffer_.data() + rx_begin_, this->rxAvailable());
+    rx_begin_ += stored;
+    return stored;
+  }
 
-  ssize_t bytes_read = read_(fd_serial_port_, buffer->data(), num_bytes);  // codacy-ignore[buffer-boundary]
+  this->waitForInput();
 
+  // The consumer may have freed more space while we waited
+  ring.writableRegions(regions);
+  int count = regions[1].iov_len > 0 ? 2 : 1;
+  ssize_t bytes_read = this->callReadv(regions, count);
   if (bytes_read < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+      stats_.add(StatsCounter::EAGAIN_RETRIES);
+      return 0;
+    }
     throw IOException("Error reading from serial port: " + std::string(strerror(errno)));
   }
-
-  buffer->resize(static_cast<size_t>(bytes_read));
+  stats_.add(StatsCounter::BYTES_READ, static_cast<size_t>(bytes_read));
+  ring.commitWrite(static_cast<size_t>(bytes_read));
   return static_cast<size_t>(bytes_read);
 }
 
-size_t Serial::readUntil(std::shared_ptr<std::string> buffer, char terminator) {
-  if (!buffer) {
-    throw IOException("Null pointer passed to readUntil function");
+size_t Serial::writeAvailable(const void* data, size_t size) {
+  StatsScope scope(stats_, StatsLatency::WRITE);
+  if (!data) {
+    throw IOException("Null pointer passed to writeAvailable function");
   }
 
-  buffer->clear();
-  char temp_char = '\0';
+  this->setNonBlocking(true);
+  ssize_t bytes_written = this->callWrite(data, size);
+  if (bytes_written < 0) {
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+      stats_.add(StatsCounter::EAGAIN_RETRIES);
+      return 0;
+    }
+    throw IOException("Error writing to serial port: " + std::string(strerror(errno)));
+  }
+  stats_.add(StatsCounter::BYTES_WRITTEN, static_cast<size_t>(bytes_written));
+  return static_cast<size_t>(bytes_written);
+}
 
-  auto start_time = std::chrono::steady_clock::now();
+ReadUntilAwaitable Serial::asyncReadUntil(char terminator) {
+  return ReadUntilAwaitable(*this, terminator);
+}
 
-  while (temp_char != terminator) {
-    // Check buffer size limit to prevent excessive memory usage
-    if (buffer->size() >= max_safe_read_size_) {
-      throw IOException("Read buffer exceeded maximum size limit of " +
-                        std::to_string(max_safe_read_size_) +
-                        " bytes without finding terminator");
-    }
-    // Check timeout if enabled (0 means no timeout)
-    if (read_timeout_ms_.count() > 0) {
-      auto current_time = std::chrono::steady_clock::now();
-      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(current_time -
-                                                                           start_time).count();
+ReadBytesAwaitable Serial::asyncReadBytes(size_t num_bytes) {
+  return ReadBytesAwaitable(*this, num_bytes);
+}
 
-      if (elapsed >= static_cast<int64_t>(read_timeout_ms_.count())) {
-        throw IOException("Read timeout exceeded while waiting for terminator");
-      }
+WriteAwaitable Serial::asyncWrite(const void* data, size_t size) {
+  return WriteAwaitable(*this, data, size);
+}
 
-      // Use poll() to check if data is available with remaining timeout.
-      // poll() does not have the FD_SETSIZE limitation that select() has
-      // and is more robust for larger file descriptor values.
-      struct pollfd pfd;
-      pfd.fd = fd_serial_port_;
-      pfd.events = POLLIN;
+WriteAwaitable Serial::asyncWrite(const std::string& data) {
+  return WriteAwaitable(*this, data.data(), data.size());
+}
+
+void Serial::onData(std::function<void(const char*, size_t)> callback) {
+  if (reader_thread_.joinable()) {
+    throw SerialException("Cannot change callbacks while the reader thread is running");
+  }
+  on_data_ = std::move(callback);
+}
+
+void Serial::onLine(std::function<void(const std::string&)> callback) {
+  if (reader_thread_.joinable()) {
+    throw SerialException("Cannot change callbacks while the reader thread is running");
+  }
+  on_line_ = std::move(callback);
+}
+
+void Serial::onError(std::function<void(const SerialException&)> callback) {
+  if (reader_thread_.joinable()) {
+    throw SerialException("Cannot change callbacks while the reader thread is running");
+  }
+  on_error_ = std::move(callback);
+}
+
+void Serial::startAsyncRead() {
+  if (fd_serial_port_ == -1) {
+    throw SerialException("Cannot start async read: port is not open");
+  }
+  if (reader_thread_.joinable()) {
+    throw SerialException("Async read is already running");
+  }
+
+  reader_stop_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (reader_stop_fd_ < 0) {
+    throw SerialException("Error creating eventfd: " + std::string(strerror(errno)));
+  }
+  reader_thread_ = std::thread(&Serial::asyncReadLoop, this, static_cast<char>(terminator_));
+}
 
-      int64_t remaining_timeout = read_timeout_ms_.count() - elapsed;
-      int timeout_ms = static_cast<int>(remaining_timeout);
+void Serial::stopAsyncRead() {
+  if (!reader_thread_.joinable()) {
+    return;
+  }
+  if (std::this_thread::get_id() == reader_thread_.get_id()) {
+    throw SerialException("stopAsyncRead() cannot be called from an async callback");
+  }
+
+  uint64_t value = 1;
+  ssize_t result = ::write(reader_stop_fd_, &value, sizeof(value));
+  (void)result;
+  reader_thread_.join();
+
+  ::close(reader_stop_fd_);
+  reader_stop_fd_ = -1;
+}
+
+bool Serial::isAsyncReading() const {
+  return reader_thread_.joinable();
+}
 
-      int poll_result = poll_(&pfd, 1, timeout_ms);
-      if (poll_result < 0) {
-        throw IOException("Error in poll(): " + std::string(strerror(errno)));
+void Serial::asyncReadLoop(char terminator) {
+  std::string line;
+  auto fail = [this](const SerialException& error) {
+      if (on_error_) {
+        on_error_(error);
       }
-      else if (poll_result == 0) {
-        throw IOException("Read timeout exceeded while waiting for data");
+    };
+
+  // Bytes buffered by earlier synchronous reads come first
+  if (this->rxAvailable() > 0) {
+    this->dispatchAsyncData(rx_buffer_.data() + rx_begin_, this->rxAvailable(), terminator, line);
+    this->clearRxBuffer();
+  }
+
+  std::vector<char> chunk(std::max(kRxBufferSize, max_safe_read_size_));
+  struct pollfd fds[2];
+  fds[0].fd = fd_serial_port_;
+  fds[0].events = POLLIN;
+  fds[1].fd = reader_stop_fd_;
+  fds[1].events = POLLIN;
+
+  while (true) {
+    int pr = this->callPoll(fds, 2, -1);
+    if (pr < 0) {
+      if (errno == EINTR) {
+        continue;
       }
+      fail(IOException(std::string("Error in poll(): ") + strerror(errno)));
+      return;
     }
 
-    // Data is available, perform the read
-    ssize_t bytes_read = read_(fd_serial_port_, &temp_char, 1);
+    if (fds[1].revents & POLLIN) {
+      return;  // stopAsyncRead()
+    }
 
-    if (bytes_read < 0) {
-      if (errno == EAGAIN || errno == EWOULDBLOCK) {
-        // Non-blocking read, no data available right now
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    if (fds[0].revents & POLLIN) {
+      ssize_t bytes_read = this->callRead(chunk.data(), chunk.size());
+      if (bytes_read > 0) {
+        stats_.add(StatsCounter::BYTES_READ, static_cast<size_t>(bytes_read));
+        this->dispatchAsyncData(chunk.data(), static_cast<size_t>(bytes_read), terminator, line);
         continue;
       }
-      throw IOException("Error reading from serial port: " + std::string(strerror(errno)));
+      if (bytes_read < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        fail(IOException("Error reading from serial port: " + std::string(strerror(errno))));
+        return;
+      }
     }
-    else if (bytes_read == 0) {
-      // End of file or connection closed
-      throw IOException("Connection closed while reading: no terminator found");
+
+    if (fds[0].revents & (POLLHUP | POLLERR | POLLNVAL)) {
+      fail(IOException("Serial port hung up"));
+      return;
     }
+  }
+}
 
-    // Add the character to buffer (including terminator)
-    buffer->push_back(temp_char);
+void Serial::dispatchAsyncData(const char* data, size_t size, char terminator,
+                               std::string& line) {
+  if (on_data_) {
+    on_data_(data, size);
   }
+  if (!on_line_) {
+    return;
+  }
+
+  // Reassemble lines; the partial tail stays in line for the next read
+  const char* end = data + size;
+  while (data < end) {
+    const char* found = findByte(data, static_cast<size_t>(end - data), terminator);
+    const char* stop = found ? found + 1 : end;
 
-  return buffer->size();
+    if (line.size() + static_cast<size_t>(stop - data) > max_safe_read_size_) {
+      line.clear();
+      if (on_error_) {
+        on_error_(IOException("Read buffer exceeded maximum size limit of " +
+                              std::to_string(max_safe_read_size_) +
+                              " bytes without finding terminator"));
+      }
+      data = stop;
+      continue;
+    }
+
+    line.append(data, static_cast<size_t>(stop - data));
+    data = stop;
+    if (found) {
+      on_line_(line);
+      line.clear();
+    }
+  }
 }
 
 void Serial::flushInputBuffer() {
-  if (ioctl_(fd_serial_port_, TCFLSH, TCIFLUSH) != 0) {
+  this->clearRxBuffer();
+  if (this->callIoctl(TCFLSH, TCIFLUSH) != 0) {
     throw SerialException("Error flushing input buffer: " + std::string(strerror(errno)));
   }
 }
 
-void Serial::setTermios2() {
-  ssize_t error = ioctl_(fd_serial_port_, TCSETS2, &options_);
+void Serial::setTermios2(struct termios2 options) {
+  ssize_t error = this->callIoctl(TCSETS2, &options);
   if (error < 0) {
     throw SerialException("Error set Termios2: " + std::string(strerror(errno)));
   }
+  options_ = options;
 }
 
 void Serial::setBaudRate(unsigned int baud_rate) {
-  this->getTermios2();
-  options_.c_cflag &= ~CBAUD;
-  options_.c_cflag |= BOTHER;
-  options_.c_ispeed = baud_rate;
-  options_.c_ospeed = baud_rate;
-  this->setTermios2();
+  struct termios2 options = options_;
+  applyBaudRate(options, baud_rate);
+  this->setTermios2(options);
 }
 
 void Serial::setBaudRate(BaudRate baud_rate) {
@@ -215,8 +1201,64 @@ void Serial::setBaudRate(BaudRate baud_rate) {
 }
 
 void Serial::setReadTimeout(std::chrono::milliseconds timeout) {
-  read_timeout_ms_ = timeout;
   this->setTimeOut(static_cast<uint16_t>(timeout.count() / 100));
+  read_timeout_ms_ = timeout;
+}
+
+void Serial::setLowLatencyMode(bool enable, std::chrono::microseconds spin_time) {
+  if (enable == low_latency_) {
+    spin_time_ = enable ? spin_time : std::chrono::microseconds(0);
+    return;
+  }
+
+  this->setKernelLowLatency(enable);
+
+  // Reads return as soon as anything is queued; the read timeout is
+  // enforced with poll() instead of VTIME
+  struct termios2 options = options_;
+  if (enable) {
+    saved_vmin_ = options.c_cc[VMIN];
+    saved_vtime_ = options.c_cc[VTIME];
+    options.c_cc[VMIN] = 0;
+    options.c_cc[VTIME] = 0;
+  }
+  else {
+    options.c_cc[VMIN] = saved_vmin_;
+    options.c_cc[VTIME] = saved_vtime_;
+  }
+  this->setTermios2(options);
+
+  low_latency_ = enable;
+  spin_time_ = enable ? spin_time : std::chrono::microseconds(0);
+}
+
+bool Serial::isLowLatencyMode() const {
+  return low_latency_;
+}
+
+std::chrono::microseconds Serial::getSpinTime() const {
+  return spin_time_;
+}
+
+void Serial::setKernelLowLatency(bool enable) {
+  struct serial_struct serial_info;
+  if (this->callIoctl(TIOCGSERIAL, &serial_info) < 0) {
+    // Only UART drivers know the flag; USB CDC and pseudo-terminals don't
+    if (errno == ENOTTY || errno == EINVAL) {
+      return;
+    }
+    throw SerialException("Error getting serial info: " + std::string(strerror(errno)));
+  }
+
+  if (enable) {
+    serial_info.flags |= ASYNC_LOW_LATENCY;
+  }
+  else {
+    serial_info.flags &= ~ASYNC_LOW_LATENCY;
+  }
+  if (this->callIoctl(TIOCSSERIAL, &serial_info) < 0) {
+    throw SerialException("Error setting serial info: " + std::string(strerror(errno)));
+  }
 }
 
 void Serial::setWriteTimeout(std::chrono::milliseconds timeout) {
@@ -224,49 +1266,21 @@ void Serial::setWriteTimeout(std::chrono::milliseconds timeout) {
 }
 
 void Serial::setDataLength(DataLength nbits) {
-  this->getTermios2();
-  options_.c_cflag &= ~CSIZE;
-  switch (nbits) {
-  case DataLength::FIVE:
-    options_.c_cflag |= CS5;
-    break;
-  case DataLength::SIX:
-    options_.c_cflag |= CS6;
-    break;
-  case DataLength::SEVEN:
-    options_.c_cflag |= CS7;
-    break;
-  case DataLength::EIGHT:
-    options_.c_cflag |= CS8;
-    break;
-  }
-  this->setTermios2();
+  struct termios2 options = options_;
+  applyDataLength(options, nbits);
+  this->setTermios2(options);
 }
 
 void Serial::setParity(Parity parity) {
-  this->getTermios2();
-  switch (parity) {
-  case Parity::DISABLE:
-    options_.c_cflag &= ~PARENB;
-    break;
-  case Parity::ENABLE:
-    options_.c_cflag |= PARENB;
-    break;
-  }
-  this->setTermios2();
+  struct termios2 options = options_;
+  applyParity(options, parity);
+  this->setTermios2(options);
 }
 
 void Serial::setStopBits(StopBits stop_bits) {
-  this->getTermios2();
-  switch (stop_bits) {
-  case StopBits::ONE:
-    options_.c_cflag &= ~CSTOP;
-    break;
-  case StopBits::TWO:
-    options_.c_cflag |= CSTOP;
-    break;
-  }
-  this->setTermios2();
+  struct termios2 options = options_;
+  applyStopBits(options, stop_bits);
+  this->setTermios2(options);
 }
 
 void Serial::setFlowControl([[maybe_unused]] FlowControl flow_control) {
@@ -312,17 +1326,10 @@ void Serial::setFlowControl([[maybe_unused]] FlowControl flow_control) {
 }
 
 void Serial::setCanonicalMode(CanonicalMode mode) {
+  struct termios2 options = options_;
+  applyCanonicalMode(options, mode);
+  this->setTermios2(options);
   canonical_mode_ = mode;
-  this->getTermios2();
-  switch (canonical_mode_) {
-  case CanonicalMode::ENABLE:
-    options_.c_lflag |=  (ICANON);
-    break;
-  case CanonicalMode::DISABLE:
-    options_.c_lflag &= ~(ICANON);
-    break;
-  }
-  this->setTermios2();
 }
 
 void Serial::setTerminator(Terminator term) {
@@ -330,16 +1337,83 @@ void Serial::setTerminator(Terminator term) {
 }
 
 void Serial::setTimeOut(uint16_t time) {
-  this->getTermios2();
-  options_.c_cc[VTIME] = time;
-  this->setTermios2();
+  if (low_latency_) {
+    // Kept for setLowLatencyMode(false); the kernel VTIME stays zero
+    saved_vtime_ = static_cast<cc_t>(time);
+    return;
+  }
+  struct termios2 options = options_;
+  options.c_cc[VTIME] = static_cast<cc_t>(time);
+  this->setTermios2(options);
 }
 
 void Serial::setMinNumberCharRead(uint16_t num) {
+  if (low_latency_) {
+    // Kept for setLowLatencyMode(false); the kernel VMIN stays zero
+    saved_vmin_ = static_cast<cc_t>(num);
+  }
+  else {
+    struct termios2 options = options_;
+    options.c_cc[VMIN] = static_cast<cc_t>(num);
+    this->setTermios2(options);
+  }
   min_number_char_read_ = num;
-  this->getTermios2();
-  options_.c_cc[VMIN] = min_number_char_read_;
-  this->setTermios2();
+}
+
+void Serial::applyConfig(const SerialConfig& config) {
+  // Stage every change on one termios2 copy so the line is reconfigured
+  // by a single TCSETS2 instead of one per setting
+  struct termios2 options = options_;
+
+  if (auto baud_rate = config.getBaudRate()) {
+    applyBaudRate(options, *baud_rate);
+  }
+  if (auto data_length = config.getDataLength()) {
+    applyDataLength(options, *data_length);
+  }
+  if (auto parity = config.getParity()) {
+    applyParity(options, *parity);
+  }
+  if (auto stop_bits = config.getStopBits()) {
+    applyStopBits(options, *stop_bits);
+  }
+  if (auto mode = config.getCanonicalMode()) {
+    applyCanonicalMode(options, *mode);
+  }
+  // In low latency mode VMIN/VTIME stay zero and the new values are
+  // kept for setLowLatencyMode(false)
+  cc_t vtime = low_latency_ ? saved_vtime_ : options.c_cc[VTIME];
+  cc_t vmin = low_latency_ ? saved_vmin_ : options.c_cc[VMIN];
+  if (auto timeout = config.getReadTimeout()) {
+    vtime = static_cast<cc_t>(timeout->count() / 100);
+  }
+  if (auto num = config.getMinNumberCharRead()) {
+    vmin = static_cast<cc_t>(*num);
+  }
+  if (!low_latency_) {
+    options.c_cc[VTIME] = vtime;
+    options.c_cc[VMIN] = vmin;
+  }
+
+  this->setTermios2(options);
+
+  // Mirror the applied values only once the kernel accepted them
+  if (low_latency_) {
+    saved_vtime_ = vtime;
+    saved_vmin_ = vmin;
+  }
+  if (auto mode = config.getCanonicalMode()) {
+    canonical_mode_ = *mode;
+  }
+  if (auto timeout = config.getReadTimeout()) {
+    read_timeout_ms_ = *timeout;
+  }
+  if (auto timeout = config.getWriteTimeout()) {
+    write_timeout_ms_ = *timeout;
+  }
+  if (auto num = config.getMinNumberCharRead()) {
+    min_number_char_read_ = *num;
+  }
 }
 
 void Serial::setMaxSafeReadSize(size_t size) {
@@ -350,21 +1424,57 @@ size_t Serial::getMaxSafeReadSize() const {
   return max_safe_read_size_;
 }
 
+SerialStats Serial::getStats() const {
+  return stats_.snapshot();
+}
+
+void Serial::resetStats() {
+  stats_.reset();
+}
+
+void Serial::setCapture(std::shared_ptr<CaptureWriter> writer) {
+  if (reader_thread_.joinable()) {
+    throw SerialException("Cannot change capture while the reader thread is running");
+  }
+  capture_ = std::move(writer);
+}
+
+const std::shared_ptr<CaptureWriter>& Serial::getCapture() const {
+  return capture_;
+}
+
+void Serial::setTap(std::shared_ptr<TrafficTap> tap) {
+  if (reader_thread_.joinable()) {
+    throw SerialException("Cannot change tap while the reader thread is running");
+  }
+  tap_ = std::move(tap);
+}
+
+const std::shared_ptr<TrafficTap>& Serial::getTap() const {
+  return tap_;
+}
+
 int Serial::getAvailableData() const {
   int bytes_available;
-  if (ioctl_(fd_serial_port_, FIONREAD, &bytes_available) < 0) {
+  if (this->callIoctl(FIONREAD, &bytes_available) < 0) {
     throw SerialException("Error getting available data: " + std::string(strerror(errno)));
   }
-  return bytes_available;
+  return bytes_available + static_cast<int>(this->rxAvailable());
+}
+
+Terminator Serial::getTerminator() const {
+  return terminator_;
+}
+
+int Serial::getFileDescriptor() const {
+  return fd_serial_port_;
 }
 
 int Serial::getBaudRate() const {
-  this->getTermios2();
   return (static_cast<int>(options_.c_ispeed));
 }
 
 DataLength Serial::getDataLength() const {
-  this->getTermios2();
   switch (options_.c_cflag & CSIZE) {
   case CS5: return DataLength::FIVE;
   case CS6: return DataLength::SIX;
@@ -375,17 +1485,22 @@ DataLength Serial::getDataLength() const {
 }
 
 std::chrono::milliseconds Serial::getReadTimeout() const {
-  this->getTermios2();
-  return std::chrono::milliseconds(options_.c_cc[VTIME] * 100);
+  cc_t vtime = low_latency_ ? saved_vtime_ : options_.c_cc[VTIME];
+  return std::chrono::milliseconds(vtime * 100);
 }
 
 uint16_t Serial::getMinNumberCharRead() const {
+  return static_cast<uint16_t>(low_latency_ ? saved_vmin_ : options_.c_cc[VMIN]);
+}
+
+void Serial::refreshConfig() {
   this->getTermios2();
-  return static_cast<uint16_t>(options_.c_cc[VMIN]);
+  canonical_mode_ = (options_.c_lflag & ICANON) ? CanonicalMode::ENABLE : CanonicalMode::DISABLE;
+  min_number_char_read_ = this->getMinNumberCharRead();
 }
 
-void Serial::getTermios2() const {
-  ssize_t error = ioctl_(fd_serial_port_, TCGETS2, &options_);
+void Serial::getTermios2() {
+  ssize_t error = this->callIoctl(TCGETS2, &options_);
   if (error < 0) {
     throw SerialException("Error get Termios2: " + std::string(strerror(errno)));
   }
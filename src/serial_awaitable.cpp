@@ -0,0 +1,172 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/serial_awaitable.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include <string>
+#include <utility>
+
+#include "libserial/byte_scan.hpp"
+#include "libserial/serial.hpp"
+#include "libserial/serial_exception.hpp"
+#include "libserial/serial_executor.hpp"
+
+namespace libserial {
+
+SerialAwaitable::SerialAwaitable(Serial& serial, bool write)
+  : serial_(serial), write_(write) {
+}
+
+void SerialAwaitable::rethrowIfFailed() const {
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+bool SerialAwaitable::tryComplete() {
+  try {
+    return this->step();
+  }
+  catch (...) {
+    error_ = std::current_exception();
+    return true;
+  }
+}
+
+void SerialAwaitable::suspend(void* handle, void (*resume)(void*)) {
+  executor_ = SerialExecutor::current();
+  if (executor_ == nullptr) {
+    throw SerialException("Serial awaitables must be awaited from a SerialExecutor");
+  }
+
+  handle_ = handle;
+  resume_ = resume;
+  if (write_) {
+    executor_->waitWritable(serial_.getFileDescriptor(), &SerialAwaitable::onReady, this);
+  }
+  else {
+    executor_->waitReadable(serial_.getFileDescriptor(), &SerialAwaitable::onReady, this);
+  }
+}
+
+void SerialAwaitable::onReady(void* self, bool hung_up) {
+  auto* awaitable = static_cast<SerialAwaitable*>(self);
+
+  bool done = awaitable->tryComplete();
+  if (!done && hung_up) {
+    awaitable->error_ = std::make_exception_ptr(IOException("Serial port hung up"));
+    done = true;
+  }
+
+  if (done) {
+    awaitable->resume_(awaitable->handle_);
+    return;
+  }
+
+  // Partial progress: stay parked without waking the coroutine
+  try {
+    awaitable->suspend(awaitable->handle_, awaitable->resume_);
+  }
+  catch (...) {
+    awaitable->error_ = std::current_exception();
+    awaitable->resume_(awaitable->handle_);
+  }
+}
+
+ReadUntilAwaitable::ReadUntilAwaitable(Serial& serial, char terminator)
+  : SerialAwaitable(serial, false), terminator_(terminator) {
+}
+
+std::string ReadUntilAwaitable::await_resume() {
+  this->rethrowIfFailed();
+  return std::move(data_);
+}
+
+bool ReadUntilAwaitable::step() {
+  Serial& serial = serial_;
+  serial.setNonBlocking(true);
+
+  while (true) {
+    if (serial.rxAvailable() == 0) {
+      ssize_t bytes_read = serial.fillRxBuffer();
+      if (bytes_read < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+          return false;
+        }
+        throw IOException("Error reading from serial port: " + std::string(strerror(errno)));
+      }
+      if (bytes_read == 0) {
+        return false;
+      }
+    }
+
+    // Take up to the terminator; anything after it stays buffered
+    const char* begin = serial.rx_buffer_.data() + serial.rx_begin_;
+    const size_t available = serial.rxAvailable();
+    const char* found = findByte(begin, available, terminator_);
+    size_t take = found ? static_cast<size_t>(found - begin) + 1 : available;
+
+    if (data_.size() + take > serial.max_safe_read_size_) {
+      throw IOException("Read buffer exceeded maximum size limit of " +
+                        std::to_string(serial.max_safe_read_size_) +
+                        " bytes without finding terminator");
+    }
+    data_.append(begin, take);
+    serial.rx_begin_ += take;
+
+    if (found) {
+      return true;
+    }
+  }
+}
+
+ReadBytesAwaitable::ReadBytesAwaitable(Serial& serial, size_t num_bytes)
+  : SerialAwaitable(serial, false), num_bytes_(num_bytes) {
+  data_.reserve(num_bytes);
+}
+
+std::string ReadBytesAwaitable::await_resume() {
+  this->rethrowIfFailed();
+  return std::move(data_);
+}
+
+bool ReadBytesAwaitable::step() {
+  while (data_.size() < num_bytes_) {
+    // Read straight into the result
+    size_t filled = data_.size();
+    data_.resize(num_bytes_);
+    size_t bytes_read = serial_.readAvailable(&data_[filled], num_bytes_ - filled);
+    data_.resize(filled + bytes_read);
+    if (bytes_read == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+WriteAwaitable::WriteAwaitable(Serial& serial, const void* data, size_t size)
+  : SerialAwaitable(serial, true), data_(static_cast<const char*>(data)), size_(size) {
+  if (!data) {
+    throw IOException("Null pointer passed to asyncWrite function");
+  }
+}
+
+size_t WriteAwaitable::await_resume() {
+  this->rethrowIfFailed();
+  return written_;
+}
+
+bool WriteAwaitable::step() {
+  while (written_ < size_) {
+    size_t bytes = serial_.writeAvailable(data_ + written_, size_ - written_);
+    if (bytes == 0) {
+      return false;
+    }
+    written_ += bytes;
+  }
+  return true;
+}
+
+}  // namespace libserial
@@ -0,0 +1,79 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#include "libserial/serial_config.hpp"
+
+namespace libserial {
+
+void SerialConfig::setBaudRate(unsigned int baud_rate) {
+  baud_rate_ = baud_rate;
+}
+
+void SerialConfig::setBaudRate(BaudRate baud_rate) {
+  baud_rate_ = static_cast<unsigned int>(baud_rate);
+}
+
+void SerialConfig::setDataLength(DataLength nbits) {
+  data_length_ = nbits;
+}
+
+void SerialConfig::setParity(Parity parity) {
+  parity_ = parity;
+}
+
+void SerialConfig::setStopBits(StopBits stop_bits) {
+  stop_bits_ = stop_bits;
+}
+
+void SerialConfig::setCanonicalMode(CanonicalMode mode) {
+  canonical_mode_ = mode;
+}
+
+void SerialConfig::setReadTimeout(std::chrono::milliseconds timeout) {
+  read_timeout_ = timeout;
+}
+
+void SerialConfig::setWriteTimeout(std::chrono::milliseconds timeout) {
+  write_timeout_ = timeout;
+}
+
+void SerialConfig::setMinNumberCharRead(uint16_t num) {
+  min_number_char_read_ = num;
+}
+
+std::optional<unsigned int> SerialConfig::getBaudRate() const {
+  return baud_rate_;
+}
+
+std::optional<DataLength> SerialConfig::getDataLength() const {
+  return data_length_;
+}
+
+std::optional<Parity> SerialConfig::getParity() const {
+  return parity_;
+}
+
+std::optional<StopBits> SerialConfig::getStopBits() const {
+  return stop_bits_;
+}
+
+std::optional<CanonicalMode> SerialConfig::getCanonicalMode() const {
+  return canonical_mode_;
+}
+
+std::optional<std::chrono::milliseconds> SerialConfig::getReadTimeout() const {
+  return read_timeout_;
+}
+
+std::optional<std::chrono::milliseconds> SerialConfig::getWriteTimeout() const {
+  return write_timeout_;
+}
+
+std::optional<uint16_t> SerialConfig::getMinNumberCharRead() const {
+  return min_number_char_read_;
+}
+
+}  // namespace libserial
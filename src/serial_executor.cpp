@@ -0,0 +1,245 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/serial_executor.hpp"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include <string>
+
+#include "libserial/serial_exception.hpp"
+
+namespace libserial {
+
+namespace {
+
+thread_local SerialExecutor* current_executor = nullptr;
+
+// Marks the executor as current for the duration of a runOnce() call
+class CurrentGuard {
+public:
+explicit CurrentGuard(SerialExecutor* executor)
+  : previous_(current_executor) {
+  current_executor = executor;
+}
+
+~CurrentGuard() {
+  current_executor = previous_;
+}
+
+private:
+SerialExecutor* previous_;
+};
+
+}  // namespace
+
+SerialExecutor::SerialExecutor() {
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epoll_fd_ < 0 || wake_fd_ < 0) {
+    std::string error = strerror(errno);
+    if (epoll_fd_ != -1) ::close(epoll_fd_);
+    if (wake_fd_ != -1) ::close(wake_fd_);
+    throw SerialException("Error creating executor: " + error);
+  }
+
+  struct epoll_event event {};
+  event.events = EPOLLIN;
+  event.data.fd = wake_fd_;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event) < 0) {
+    std::string error = strerror(errno);
+    ::close(epoll_fd_);
+    ::close(wake_fd_);
+    throw SerialException("Error creating executor: " + error);
+  }
+}
+
+SerialExecutor::~SerialExecutor() {
+  ::close(epoll_fd_);
+  ::close(wake_fd_);
+}
+
+SerialExecutor* SerialExecutor::current() {
+  return current_executor;
+}
+
+void SerialExecutor::waitReadable(int fd, ResumeFunction resume, void* context) {
+  this->wait(fd, false, resume, context);
+}
+
+void SerialExecutor::waitWritable(int fd, ResumeFunction resume, void* context) {
+  this->wait(fd, true, resume, context);
+}
+
+void SerialExecutor::wait(int fd, bool write, ResumeFunction resume, void* context) {
+  FdState& state = fds_[fd];
+  Waiter& waiter = write ? state.writer : state.reader;
+  if (waiter.resume != nullptr) {
+    throw SerialException(std::string("Another ") + (write ? "write" : "read") +
+                          " is already pending on this descriptor");
+  }
+
+  waiter.resume = resume;
+  waiter.context = context;
+  pending_waits_++;
+  if (!state.dirty) {
+    state.dirty = true;
+    dirty_.push_back(fd);
+  }
+}
+
+void SerialExecutor::post(ResumeFunction resume, void* context) {
+  posted_.push_back(Waiter{resume, context, false});
+}
+
+void SerialExecutor::syncInterest() {
+  for (int fd : dirty_) {
+    auto it = fds_.find(fd);
+    if (it == fds_.end()) {
+      continue;
+    }
+    FdState& state = it->second;
+    state.dirty = false;
+
+    uint32_t wanted = (state.reader.resume ? static_cast<uint32_t>(EPOLLIN) : 0u) |
+                      (state.writer.resume ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    if (wanted == state.events) {
+      if (wanted == 0) {
+        fds_.erase(it);
+      }
+      continue;
+    }
+
+    if (wanted == 0) {
+      epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+      fds_.erase(it);
+      continue;
+    }
+
+    struct epoll_event event {};
+    event.events = wanted;
+    event.data.fd = fd;
+    int op = state.events == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+    int result = epoll_ctl(epoll_fd_, op, fd, &event);
+    // The descriptor may have been closed and reused behind our back
+    if (result < 0 && errno == ENOENT) {
+      result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+    }
+    else if (result < 0 && errno == EEXIST) {
+      result = epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event);
+    }
+    if (result < 0) {
+      // Resume the waiters as hung up rather than parking them forever
+      for (Waiter* waiter : {&state.reader, &state.writer}) {
+        if (waiter->resume) {
+          posted_.push_back(Waiter{waiter->resume, waiter->context, true});
+          *waiter = Waiter{};
+          pending_waits_--;
+        }
+      }
+      fds_.erase(it);
+      continue;
+    }
+    state.events = wanted;
+  }
+  dirty_.clear();
+}
+
+size_t SerialExecutor::runOnce(std::chrono::milliseconds timeout) {
+  CurrentGuard guard(this);
+  this->syncInterest();
+
+  size_t resumed = 0;
+
+  // Continuations posted before this iteration run first, without waiting
+  size_t ready = posted_.size();
+  for (size_t i = 0; i < ready; ++i) {
+    Waiter waiter = posted_.front();
+    posted_.pop_front();
+    waiter.resume(waiter.context, waiter.hung_up);
+    resumed++;
+  }
+  if (resumed > 0 || !posted_.empty()) {
+    timeout = std::chrono::milliseconds(0);
+  }
+  this->syncInterest();
+
+  struct epoll_event events[kMaxEvents];
+  int timeout_ms = timeout.count() < 0 ? -1 : static_cast<int>(timeout.count());
+  int count = epoll_wait(epoll_fd_, events, kMaxEvents, timeout_ms);
+  if (count < 0) {
+    if (errno == EINTR) {
+      return resumed;
+    }
+    throw SerialException("Error in epoll_wait(): " + std::string(strerror(errno)));
+  }
+
+  for (int i = 0; i < count; ++i) {
+    int fd = events[i].data.fd;
+    if (fd == wake_fd_) {
+      uint64_t value;
+      while (::read(wake_fd_, &value, sizeof(value)) > 0) {
+      }
+      continue;
+    }
+
+    auto it = fds_.find(fd);
+    if (it == fds_.end()) {
+      continue;
+    }
+
+    // Detach before resuming: the continuation may wait again on the same fd
+    const uint32_t revents = events[i].events;
+    const bool hung_up = revents & (EPOLLHUP | EPOLLERR);
+    Waiter reader;
+    Waiter writer;
+    if (it->second.reader.resume && (revents & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+      reader = it->second.reader;
+      it->second.reader = Waiter{};
+      pending_waits_--;
+    }
+    if (it->second.writer.resume && (revents & (EPOLLOUT | EPOLLHUP | EPOLLERR))) {
+      writer = it->second.writer;
+      it->second.writer = Waiter{};
+      pending_waits_--;
+    }
+    if (!it->second.dirty) {
+      it->second.dirty = true;
+      dirty_.push_back(fd);
+    }
+
+    if (reader.resume) {
+      reader.resume(reader.context, hung_up);
+      resumed++;
+    }
+    if (writer.resume) {
+      writer.resume(writer.context, hung_up);
+      resumed++;
+    }
+  }
+
+  return resumed;
+}
+
+void SerialExecutor::run() {
+  while (!stop_requested_ && this->getPendingCount() > 0) {
+    this->runOnce(std::chrono::milliseconds(-1));
+  }
+  stop_requested_ = false;
+}
+
+void SerialExecutor::stop() {
+  stop_requested_ = true;
+  uint64_t value = 1;
+  ssize_t result = ::write(wake_fd_, &value, sizeof(value));
+  (void)result;
+}
+
+size_t SerialExecutor::getPendingCount() const {
+  return pending_waits_ + posted_.size();
+}
+
+}  // namespace libserial
@@ -0,0 +1,775 @@
+// @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/serial_reactor.hpp"
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "libserial/byte_scan.hpp"
+
+namespace libserial {
+
+namespace {
+
+// io_uring user data: a Port pointer (8-byte aligned) with the operation in the low bits
+constexpr uint64_t kTagMask = 0x7;
+constexpr uint64_t kTagPollIn = 1;
+constexpr uint64_t kTagRead = 2;
+constexpr uint64_t kTagPollOut = 3;
+constexpr uint64_t kTagWrite = 4;
+constexpr uint64_t kTagTimer = 5;
+constexpr uint64_t kTagWake = 6;
+constexpr uint64_t kTagCancel = 7;
+
+uint64_t userData(const void* port, uint64_t tag) {
+  return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(port)) | tag;
+}
+
+}  // namespace
+
+SerialReactor::SerialReactor(ReactorBackend backend)
+  : read_buffer_(kReadBufferSize) {
+  timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (timer_fd_ < 0 || wake_fd_ < 0) {
+    std::string error = strerror(errno);
+    this->closeDescriptors();
+    throw SerialException("Error creating reactor: " + error);
+  }
+
+  if (backend == ReactorBackend::IO_URING && this->initUring()) {
+    backend_ = ReactorBackend::IO_URING;
+    return;
+  }
+
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd_ < 0) {
+    std::string error = strerror(errno);
+    this->closeDescriptors();
+    throw SerialException("Error creating reactor: " + error);
+  }
+
+  for (int fd : {timer_fd_, wake_fd_}) {
+    struct epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+      std::string error = strerror(errno);
+      this->closeDescriptors();
+      throw SerialException("Error creating reactor: " + error);
+    }
+  }
+}
+
+SerialReactor::~SerialReactor() {
+  if (ring_) {
+    // Reap every in-flight operation before its buffers go away
+    while (!ports_.empty()) {
+      this->removePort(*ports_.begin()->second->serial);
+    }
+    try {
+      for (int attempt = 0; attempt < 100 && !retired_.empty(); ++attempt) {
+        ring_->submitAndWait(1, std::chrono::milliseconds(10));
+        ring_->forEachCompletion([this](const struct io_uring_cqe& cqe) {
+            this->handleCompletion(cqe);
+          });
+      }
+    }
+    catch (const SerialException&) {
+    }
+    ring_.reset();
+  }
+  this->closeDescriptors();
+}
+
+bool SerialReactor::initUring() {
+  try {
+    ring_ = std::make_unique<IoUring>(kUringEntries);
+  }
+  catch (const SerialException&) {
+    return false;
+  }
+
+  // Registered buffers are an optimization; plain reads are used if refused
+  buffer_arena_.resize(kUringBufferSlots * kReadBufferSize);
+  std::vector<struct iovec> slots(kUringBufferSlots);
+  for (int i = 0; i < kUringBufferSlots; ++i) {
+    slots[i].iov_base = buffer_arena_.data() + i * kReadBufferSize;
+    slots[i].iov_len = kReadBufferSize;
+  }
+  if (ring_->registerBuffers(slots.data(), kUringBufferSlots)) {
+    for (int i = kUringBufferSlots - 1; i >= 0; --i) {
+      free_slots_.push_back(i);
+    }
+  }
+  else {
+    buffer_arena_.clear();
+    buffer_arena_.shrink_to_fit();
+  }
+  return true;
+}
+
+void SerialReactor::closeDescriptors() {
+  for (int* fd : {&epoll_fd_, &timer_fd_, &wake_fd_}) {
+    if (*fd != -1) {
+      ::close(*fd);
+      *fd = -1;
+    }
+  }
+}
+
+void SerialReactor::addPort(Serial& serial, PortHandlers handlers) {
+  int fd = serial.getFileDescriptor();
+  if (fd < 0) {
+    throw SerialException("Cannot register a serial port that is not open");
+  }
+  if (ports_.count(fd) != 0) {
+    throw SerialException("Serial port is already registered with the reactor");
+  }
+
+  auto port = std::make_shared<Port>();
+  port->serial = &serial;
+  port->fd = fd;
+  port->handlers = std::move(handlers);
+  if (port->handlers.read_timeout.count() > 0) {
+    port->read_deadline = std::chrono::steady_clock::now() + port->handlers.read_timeout;
+  }
+
+  if (ring_) {
+    // io_uring issues the reads and writes itself, they must never block
+    serial.setNonBlocking(true);
+    if (!free_slots_.empty()) {
+      port->buffer_slot = free_slots_.back();
+      free_slots_.pop_back();
+      port->read_data = buffer_arena_.data() + port->buffer_slot * kReadBufferSize;
+    }
+    else {
+      port->own_buffer.resize(kReadBufferSize);
+      port->read_data = port->own_buffer.data();
+    }
+  }
+  else {
+    struct epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    syscalls_++;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+      throw SerialException("Error registering serial port: " + std::string(strerror(errno)));
+    }
+  }
+
+  ports_.emplace(fd, port);
+  this->armTimer();
+
+  // Bytes an earlier readBytes() or readUntil() pulled into the receive
+  // buffer never show up on the descriptor again
+  this->deliverBuffered(port);
+  if (ring_ && !port->removed) {
+    this->armRead(*port);
+  }
+}
+
+void SerialReactor::removePort(Serial& serial) {
+  auto it = std::find_if(ports_.begin(), ports_.end(),
+                         [&serial](const auto& entry) {
+      return entry.second->serial == &serial;
+    });
+  if (it == ports_.end()) {
+    return;
+  }
+
+  // Handlers still running for this port hold their own reference
+  std::shared_ptr<Port> port = it->second;
+  port->removed = true;
+  ports_.erase(it);
+
+  if (ring_) {
+    if (port->pending_ops > 0) {
+      for (uint64_t tag : {kTagPollIn, kTagRead, kTagPollOut, kTagWrite}) {
+        this->cancelOperation(userData(port.get(), tag));
+      }
+      retired_.push_back(port);
+    }
+    else {
+      this->releaseUringPort(port.get());
+    }
+  }
+  else {
+    syscalls_++;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, port->fd, nullptr);
+  }
+  this->armTimer();
+}
+
+void SerialReactor::send(Serial& serial, const void* data, size_t size) {
+  auto it = ports_.find(serial.getFileDescriptor());
+  if (it == ports_.end() || it->second->serial != &serial) {
+    throw SerialException("Serial port is not registered with the reactor");
+  }
+  Port& port = *it->second;
+
+  if (ring_) {
+    if (!port.want_write) {
+      port.want_write = true;
+      if (port.handlers.write_timeout.count() > 0) {
+        port.write_deadline = std::chrono::steady_clock::now() + port.handlers.write_timeout;
+      }
+    }
+    port.tx_queue.append(static_cast<const char*>(data), size);
+    this->armWrite(port);
+    this->armTimer();
+    return;
+  }
+
+  // Preserve ordering: only write directly when nothing is queued
+  size_t written = 0;
+  if (port.tx_offset == port.tx_queue.size()) {
+    syscalls_++;
+    written = serial.writeAvailable(data, size);
+  }
+  if (written == size) {
+    return;
+  }
+
+  if (port.tx_offset == port.tx_queue.size()) {
+    port.tx_queue.clear();
+    port.tx_offset = 0;
+    if (port.handlers.write_timeout.count() > 0) {
+      port.write_deadline = std::chrono::steady_clock::now() + port.handlers.write_timeout;
+    }
+  }
+  port.tx_queue.append(static_cast<const char*>(data) + written, size - written);
+
+  if (!port.want_write) {
+    port.want_write = true;
+    this->updateInterest(port);
+    this->armTimer();
+  }
+}
+
+size_t SerialReactor::runOnce(std::chrono::milliseconds timeout) {
+  if (ring_) {
+    return this->runOnceUring(timeout);
+  }
+
+  struct epoll_event events[kMaxEvents];
+
+  int timeout_ms = timeout.count() < 0 ? -1 : static_cast<int>(timeout.count());
+  syscalls_++;
+  int count = epoll_wait(epoll_fd_, events, kMaxEvents, timeout_ms);
+  if (count < 0) {
+    if (errno == EINTR) {
+      return 0;
+    }
+    throw SerialException("Error in epoll_wait(): " + std::string(strerror(errno)));
+  }
+
+  size_t dispatched = 0;
+  for (int i = 0; i < count; ++i) {
+    int fd = events[i].data.fd;
+
+    if (fd == wake_fd_) {
+      uint64_t value;
+      syscalls_++;
+      while (::read(wake_fd_, &value, sizeof(value)) > 0) {
+      }
+      continue;
+    }
+    if (fd == timer_fd_) {
+      uint64_t expirations;
+      syscalls_++;
+      while (::read(timer_fd_, &expirations, sizeof(expirations)) > 0) {
+      }
+      timer_deadline_ = std::chrono::steady_clock::time_point::max();
+      this->handleTimers();
+      continue;
+    }
+
+    auto it = ports_.find(fd);
+    if (it == ports_.end()) {
+      continue;  // Removed by an earlier handler in this batch
+    }
+    std::shared_ptr<Port> port = it->second;
+    dispatched++;
+
+    if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+      this->handleReadable(port);
+    }
+    if (!port->removed && (events[i].events & (EPOLLHUP | EPOLLERR))) {
+      this->failPort(port, IOException("Serial port hung up"));
+    }
+    if (!port->removed && (events[i].events & EPOLLOUT)) {
+      this->handleWritable(port);
+    }
+  }
+
+  this->armTimer();
+  return dispatched;
+}
+
+void SerialReactor::run() {
+  while (!stop_requested_) {
+    this->runOnce(std::chrono::milliseconds(-1));
+  }
+  stop_requested_ = false;
+}
+
+void SerialReactor::stop() {
+  stop_requested_ = true;
+  uint64_t value = 1;
+  ssize_t result = ::write(wake_fd_, &value, sizeof(value));
+  (void)result;
+}
+
+size_t SerialReactor::getPortCount() const {
+  return ports_.size();
+}
+
+ReactorBackend SerialReactor::getBackend() const {
+  return backend_;
+}
+
+uint64_t SerialReactor::getSystemCallCount() const {
+  return syscalls_;
+}
+
+void SerialReactor::handleReadable(const std::shared_ptr<Port>& port) {
+  while (!port->removed) {
+    size_t bytes_read = 0;
+    try {
+      syscalls_++;
+      bytes_read = port->serial->readAvailable(read_buffer_.data(), read_buffer_.size());
+    }
+    catch (const SerialException& e) {
+      this->failPort(port, e);
+      return;
+    }
+
+    if (bytes_read == 0) {
+      break;
+    }
+    this->deliver(port, read_buffer_.data(), bytes_read);
+  }
+}
+
+void SerialReactor::deliverBuffered(const std::shared_ptr<Port>& port) {
+  Serial& serial = *port->serial;
+  while (serial.rxAvailable() > 0 && !port->removed) {
+    size_t bytes = serial.takeRx(read_buffer_.data(), read_buffer_.size());
+    this->deliver(port, read_buffer_.data(), bytes);
+  }
+}
+
+void SerialReactor::deliver(const std::shared_ptr<Port>& port, const char* data, size_t size) {
+  Serial& serial = *port->serial;
+
+  if (port->handlers.read_timeout.count() > 0) {
+    port->read_deadline = std::chrono::steady_clock::now() + port->handlers.read_timeout;
+  }
+
+  if (port->handlers.on_data) {
+    port->handlers.on_data(serial, data, size);
+  }
+
+  if (port->removed || !port->handlers.on_line) {
+    return;
+  }
+
+  const char terminator = static_cast<char>(serial.getTerminator());
+  const size_t max_line = serial.getMaxSafeReadSize();
+
+  // Reassemble lines; the partial tail stays in port->line for the next wakeup
+  const char* end = data + size;
+  while (data < end && !port->removed) {
+    const char* found = findByte(data, static_cast<size_t>(end - data), terminator);
+    const char* stop = found ? found + 1 : end;
+
+    if (port->line.size() + static_cast<size_t>(stop - data) > max_line) {
+      port->line.clear();
+      if (port->handlers.on_error) {
+        port->handlers.on_error(serial, IOException(
+                                  "Read buffer exceeded maximum size limit of " +
+                                  std::to_string(max_line) +
+                                  " bytes without finding terminator"));
+      }
+      data = stop;
+      continue;
+    }
+
+    port->line.append(data, static_cast<size_t>(stop - data));
+    data = stop;
+    if (found) {
+      port->handlers.on_line(serial, port->line);
+      port->line.clear();
+    }
+  }
+}
+
+void SerialReactor::handleWritable(const std::shared_ptr<Port>& port) {
+  while (port->tx_offset < port->tx_queue.size()) {
+    size_t written = 0;
+    try {
+      syscalls_++;
+      written = port->serial->writeAvailable(port->tx_queue.data() + port->tx_offset,
+                                             port->tx_queue.size() - port->tx_offset);
+    }
+    catch (const SerialException& e) {
+      this->failPort(port, e);
+      return;
+    }
+    if (written == 0) {
+      return;  // Queue full again, wait for the next EPOLLOUT
+    }
+    port->tx_offset += written;
+  }
+
+  port->tx_queue.clear();
+  port->tx_offset = 0;
+  port->want_write = false;
+  this->updateInterest(*port);
+}
+
+void SerialReactor::handleTimers() {
+  auto now = std::chrono::steady_clock::now();
+
+  // Copy first: handlers may add or remove ports
+  std::vector<std::shared_ptr<Port>> ports;
+  ports.reserve(ports_.size());
+  for (const auto& entry : ports_) {
+    ports.push_back(entry.second);
+  }
+
+  for (const auto& port : ports) {
+    if (port->removed) {
+      continue;
+    }
+
+    if (port->want_write && port->handlers.write_timeout.count() > 0 &&
+        port->write_deadline <= now) {
+      size_t dropped = this->dropOutput(*port);
+      if (port->handlers.on_write_timeout) {
+        port->handlers.on_write_timeout(*port->serial, dropped);
+      }
+    }
+
+    if (!port->removed && port->handlers.read_timeout.count() > 0 &&
+        port->read_deadline <= now) {
+      port->read_deadline = now + port->handlers.read_timeout;
+      if (port->handlers.on_read_timeout) {
+        port->handlers.on_read_timeout(*port->serial);
+      }
+    }
+  }
+}
+
+size_t SerialReactor::dropOutput(Port& port) {
+  size_t dropped = port.tx_queue.size() - (ring_ ? 0 : port.tx_offset);
+  port.tx_queue.clear();
+  port.want_write = false;
+
+  if (!ring_) {
+    port.tx_offset = 0;
+    this->updateInterest(port);
+    return dropped;
+  }
+
+  dropped += port.tx_inflight.size() - port.tx_offset;
+  if (port.write_armed) {
+    // The buffer stays alive until the cancelled write completes
+    port.tx_cancelled = true;
+    this->cancelOperation(userData(&port, kTagPollOut));
+    this->cancelOperation(userData(&port, kTagWrite));
+  }
+  else {
+    port.tx_inflight.clear();
+    port.tx_offset = 0;
+  }
+  return dropped;
+}
+
+void SerialReactor::failPort(const std::shared_ptr<Port>& port, const SerialException& error) {
+  Serial& serial = *port->serial;
+  auto handler = port->handlers.on_error;
+  this->removePort(serial);
+  if (handler) {
+    handler(serial, error);
+  }
+}
+
+void SerialReactor::updateInterest(const Port& port) {
+  struct epoll_event event {};
+  event.events = EPOLLIN | (port.want_write ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+  event.data.fd = port.fd;
+  syscalls_++;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, port.fd, &event);
+}
+
+void SerialReactor::armTimer() {
+  bool pending = false;
+  std::chrono::steady_clock::time_point earliest = std::chrono::steady_clock::time_point::max();
+
+  for (const auto& entry : ports_) {
+    const Port& port = *entry.second;
+    if (port.handlers.read_timeout.count() > 0) {
+      earliest = std::min(earliest, port.read_deadline);
+      pending = true;
+    }
+    if (port.want_write && port.handlers.write_timeout.count() > 0) {
+      earliest = std::min(earliest, port.write_deadline);
+      pending = true;
+    }
+  }
+
+  // Skip the system call when the earliest deadline did not move
+  if (earliest == timer_deadline_) {
+    return;
+  }
+  timer_deadline_ = earliest;
+
+  struct itimerspec spec {};
+  if (pending) {
+    auto delay = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      earliest - std::chrono::steady_clock::now()).count();
+    // A zero it_value disarms the timer, so overdue deadlines fire after 1ns
+    delay = std::max<int64_t>(delay, 1);
+    spec.it_value.tv_sec = static_cast<time_t>(delay / 1000000000);
+    spec.it_value.tv_nsec = static_cast<long>(delay % 1000000000);  // NOLINT
+  }
+  syscalls_++;
+  timerfd_settime(timer_fd_, 0, &spec, nullptr);
+}
+
+size_t SerialReactor::runOnceUring(std::chrono::milliseconds timeout) {
+  if (!timer_armed_) {
+    this->armInternalPoll(timer_fd_, kTagTimer);
+    timer_armed_ = true;
+  }
+  if (!wake_armed_) {
+    this->armInternalPoll(wake_fd_, kTagWake);
+    wake_armed_ = true;
+  }
+
+  // All reads and writes queued since the last call go out in one io_uring_enter
+  syscalls_++;
+  ring_->submitAndWait(timeout.count() == 0 ? 0 : 1, timeout);
+
+  size_t dispatched = 0;
+  ring_->forEachCompletion([this, &dispatched](const struct io_uring_cqe& cqe) {
+      dispatched += this->handleCompletion(cqe);
+    });
+
+  this->armTimer();
+  return dispatched;
+}
+
+size_t SerialReactor::handleCompletion(const struct io_uring_cqe& cqe) {
+  const uint64_t tag = cqe.user_data & kTagMask;
+  Port* raw = reinterpret_cast<Port*>(static_cast<uintptr_t>(cqe.user_data & ~kTagMask));
+
+  if (raw == nullptr) {
+    uint64_t value;
+    if (tag == kTagWake) {
+      wake_armed_ = false;
+      syscalls_++;
+      while (::read(wake_fd_, &value, sizeof(value)) > 0) {
+      }
+    }
+    else if (tag == kTagTimer) {
+      timer_armed_ = false;
+      syscalls_++;
+      while (::read(timer_fd_, &value, sizeof(value)) > 0) {
+      }
+      timer_deadline_ = std::chrono::steady_clock::time_point::max();
+      this->handleTimers();
+    }
+    return 0;
+  }
+
+  std::shared_ptr<Port> port = raw->shared_from_this();
+  port->pending_ops--;
+  size_t dispatched = 0;
+
+  switch (tag) {
+    case kTagPollIn:
+      if (cqe.res < 0 && cqe.res != -ECANCELED && !port->removed) {
+        this->failPort(port, IOException("Error in poll(): " + std::string(strerror(-cqe.res))));
+      }
+      else if (cqe.res > 0 && (cqe.res & (POLLHUP | POLLERR))) {
+        port->hung_up = true;
+      }
+      break;
+
+    case kTagRead:
+      port->read_armed = false;
+      if (port->removed) {
+        break;
+      }
+      dispatched = 1;
+      if (cqe.res > 0) {
+        // The ring reads the descriptor directly, bypassing Serial's call helpers
+        port->serial->recordExternalIo(CaptureDirection::RX, port->read_data,
+                                       static_cast<size_t>(cqe.res));
+        this->deliver(port, port->read_data, static_cast<size_t>(cqe.res));
+      }
+      else if (cqe.res < 0 && cqe.res != -EAGAIN && cqe.res != -EINTR &&
+               cqe.res != -ECANCELED) {
+        this->failPort(port, IOException("Error reading from serial port: " +
+                                         std::string(strerror(-cqe.res))));
+        break;
+      }
+      if (port->hung_up && !port->removed) {
+        this->failPort(port, IOException("Serial port hung up"));
+      }
+      else {
+        this->armRead(*port);
+      }
+      break;
+
+    case kTagWrite:
+      port->write_armed = false;
+      if (port->tx_cancelled) {
+        port->tx_cancelled = false;
+        port->tx_inflight.clear();
+        port->tx_offset = 0;
+      }
+      else if (port->removed) {
+        break;
+      }
+      else if (cqe.res > 0) {
+        port->serial->recordExternalIo(CaptureDirection::TX,
+                                       port->tx_inflight.data() + port->tx_offset,
+                                       static_cast<size_t>(cqe.res));
+        port->tx_offset += static_cast<size_t>(cqe.res);
+        dispatched = 1;
+      }
+      else if (cqe.res < 0 && cqe.res != -EAGAIN && cqe.res != -EINTR &&
+               cqe.res != -ECANCELED) {
+        this->failPort(port, IOException("Error writing to serial port: " +
+                                         std::string(strerror(-cqe.res))));
+        break;
+      }
+      this->armWrite(*port);
+      break;
+
+    default:
+      break;
+  }
+
+  if (port->removed && port->pending_ops == 0) {
+    this->releaseUringPort(port.get());
+  }
+  return dispatched;
+}
+
+void SerialReactor::armRead(Port& port) {
+  if (port.read_armed || port.removed) {
+    return;
+  }
+
+  // Wait for POLLIN inside the kernel, then read into the port's buffer
+  struct io_uring_sqe* poll = this->reserveSqes(2);
+  poll->opcode = IORING_OP_POLL_ADD;
+  poll->fd = port.fd;
+  poll->poll32_events = POLLIN;
+  poll->flags = IOSQE_IO_LINK;
+  poll->user_data = userData(&port, kTagPollIn);
+
+  struct io_uring_sqe* read = ring_->getSqe();
+  read->opcode = port.buffer_slot >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+  read->fd = port.fd;
+  read->addr = reinterpret_cast<uint64_t>(port.read_data);
+  read->len = kReadBufferSize;
+  read->off = static_cast<uint64_t>(-1);
+  read->buf_index = static_cast<uint16_t>(std::max(port.buffer_slot, 0));
+  read->user_data = userData(&port, kTagRead);
+
+  port.read_armed = true;
+  port.pending_ops += 2;
+}
+
+void SerialReactor::armWrite(Port& port) {
+  if (port.write_armed || port.removed) {
+    return;
+  }
+
+  if (port.tx_offset == port.tx_inflight.size()) {
+    port.tx_inflight.clear();
+    port.tx_offset = 0;
+    port.tx_inflight.swap(port.tx_queue);
+  }
+  if (port.tx_inflight.empty()) {
+    port.want_write = false;
+    return;
+  }
+
+  // tx_inflight is not touched again until the write completes
+  struct io_uring_sqe* poll = this->reserveSqes(2);
+  poll->opcode = IORING_OP_POLL_ADD;
+  poll->fd = port.fd;
+  poll->poll32_events = POLLOUT;
+  poll->flags = IOSQE_IO_LINK;
+  poll->user_data = userData(&port, kTagPollOut);
+
+  struct io_uring_sqe* write = ring_->getSqe();
+  write->opcode = IORING_OP_WRITE;
+  write->fd = port.fd;
+  write->addr = reinterpret_cast<uint64_t>(port.tx_inflight.data() + port.tx_offset);
+  write->len = static_cast<uint32_t>(port.tx_inflight.size() - port.tx_offset);
+  write->off = static_cast<uint64_t>(-1);
+  write->user_data = userData(&port, kTagWrite);
+
+  port.write_armed = true;
+  port.pending_ops += 2;
+}
+
+void SerialReactor::armInternalPoll(int fd, uint64_t tag) {
+  struct io_uring_sqe* poll = this->reserveSqes(1);
+  poll->opcode = IORING_OP_POLL_ADD;
+  poll->fd = fd;
+  poll->poll32_events = POLLIN;
+  poll->user_data = userData(nullptr, tag);
+}
+
+void SerialReactor::cancelOperation(uint64_t user_data) {
+  struct io_uring_sqe* cancel = this->reserveSqes(1);
+  cancel->opcode = IORING_OP_ASYNC_CANCEL;
+  cancel->fd = -1;
+  cancel->addr = user_data;
+  cancel->user_data = userData(nullptr, kTagCancel);
+}
+
+struct io_uring_sqe* SerialReactor::reserveSqes(unsigned int count) {
+  // Linked entries must go to the kernel in the same submission
+  if (ring_->getFreeSqes() < count) {
+    syscalls_++;
+    ring_->submitAndWait(0, std::chrono::nanoseconds(0));
+  }
+  struct io_uring_sqe* sqe = ring_->getSqe();
+  if (sqe == nullptr) {
+    throw SerialException("io_uring submission queue is full");
+  }
+  return sqe;
+}
+
+void SerialReactor::releaseUringPort(Port* port) {
+  if (port->buffer_slot >= 0) {
+    free_slots_.push_back(port->buffer_slot);
+    port->buffer_slot = -1;
+  }
+  retired_.erase(std::remove_if(retired_.begin(), retired_.end(),
+                                [port](const std::shared_ptr<Port>& entry) {
+      return entry.get() == port;
+    }), retired_.end());
+}
+
+}  // namespace libserial
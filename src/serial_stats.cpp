@@ -0,0 +1,75 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/serial_stats.hpp"
+
+namespace libserial {
+
+uint64_t LatencyHistogram::getCount() const {
+  uint64_t count = 0;
+  for (uint64_t calls : buckets) {
+    count += calls;
+  }
+  return count;
+}
+
+std::chrono::nanoseconds LatencyHistogram::getPercentile(double percentile) const {
+  const uint64_t count = this->getCount();
+  if (count == 0) {
+    return std::chrono::nanoseconds(0);
+  }
+
+  // Rank of the call the percentile falls on, at least the first one
+  const double clamped = std::min(std::max(percentile, 0.0), 100.0);
+  const uint64_t rank = std::max<uint64_t>(
+    static_cast<uint64_t>(clamped / 100.0 * static_cast<double>(count) + 0.5), 1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return std::chrono::nanoseconds((uint64_t{2} << i) - 1);
+    }
+  }
+  return std::chrono::nanoseconds((uint64_t{2} << (kBuckets - 1)) - 1);
+}
+
+SerialStats StatsRecorder::snapshot() const {
+  SerialStats stats;
+#ifdef BUILD_STATS_ON
+  auto counter = [this](StatsCounter which) {
+      return counters_[static_cast<size_t>(which)].load(std::memory_order_relaxed);
+    };
+  stats.bytes_read = counter(StatsCounter::BYTES_READ);
+  stats.bytes_written = counter(StatsCounter::BYTES_WRITTEN);
+  stats.read_calls = counter(StatsCounter::READ_CALLS);
+  stats.write_calls = counter(StatsCounter::WRITE_CALLS);
+  stats.poll_calls = counter(StatsCounter::POLL_CALLS);
+  stats.ioctl_calls = counter(StatsCounter::IOCTL_CALLS);
+  stats.eagain_retries = counter(StatsCounter::EAGAIN_RETRIES);
+  stats.timeouts = counter(StatsCounter::TIMEOUTS);
+  stats.exceptions = counter(StatsCounter::EXCEPTIONS);
+
+  for (size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+    stats.read_latency.buckets[i] =
+      latencies_[static_cast<size_t>(StatsLatency::READ)][i].load(std::memory_order_relaxed);
+    stats.write_latency.buckets[i] =
+      latencies_[static_cast<size_t>(StatsLatency::WRITE)][i].load(std::memory_order_relaxed);
+  }
+#endif
+  return stats;
+}
+
+void StatsRecorder::reset() {
+#ifdef BUILD_STATS_ON
+  for (auto& counter : counters_) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+  for (auto& histogram : latencies_) {
+    for (auto& bucket : histogram) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+#endif
+}
+
+}  // namespace libserial
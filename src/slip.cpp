@@ -0,0 +1,139 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/slip.hpp"
+
+#include <cstring>
+#include <string>
+
+#include "libserial/serial.hpp"
+
+namespace libserial {
+
+namespace {
+
+// Wire bytes referenced by the write segments
+const uint8_t kEndByte[] = {SlipFramer::kEnd};
+const uint8_t kEscapedEnd[] = {SlipFramer::kEsc, SlipFramer::kEscEnd};
+const uint8_t kEscapedEsc[] = {SlipFramer::kEsc, SlipFramer::kEscEsc};
+
+struct iovec segment(const uint8_t* data, size_t size) {
+  return {const_cast<uint8_t*>(data), size};
+}
+
+}  // namespace
+
+SlipFramer::SlipFramer(Serial& serial, size_t max_frame_size)
+  : StreamFramer(serial, max_frame_size, kDefaultMaxFrameSize) {
+}
+
+size_t SlipFramer::writeFrame(const void* data, size_t size) {
+  if (!data && size > 0) {
+    throw IOException("Null pointer passed to writeFrame function");
+  }
+
+  struct iovec frame = segment(static_cast<const uint8_t*>(data), size);
+  return this->writeFrames(&frame, 1);
+}
+
+size_t SlipFramer::writeFrames(const struct iovec* frames, size_t count) {
+  if (!frames && count > 0) {
+    throw IOException("Null pointer passed to writeFrames function");
+  }
+
+  segments_.clear();
+  segments_.push_back(segment(kEndByte, 1));
+  for (size_t i = 0; i < count; ++i) {
+    const uint8_t* payload = static_cast<const uint8_t*>(frames[i].iov_base);
+    const size_t size = frames[i].iov_len;
+
+    // Runs of plain bytes stay in the caller's buffer; only escapes are substituted
+    size_t run_start = 0;
+    for (size_t pos = 0; pos < size; ++pos) {
+      if (payload[pos] != kEnd && payload[pos] != kEsc) {
+        continue;
+      }
+      if (pos > run_start) {
+        segments_.push_back(segment(payload + run_start, pos - run_start));
+      }
+      segments_.push_back(payload[pos] == kEnd ? segment(kEscapedEnd, 2) :
+                          segment(kEscapedEsc, 2));
+      run_start = pos + 1;
+    }
+    if (size > run_start) {
+      segments_.push_back(segment(payload + run_start, size - run_start));
+    }
+    segments_.push_back(segment(kEndByte, 1));
+  }
+
+  return serial_.writev(segments_.data(), segments_.size());
+}
+
+size_t SlipFramer::decode(const uint8_t* data, size_t size, bool* frame_done) {
+  size_t pos = 0;
+  while (pos < size) {
+    if (discarding_) {
+      const void* end = std::memchr(data + pos, kEnd, size - pos);
+      if (!end) {
+        return size;
+      }
+      pos = static_cast<size_t>(static_cast<const uint8_t*>(end) - data) + 1;
+      discarding_ = false;
+      continue;
+    }
+
+    if (escaped_) {
+      escaped_ = false;
+      const uint8_t byte = data[pos++];
+      if (byte != kEscEnd && byte != kEscEsc) {
+        // An END right after ESC still closes the frame, so nothing is skipped
+        this->dropFrame("SLIP frame has an invalid escape sequence", byte != kEnd);
+        continue;
+      }
+      const uint8_t value = byte == kEscEnd ? kEnd : kEsc;
+      if (!this->append(&value, 1)) {
+        this->dropFrame("SLIP frame exceeds maximum size of " +
+                        std::to_string(max_frame_size_) + " bytes", true);
+      }
+      continue;
+    }
+
+    // Copy the run of plain bytes up to the next END or ESC in one go
+    size_t run_end = pos;
+    while (run_end < size && data[run_end] != kEnd && data[run_end] != kEsc) {
+      ++run_end;
+    }
+    if (!this->append(data + pos, run_end - pos)) {
+      this->dropFrame("SLIP frame exceeds maximum size of " +
+                      std::to_string(max_frame_size_) + " bytes", true);
+      pos = run_end;
+      continue;
+    }
+    pos = run_end;
+    if (pos == size) {
+      break;
+    }
+
+    if (data[pos++] == kEsc) {
+      escaped_ = true;
+      continue;
+    }
+    if (frame_size_ > 0) {
+      *frame_done = true;
+      return pos;
+    }
+  }
+  return pos;
+}
+
+void SlipFramer::dropFrame(const std::string& message, bool skip_to_end) {
+  this->resetFrame();
+  discarding_ = skip_to_end;
+  this->reportFrameError(message);
+}
+
+void SlipFramer::resetFrame() {
+  StreamFramer::resetFrame();
+  escaped_ = false;
+}
+
+}  // namespace libserial
@@ -0,0 +1,160 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/spsc_ring.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "libserial/serial_exception.hpp"
+
+namespace libserial {
+
+SpscRing::SpscRing(size_t capacity) {
+  if (capacity == 0) {
+    throw SerialException("Ring capacity must be greater than zero");
+  }
+  if (capacity > (std::numeric_limits<size_t>::max() >> 1) + 1) {
+    throw SerialException("Ring capacity too large: " + std::to_string(capacity));
+  }
+
+  // A power of two lets running indices wrap with a mask instead of a division
+  capacity_ = 1;
+  while (capacity_ < capacity) {
+    capacity_ <<= 1;
+  }
+  mask_ = capacity_ - 1;
+  data_ = std::make_unique<char[]>(capacity_);
+}
+
+size_t SpscRing::getCapacity() const {
+  return capacity_;
+}
+
+size_t SpscRing::size() const {
+  size_t tail = tail_.load(std::memory_order_acquire);
+  size_t head = head_.load(std::memory_order_acquire);
+  return head - tail;
+}
+
+bool SpscRing::empty() const {
+  return this->size() == 0;
+}
+
+void SpscRing::setHighWatermark(size_t level, std::function<void(size_t)> callback) {
+  high_watermark_ = level;
+  on_high_watermark_ = std::move(callback);
+}
+
+void SpscRing::setLowWatermark(size_t level, std::function<void(size_t)> callback) {
+  low_watermark_ = level;
+  on_low_watermark_ = std::move(callback);
+}
+
+void SpscRing::fillRegions(size_t begin, size_t count, struct iovec (&regions)[2]) const {
+  size_t offset = begin & mask_;
+  size_t first = std::min(count, capacity_ - offset);
+  regions[0].iov_base = data_.get() + offset;
+  regions[0].iov_len = first;
+  regions[1].iov_base = data_.get();
+  regions[1].iov_len = count - first;
+}
+
+size_t SpscRing::writableSpace(size_t wanted) {
+  const size_t head = head_.load(std::memory_order_relaxed);
+  size_t free_space = capacity_ - (head - cached_tail_);
+  if (free_space < wanted) {
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    free_space = capacity_ - (head - cached_tail_);
+  }
+  return free_space;
+}
+
+size_t SpscRing::readableSpace(size_t wanted) {
+  const size_t tail = tail_.load(std::memory_order_relaxed);
+  size_t available = cached_head_ - tail;
+  if (available < wanted) {
+    cached_head_ = head_.load(std::memory_order_acquire);
+    available = cached_head_ - tail;
+  }
+  return available;
+}
+
+size_t SpscRing::writableRegions(struct iovec (&regions)[2]) {
+  size_t free_space = this->writableSpace(capacity_);
+  this->fillRegions(head_.load(std::memory_order_relaxed), free_space, regions);
+  return free_space;
+}
+
+void SpscRing::commitWrite(size_t count) {
+  if (count > this->writableSpace(count)) {
+    throw SerialException("Cannot commit more bytes than the ring has free");
+  }
+  const size_t head = head_.load(std::memory_order_relaxed);
+  head_.store(head + count, std::memory_order_release);
+
+  if (high_watermark_ > 0 && on_high_watermark_) {
+    // One snapshot of the consumer index for both levels
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    const size_t before = head - tail;
+    const size_t after = before + count;
+    if (before < high_watermark_ && after >= high_watermark_) {
+      on_high_watermark_(after);
+    }
+  }
+}
+
+size_t SpscRing::write(const void* data, size_t size) {
+  size_t count = std::min(size, this->writableSpace(size));
+  struct iovec regions[2];
+  this->fillRegions(head_.load(std::memory_order_relaxed), count, regions);
+
+  const char* source = static_cast<const char*>(data);
+  size_t first = std::min(count, regions[0].iov_len);
+  std::memcpy(regions[0].iov_base, source, first);
+  std::memcpy(regions[1].iov_base, source + first, count - first);
+
+  this->commitWrite(count);
+  return count;
+}
+
+size_t SpscRing::readableRegions(struct iovec (&regions)[2]) {
+  size_t available = this->readableSpace(capacity_);
+  this->fillRegions(tail_.load(std::memory_order_relaxed), available, regions);
+  return available;
+}
+
+void SpscRing::consume(size_t count) {
+  if (count > this->readableSpace(count)) {
+    throw SerialException("Cannot consume more bytes than the ring holds");
+  }
+  const size_t tail = tail_.load(std::memory_order_relaxed);
+  tail_.store(tail + count, std::memory_order_release);
+
+  if (on_low_watermark_) {
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t before = head - tail;
+    const size_t after = before - count;
+    if (before > low_watermark_ && after <= low_watermark_) {
+      on_low_watermark_(after);
+    }
+  }
+}
+
+size_t SpscRing::read(void* buffer, size_t size) {
+  size_t count = std::min(size, this->readableSpace(size));
+  struct iovec regions[2];
+  this->fillRegions(tail_.load(std::memory_order_relaxed), count, regions);
+
+  char* destination = static_cast<char*>(buffer);
+  size_t first = std::min(count, regions[0].iov_len);
+  std::memcpy(destination, regions[0].iov_base, first);
+  std::memcpy(destination + first, regions[1].iov_base, count - first);
+
+  this->consume(count);
+  return count;
+}
+
+}  // namespace libserial
@@ -0,0 +1,121 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/stream_framer.hpp"
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "libserial/serial.hpp"
+
+namespace libserial {
+
+StreamFramer::StreamFramer(Serial& serial, size_t max_frame_size, size_t read_chunk_size)
+  : serial_(serial), max_frame_size_(max_frame_size) {
+  if (max_frame_size == 0) {
+    throw SerialException("Maximum frame size must be greater than zero");
+  }
+  frame_.resize(max_frame_size_);
+  rx_chunk_.resize(read_chunk_size);
+}
+
+size_t StreamFramer::writeFrame(const std::string& frame) {
+  return this->writeFrame(frame.data(), frame.size());
+}
+
+size_t StreamFramer::readFrame(std::shared_ptr<std::string> frame) {
+  if (!frame) {
+    throw IOException("Null pointer passed to readFrame function");
+  }
+
+  this->readNextFrame();
+  frame->assign(reinterpret_cast<const char*>(frame_.data() + frame_begin_), frame_size_);
+  size_t frame_size = frame_size_;
+  this->resetFrame();
+  return frame_size;
+}
+
+size_t StreamFramer::readFrame(void* buffer, size_t size) {
+  if (!buffer) {
+    throw IOException("Null pointer passed to readFrame function");
+  }
+
+  this->readNextFrame();
+  size_t frame_size = frame_size_;
+  if (frame_size > size) {
+    this->resetFrame();
+    throw IOException("Frame of " + std::to_string(frame_size) +
+                      " bytes does not fit in buffer of " + std::to_string(size) + " bytes");
+  }
+  std::memcpy(buffer, frame_.data() + frame_begin_, frame_size);
+  this->resetFrame();
+  return frame_size;
+}
+
+void StreamFramer::readNextFrame() {
+  while (true) {
+    if (rx_begin_ == rx_end_ && !this->hasPendingInput()) {
+      rx_begin_ = 0;
+      rx_end_ = serial_.readSome(rx_chunk_.data(), rx_chunk_.size());
+      continue;
+    }
+
+    bool frame_done = false;
+    rx_begin_ += this->decode(rx_chunk_.data() + rx_begin_, rx_end_ - rx_begin_, &frame_done);
+    if (frame_done) {
+      return;
+    }
+  }
+}
+
+size_t StreamFramer::feed(const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  size_t frames = 0;
+  size_t pos = 0;
+  while (pos < size || this->hasPendingInput()) {
+    bool frame_done = false;
+    pos += this->decode(bytes + pos, size - pos, &frame_done);
+    if (frame_done) {
+      if (on_frame_) {
+        on_frame_(reinterpret_cast<const char*>(frame_.data() + frame_begin_), frame_size_);
+      }
+      this->resetFrame();
+      frames++;
+    }
+  }
+  return frames;
+}
+
+void StreamFramer::onFrame(std::function<void(const char*, size_t)> callback) {
+  on_frame_ = std::move(callback);
+}
+
+void StreamFramer::onFrameError(std::function<void(const FramingException&)> callback) {
+  on_frame_error_ = std::move(callback);
+}
+
+size_t StreamFramer::getFrameErrorCount() const {
+  return frame_errors_;
+}
+
+size_t StreamFramer::getMaxFrameSize() const {
+  return max_frame_size_;
+}
+
+void StreamFramer::resetFrame() {
+  frame_begin_ = 0;
+  frame_size_ = 0;
+}
+
+bool StreamFramer::hasPendingInput() const {
+  return false;
+}
+
+void StreamFramer::reportFrameError(const std::string& message) {
+  frame_errors_++;
+  if (on_frame_error_) {
+    on_frame_error_(FramingException(message));
+  }
+}
+
+}  // namespace libserial
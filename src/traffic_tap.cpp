@@ -0,0 +1,174 @@
+//  @ Copyright 2022-2025 Nestor Neto
+
+#include "libserial/traffic_tap.hpp"
+
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "libserial/serial_exception.hpp"
+
+namespace libserial {
+
+TrafficTap::TrafficTap(size_t queue_size, TapOverflow overflow)
+  : overflow_(overflow) {
+  if (queue_size == 0) {
+    throw SerialException("Tap queue size must be greater than zero");
+  }
+  slots_.resize(queue_size);
+  thread_ = std::thread(&TrafficTap::drainLoop, this);
+}
+
+TrafficTap::~TrafficTap() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  queued_cv_.notify_one();
+  thread_.join();
+}
+
+int TrafficTap::addObserver(Observer observer) {
+  std::lock_guard<std::mutex> lock(observers_mutex_);
+  observers_.emplace_back(next_observer_id_, std::move(observer));
+  return next_observer_id_++;
+}
+
+void TrafficTap::removeObserver(int id) {
+  if (std::this_thread::get_id() == thread_.get_id()) {
+    throw SerialException("removeObserver() cannot be called from an observer");
+  }
+
+  // Waits for a batch being delivered, so the observer is not running after return
+  std::lock_guard<std::mutex> lock(observers_mutex_);
+  observers_.erase(std::remove_if(observers_.begin(), observers_.end(),
+                                  [id](const std::pair<int, Observer>& entry) {
+      return entry.first == id;
+    }), observers_.end());
+}
+
+void TrafficTap::publish(CaptureDirection direction, const void* data, size_t size) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  CaptureRecord* slot = this->claimSlot(direction, size);
+  if (!slot) {
+    return;
+  }
+  slot->data.assign(static_cast<const char*>(data), size);
+  this->commitSlot(lock);
+}
+
+void TrafficTap::publish(CaptureDirection direction, const struct iovec* segments, int count,
+                         size_t size) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  CaptureRecord* slot = this->claimSlot(direction, size);
+  if (!slot) {
+    return;
+  }
+  slot->data.resize(size);
+  size_t offset = 0;
+  for (int i = 0; i < count && offset < size; ++i) {
+    size_t take = std::min(size - offset, segments[i].iov_len);
+    memcpy(&slot->data[offset], segments[i].iov_base, take);
+    offset += take;
+  }
+  this->commitSlot(lock);
+}
+
+CaptureRecord* TrafficTap::claimSlot(CaptureDirection direction, size_t size) {
+  if (count_ == slots_.size()) {
+    stats_.dropped++;
+    if (overflow_ == TapOverflow::DROP_NEWEST) {
+      stats_.dropped_bytes += size;
+      return nullptr;
+    }
+    stats_.dropped_bytes += slots_[head_].data.size();
+    head_ = (head_ + 1) % slots_.size();
+    count_--;
+    retired_++;
+  }
+
+  CaptureRecord& slot = slots_[(head_ + count_) % slots_.size()];
+  slot.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch());
+  slot.direction = direction;
+  return &slot;
+}
+
+void TrafficTap::commitSlot(std::unique_lock<std::mutex>& lock) {
+  // The drain thread takes every queued chunk at once, so it only
+  // sleeps while the queue is empty
+  bool wake = count_ == 0;
+  count_++;
+  stats_.published++;
+  lock.unlock();
+  if (wake) {
+    queued_cv_.notify_one();
+  }
+}
+
+void TrafficTap::flush() {
+  if (std::this_thread::get_id() == thread_.get_id()) {
+    throw SerialException("flush() cannot be called from an observer");
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  uint64_t target = stats_.published;
+  drained_cv_.wait(lock, [this, target]() {
+      return retired_ >= target;
+    });
+}
+
+TapStats TrafficTap::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+size_t TrafficTap::getQueueSize() const {
+  return slots_.size();
+}
+
+TapOverflow TrafficTap::getOverflow() const {
+  return overflow_;
+}
+
+void TrafficTap::drainLoop() {
+  // Chunks are swapped between the queue and the batch, so both keep
+  // their grown strings and delivering does not allocate
+  std::vector<CaptureRecord> batch(slots_.size());
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    queued_cv_.wait(lock, [this]() {
+        return stop_ || count_ > 0;
+      });
+    if (count_ == 0) {
+      return;  // stop_ with nothing left
+    }
+
+    size_t taken = count_;
+    for (size_t i = 0; i < taken; ++i) {
+      std::swap(batch[i], slots_[(head_ + i) % slots_.size()]);
+    }
+    head_ = (head_ + taken) % slots_.size();
+    count_ = 0;
+    lock.unlock();
+
+    {
+      std::lock_guard<std::mutex> observers_lock(observers_mutex_);
+      for (size_t i = 0; i < taken; ++i) {
+        for (auto& entry : observers_) {
+          entry.second(batch[i]);
+        }
+      }
+    }
+
+    lock.lock();
+    retired_ += taken;
+    stats_.delivered += taken;
+    drained_cv_.notify_all();
+  }
+}
+
+}  // namespace libserial
@@ -0,0 +1,88 @@
+// Copyright 2020-2025 Nestor Neto
+
+#ifndef TEST_RAW_PTY_TEST_HPP_
+#define TEST_RAW_PTY_TEST_HPP_
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <initializer_list>
+#include <string>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#include "libserial/serial.hpp"
+
+// Raw pseudo-terminal pair carrying binary frames; openRawPty() sets up
+// further pairs for fixtures that drive several ports
+class RawPtyTest : public ::testing::Test {
+public:
+// Opens serial on a new pseudo-terminal pair whose line discipline
+// passes binary data through untouched
+static void openRawPty(libserial::Serial& serial, int& master_fd) {
+  master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+  ASSERT_NE(master_fd, -1) << "Failed to open master pseudo-terminal";
+  ASSERT_EQ(grantpt(master_fd), 0);
+  ASSERT_EQ(unlockpt(master_fd), 0);
+
+  serial.open(ptsname(master_fd));
+  serial.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+
+  struct termios2 tty;
+  ASSERT_EQ(ioctl(serial.getFileDescriptor(), TCGETS2, &tty), 0);
+  tty.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
+  tty.c_oflag &= ~OPOST;
+  tty.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+  ASSERT_EQ(ioctl(serial.getFileDescriptor(), TCSETS2, &tty), 0);
+
+  // Later setters must start from the raw settings, not the cached ones
+  serial.refreshConfig();
+}
+
+protected:
+int master_fd_{-1};
+libserial::Serial serial_;
+
+void SetUp() override {
+  openRawPty(serial_, master_fd_);
+  ASSERT_FALSE(HasFatalFailure());
+  serial_.setReadTimeout(std::chrono::milliseconds(1000));
+}
+
+void TearDown() override {
+  serial_.close();
+  close(master_fd_);
+}
+
+void writeMaster(const std::string& data) {
+  ASSERT_EQ(write(master_fd_, data.data(), data.size()),
+            static_cast<ssize_t>(data.size()));
+}
+
+std::string readMaster(size_t size) {
+  std::string data(size, '\0');
+  size_t received = 0;
+  while (received < size) {
+    ssize_t result = read(master_fd_, &data[received], size - received);
+    if (result <= 0) {
+      break;
+    }
+    received += static_cast<size_t>(result);
+  }
+  data.resize(received);
+  return data;
+}
+
+static std::string bytes(std::initializer_list<int> values) {
+  std::string data;
+  for (int value : values) {
+    data.push_back(static_cast<char>(value));
+  }
+  return data;
+}
+};
+
+#endif  // TEST_RAW_PTY_TEST_HPP_
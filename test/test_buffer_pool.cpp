@@ -0,0 +1,109 @@
+// Copyright 2020-2025 Nestor Neto
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "libserial/buffer_pool.hpp"
+
+using libserial::BufferPool;
+using libserial::PooledBuffer;
+
+class BufferPoolTest : public ::testing::Test {
+protected:
+void SetUp() override {
+  BufferPool::trim();
+}
+
+void TearDown() override {
+  BufferPool::trim();
+}
+};
+
+TEST_F(BufferPoolTest, RoundsUpToSizeClass) {
+  EXPECT_EQ(BufferPool::acquire(0).capacity(), BufferPool::kMinSlabSize);
+  EXPECT_EQ(BufferPool::acquire(256).capacity(), 256u);
+  EXPECT_EQ(BufferPool::acquire(257).capacity(), 512u);
+  EXPECT_EQ(BufferPool::acquire(2048).capacity(), 2048u);
+  EXPECT_EQ(BufferPool::acquire(BufferPool::kMaxSlabSize).capacity(), BufferPool::kMaxSlabSize);
+
+  PooledBuffer buffer = BufferPool::acquire(100);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_NE(buffer.data(), nullptr);
+}
+
+TEST_F(BufferPoolTest, RecyclesDroppedSlabs) {
+  const char* first = nullptr;
+  {
+    PooledBuffer buffer = BufferPool::acquire(2048);
+    first = buffer.data();
+    std::memcpy(buffer.data(), "abc", 3);
+    buffer.resize(3);
+    EXPECT_EQ(buffer.view(), "abc");
+    EXPECT_EQ(BufferPool::getCachedCount(2048), 0u);
+  }
+  EXPECT_EQ(BufferPool::getCachedCount(2048), 1u);
+
+  // Same size class, same slab, and no stale size
+  PooledBuffer again = BufferPool::acquire(1500);
+  EXPECT_EQ(again.data(), first);
+  EXPECT_EQ(again.size(), 0u);
+  EXPECT_EQ(BufferPool::getCachedCount(2048), 0u);
+
+  // Other size classes have their own lists
+  EXPECT_EQ(BufferPool::getCachedCount(512), 0u);
+}
+
+TEST_F(BufferPoolTest, CapsFreeListAndSkipsOversizedBuffers) {
+  {
+    std::vector<PooledBuffer> buffers;
+    for (size_t i = 0; i < BufferPool::kMaxCachedSlabs + 4; ++i) {
+      buffers.push_back(BufferPool::acquire(256));
+    }
+  }
+  EXPECT_EQ(BufferPool::getCachedCount(256), BufferPool::kMaxCachedSlabs);
+
+  {
+    PooledBuffer large = BufferPool::acquire(BufferPool::kMaxSlabSize + 1);
+    EXPECT_EQ(large.capacity(), BufferPool::kMaxSlabSize + 1);
+  }
+  EXPECT_EQ(BufferPool::getCachedCount(BufferPool::kMaxSlabSize + 1), 0u);
+
+  BufferPool::trim();
+  EXPECT_EQ(BufferPool::getCachedCount(256), 0u);
+}
+
+TEST_F(BufferPoolTest, MoveTransfersOwnership) {
+  PooledBuffer source = BufferPool::acquire(256);
+  source.resize(10);
+  const char* data = source.data();
+
+  PooledBuffer target(std::move(source));
+  EXPECT_EQ(target.data(), data);
+  EXPECT_EQ(target.size(), 10u);
+  EXPECT_EQ(source.data(), nullptr);  // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(source.capacity(), 0u);
+
+  // Assigning over a live buffer releases it
+  target = BufferPool::acquire(256);
+  EXPECT_EQ(BufferPool::getCachedCount(256), 1u);
+}
+
+TEST_F(BufferPoolTest, FreeListsArePerThread) {
+  PooledBuffer buffer = BufferPool::acquire(1024);
+
+  size_t cached_there = 0;
+  std::thread other([&buffer, &cached_there]() {
+      PooledBuffer moved(std::move(buffer));
+      moved = PooledBuffer();
+      cached_there = BufferPool::getCachedCount(1024);
+    });
+  other.join();
+
+  // The slab went to the list of the thread that dropped it
+  EXPECT_EQ(cached_there, 1u);
+  EXPECT_EQ(BufferPool::getCachedCount(1024), 0u);
+}
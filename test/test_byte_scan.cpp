@@ -0,0 +1,75 @@
+// Copyright 2020-2025 Nestor Neto
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+#include "libserial/byte_scan.hpp"
+
+namespace {
+
+// Every vector width and tail length is covered by sizes up to 200
+constexpr size_t kMaxSize = 200;
+
+const char* reference(const char* data, size_t size, char byte) {
+  const char* found = std::find(data, data + size, byte);
+  return found == data + size ? nullptr : found;
+}
+
+}  // namespace
+
+TEST(ByteScanTest, MatchesReferenceAtEveryOffset) {
+  std::string buffer(kMaxSize + 16, 'a');
+
+  for (size_t start = 0; start < 16; ++start) {
+    for (size_t size = 0; size <= kMaxSize; ++size) {
+      const char* data = buffer.data() + start;
+      for (size_t match = 0; match < size; ++match) {
+        buffer[start + match] = '\n';
+        EXPECT_EQ(libserial::findByte(data, size, '\n'), data + match);
+        EXPECT_EQ(libserial::findByteScalar(data, size, '\n'), data + match);
+        buffer[start + match] = 'a';
+      }
+      EXPECT_EQ(libserial::findByte(data, size, '\n'), nullptr);
+      EXPECT_EQ(libserial::findByteScalar(data, size, '\n'), nullptr);
+    }
+  }
+}
+
+TEST(ByteScanTest, IgnoresBytesPastSize) {
+  std::string buffer(128, 'a');
+  buffer[100] = '\n';
+
+  EXPECT_EQ(libserial::findByte(buffer.data(), 100, '\n'), nullptr);
+  EXPECT_EQ(libserial::findByteScalar(buffer.data(), 100, '\n'), nullptr);
+  EXPECT_EQ(libserial::findByte(buffer.data(), 101, '\n'), buffer.data() + 100);
+}
+
+TEST(ByteScanTest, FindsFirstOfSeveralMatchesForEveryByteValue) {
+  // High-bit bytes and neighbours of the needle must not cause false matches
+  std::string buffer;
+  for (int value = 0; value < 256; ++value) {
+    buffer += static_cast<char>(value);
+  }
+  buffer += buffer;
+
+  for (int value = 0; value < 256; ++value) {
+    const char byte = static_cast<char>(value);
+    const char* expected = reference(buffer.data(), buffer.size(), byte);
+    EXPECT_EQ(libserial::findByte(buffer.data(), buffer.size(), byte), expected);
+    EXPECT_EQ(libserial::findByteScalar(buffer.data(), buffer.size(), byte), expected);
+  }
+}
+
+TEST(ByteScanTest, FindSequence) {
+  const std::string data = "O\r\nK\r\nOK\rOK\r\n";
+
+  EXPECT_EQ(libserial::findSequence(data.data(), data.size(), "OK\r\n"), data.data() + 9);
+  EXPECT_EQ(libserial::findSequence(data.data(), data.size(), "\r\n"), data.data() + 1);
+  EXPECT_EQ(libserial::findSequence(data.data(), data.size(), "K"), data.data() + 3);
+  EXPECT_EQ(libserial::findSequence(data.data(), data.size(), "OK\r\n\r"), nullptr);
+  EXPECT_EQ(libserial::findSequence(data.data(), 12, "OK\r\n"), nullptr);
+  EXPECT_EQ(libserial::findSequence(data.data(), 2, "OK\r\n"), nullptr);
+  EXPECT_EQ(libserial::findSequence(data.data(), data.size(), ""), nullptr);
+}
@@ -0,0 +1,205 @@
+// Copyright 2020-2025 Nestor Neto
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "libserial/capture.hpp"
+#include "libserial/serial.hpp"
+#include "libserial/serial_exception.hpp"
+
+using libserial::CaptureDirection;
+using libserial::CaptureReader;
+using libserial::CaptureRecord;
+using libserial::CaptureReplayer;
+using libserial::CaptureWriter;
+using libserial::ReplayTiming;
+
+class CaptureTest : public ::testing::Test {
+protected:
+std::string path_;
+
+void SetUp() override {
+  char name[] = "/tmp/libserial_capture_XXXXXX";
+  int fd = mkstemp(name);
+  ASSERT_NE(fd, -1);
+  close(fd);
+  unlink(name);
+  path_ = name;
+}
+
+void TearDown() override {
+  unlink(path_.c_str());
+}
+};
+
+TEST_F(CaptureTest, WriterAndReaderRoundTrip) {
+  {
+    CaptureWriter writer(path_);
+    writer.record(CaptureDirection::TX, "ping", 4);
+
+    // Only the bytes the call moved are recorded, across segments
+    struct iovec segments[2] = {{const_cast<char*>("po"), 2}, {const_cast<char*>("ng!!"), 4}};
+    writer.record(CaptureDirection::RX, segments, 2, 4);
+    writer.record(CaptureDirection::RX, "", 0);
+    writer.flush();
+    EXPECT_EQ(writer.getDroppedRecords(), 0u);
+    EXPECT_EQ(writer.getPath(), path_);
+  }
+
+  CaptureReader reader(path_);
+  CaptureRecord first;
+  CaptureRecord second;
+  CaptureRecord third;
+  ASSERT_TRUE(reader.next(first));
+  ASSERT_TRUE(reader.next(second));
+  ASSERT_TRUE(reader.next(third));
+  CaptureRecord extra;
+  EXPECT_FALSE(reader.next(extra));
+
+  EXPECT_EQ(first.direction, CaptureDirection::TX);
+  EXPECT_EQ(first.data, "ping");
+  EXPECT_EQ(second.direction, CaptureDirection::RX);
+  EXPECT_EQ(second.data, "pong");
+  EXPECT_TRUE(third.data.empty());
+  EXPECT_LE(first.timestamp, second.timestamp);
+  EXPECT_LE(second.timestamp, third.timestamp);
+}
+
+TEST_F(CaptureTest, ReopeningAppendsToTheCapture) {
+  {
+    CaptureWriter writer(path_);
+    writer.record(CaptureDirection::RX, "one", 3);
+  }
+  {
+    CaptureWriter writer(path_);
+    writer.record(CaptureDirection::RX, "two", 3);
+  }
+
+  CaptureReader reader(path_);
+  CaptureRecord record;
+  ASSERT_TRUE(reader.next(record));
+  EXPECT_EQ(record.data, "one");
+  ASSERT_TRUE(reader.next(record));
+  EXPECT_EQ(record.data, "two");
+  EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(CaptureTest, RejectsOtherFiles) {
+  std::ofstream(path_) << "not a capture";
+  EXPECT_THROW(CaptureWriter writer(path_), libserial::SerialException);
+  EXPECT_THROW(CaptureReader reader(path_), libserial::SerialException);
+  EXPECT_THROW(CaptureReader reader("/nonexistent/capture"), libserial::SerialException);
+}
+
+TEST_F(CaptureTest, TruncatedRecordEndsTheCapture) {
+  {
+    CaptureWriter writer(path_);
+    writer.record(CaptureDirection::RX, "complete", 8);
+    writer.record(CaptureDirection::RX, "cut short", 9);
+  }
+  ASSERT_EQ(truncate(path_.c_str(), 8 + (13 + 8) + (13 + 4)), 0);
+
+  CaptureReader reader(path_);
+  CaptureRecord record;
+  ASSERT_TRUE(reader.next(record));
+  EXPECT_EQ(record.data, "complete");
+  EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(CaptureTest, DropsRecordsThatDoNotFit) {
+  CaptureWriter writer(path_, 64);
+  std::string large(100, 'x');
+  writer.record(CaptureDirection::TX, large.data(), large.size());
+  writer.record(CaptureDirection::TX, "fits", 4);
+  writer.flush();
+  EXPECT_EQ(writer.getDroppedRecords(), 1u);
+
+  CaptureReader reader(path_);
+  CaptureRecord record;
+  ASSERT_TRUE(reader.next(record));
+  EXPECT_EQ(record.data, "fits");
+  EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(CaptureTest, SerialTeesTrafficIntoTheCapture) {
+  int master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+  ASSERT_NE(master_fd, -1);
+  ASSERT_EQ(grantpt(master_fd), 0);
+  ASSERT_EQ(unlockpt(master_fd), 0);
+
+  libserial::Serial serial_port;
+  serial_port.open(ptsname(master_fd));
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+
+  auto writer = std::make_shared<CaptureWriter>(path_);
+  serial_port.setCapture(writer);
+  EXPECT_EQ(serial_port.getCapture(), writer);
+
+  serial_port.write("ping", 4);
+  ASSERT_EQ(write(master_fd, "pong", 4), 4);
+  char reply[4];
+  EXPECT_EQ(serial_port.readBytes(reply, sizeof(reply)), 4u);
+
+  serial_port.startAsyncRead();
+  EXPECT_THROW(serial_port.setCapture(nullptr), libserial::SerialException);
+  serial_port.stopAsyncRead();
+  serial_port.setCapture(nullptr);
+  serial_port.write("not captured", 12);
+  writer->flush();
+
+  CaptureReader reader(path_);
+  CaptureRecord record;
+  ASSERT_TRUE(reader.next(record));
+  EXPECT_EQ(record.direction, CaptureDirection::TX);
+  EXPECT_EQ(record.data, "ping");
+  ASSERT_TRUE(reader.next(record));
+  EXPECT_EQ(record.direction, CaptureDirection::RX);
+  EXPECT_EQ(record.data, "pong");
+  EXPECT_FALSE(reader.next(record));
+
+  serial_port.close();
+  close(master_fd);
+}
+
+void expectLine(libserial::Serial& serial_port, const std::string& expected) {
+  auto line = std::make_shared<std::string>();
+  serial_port.readUntil(line, ';');
+  EXPECT_EQ(*line, expected);
+}
+
+TEST_F(CaptureTest, ReplayKeepsChunksAndTiming) {
+  {
+    CaptureWriter writer(path_);
+    writer.record(CaptureDirection::RX, "one;", 4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    writer.record(CaptureDirection::TX, "skipped", 7);
+    writer.record(CaptureDirection::RX, "two;", 4);
+  }
+
+  CaptureReplayer replayer;
+  libserial::Serial serial_port;
+  serial_port.open(replayer.getPortName());
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(replayer.replay(path_), 8u);
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(90));
+  expectLine(serial_port, "one;");
+  expectLine(serial_port, "two;");
+
+  start = std::chrono::steady_clock::now();
+  EXPECT_EQ(replayer.replay(path_, ReplayTiming::FAST), 8u);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(90));
+  expectLine(serial_port, "one;");
+  expectLine(serial_port, "two;");
+}
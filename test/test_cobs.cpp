@@ -0,0 +1,118 @@
+// Copyright 2020-2025 Nestor Neto
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "libserial/cobs.hpp"
+#include "libserial/serial.hpp"
+#include "libserial/serial_exception.hpp"
+
+#include "raw_pty_test.hpp"
+
+class CobsFramerTest : public RawPtyTest {
+protected:
+static std::string sequence(int first, int last) {
+  std::string data;
+  for (int value = first; value <= last; ++value) {
+    data.push_back(static_cast<char>(value));
+  }
+  return data;
+}
+
+// Reference vectors: {decoded, encoded including the delimiter}
+std::vector<std::pair<std::string, std::string>> vectors() {
+  return {
+    {bytes({0x00}), bytes({0x01, 0x01, 0x00})},
+    {bytes({0x00, 0x00}), bytes({0x01, 0x01, 0x01, 0x00})},
+    {bytes({0x11, 0x22, 0x00, 0x33}), bytes({0x03, 0x11, 0x22, 0x02, 0x33, 0x00})},
+    {bytes({0x11, 0x22, 0x33, 0x44}), bytes({0x05, 0x11, 0x22, 0x33, 0x44, 0x00})},
+    {bytes({0x11, 0x00, 0x00, 0x00}), bytes({0x02, 0x11, 0x01, 0x01, 0x01, 0x00})},
+    {sequence(0x01, 0xFE), bytes({0xFF}) + sequence(0x01, 0xFE) + bytes({0x00})},
+    {sequence(0x00, 0xFE), bytes({0x01, 0xFF}) + sequence(0x01, 0xFE) + bytes({0x00})},
+    {sequence(0x01, 0xFF), bytes({0xFF}) + sequence(0x01, 0xFE) + bytes({0x02, 0xFF, 0x00})},
+  };
+}
+};
+
+TEST_F(CobsFramerTest, EncodesReferenceVectors) {
+  libserial::CobsFramer framer(serial_);
+  for (const auto& [decoded, encoded] : vectors()) {
+    EXPECT_EQ(framer.writeFrame(decoded), encoded.size());
+    EXPECT_LE(encoded.size(), libserial::CobsFramer::getMaxEncodedSize(decoded.size()));
+    EXPECT_EQ(readMaster(encoded.size()), encoded);
+  }
+}
+
+TEST_F(CobsFramerTest, DecodesAcrossArbitraryBoundaries) {
+  libserial::CobsFramer framer(serial_);
+  std::vector<std::string> frames;
+  framer.onFrame([&frames](const char* frame, size_t size) {
+      frames.emplace_back(frame, size);
+    });
+
+  std::string stream;
+  for (const auto& vector : vectors()) {
+    stream += vector.second;
+  }
+
+  // Feed one byte at a time, then all at once
+  for (char byte : stream) {
+    framer.feed(&byte, 1);
+  }
+  EXPECT_EQ(framer.feed(stream.data(), stream.size()), vectors().size());
+
+  ASSERT_EQ(frames.size(), 2 * vectors().size());
+  for (size_t i = 0; i < frames.size(); ++i) {
+    EXPECT_EQ(frames[i], vectors()[i % vectors().size()].first) << "frame " << i;
+  }
+  EXPECT_EQ(framer.getFrameErrorCount(), 0u);
+}
+
+TEST_F(CobsFramerTest, ReadFrameKeepsFollowingBytes) {
+  libserial::CobsFramer framer(serial_);
+  writeMaster(bytes({0x00, 0x03, 0x11, 0x22, 0x02, 0x33, 0x00, 0x02, 0x44, 0x00}));
+
+  auto frame = std::make_shared<std::string>();
+  EXPECT_EQ(framer.readFrame(frame), 4u);
+  EXPECT_EQ(*frame, bytes({0x11, 0x22, 0x00, 0x33}));
+
+  char buffer[4];
+  EXPECT_EQ(framer.readFrame(buffer, sizeof(buffer)), 1u);
+  EXPECT_EQ(buffer[0], 0x44);
+
+  // Writing and reading back through the port round-trips
+  const std::string payload = bytes({0x00, 0x7F, 0x00, 0xFF});
+  size_t encoded_size = framer.writeFrame(payload);
+  writeMaster(readMaster(encoded_size));
+  EXPECT_EQ(framer.readFrame(frame), payload.size());
+  EXPECT_EQ(*frame, payload);
+}
+
+TEST_F(CobsFramerTest, MalformedFramesAreDroppedNotFatal) {
+  libserial::CobsFramer framer(serial_, 4);
+  std::vector<std::string> errors;
+  framer.onFrameError([&errors](const libserial::FramingException& error) {
+      errors.emplace_back(error.what());
+    });
+
+  // Truncated block, oversized frame, then a valid frame
+  writeMaster(bytes({0x05, 0x11, 0x00}) +
+              bytes({0x07, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x00}) +
+              bytes({0x02, 0x42, 0x00}));
+
+  char buffer[4];
+  EXPECT_EQ(framer.readFrame(buffer, sizeof(buffer)), 1u);
+  EXPECT_EQ(buffer[0], 0x42);
+
+  ASSERT_EQ(errors.size(), 2u);
+  EXPECT_EQ(errors[0], "COBS frame truncated: delimiter inside a block");
+  EXPECT_EQ(errors[1], "COBS frame exceeds maximum size of 4 bytes");
+  EXPECT_EQ(framer.getFrameErrorCount(), 2u);
+
+  EXPECT_THROW(framer.writeFrame(nullptr, 1), libserial::IOException);
+  EXPECT_THROW(libserial::CobsFramer(serial_, 0), libserial::SerialException);
+}
@@ -0,0 +1,166 @@
+// Copyright 2020-2025 Nestor Neto
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "libserial/crc.hpp"
+#include "libserial/packet_framer.hpp"
+#include "libserial/serial.hpp"
+#include "libserial/serial_exception.hpp"
+
+#include "raw_pty_test.hpp"
+
+namespace {
+
+// Bit-at-a-time reference for the reflected CRC-32 variants
+uint32_t referenceCrc(const uint8_t* data, size_t size, uint32_t polynomial) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < size; ++i) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+    }
+  }
+  return ~crc;
+}
+
+// Hand-built CRC-16 packet: sync, little-endian length, payload, CRC
+std::string packet(const std::string& payload) {
+  std::string data = {static_cast<char>(0xA5), static_cast<char>(0x5A),
+                      static_cast<char>(payload.size() & 0xFF),
+                      static_cast<char>(payload.size() >> 8)};
+  data += payload;
+  uint16_t crc = libserial::crc16Ccitt(data.data() + 2, data.size() - 2);
+  data.push_back(static_cast<char>(crc & 0xFF));
+  data.push_back(static_cast<char>(crc >> 8));
+  return data;
+}
+
+}  // namespace
+
+TEST(CrcTest, CheckValues) {
+  const char check[] = "123456789";
+  EXPECT_EQ(libserial::crc16Ccitt(check, 9), 0x29B1);
+  EXPECT_EQ(libserial::crc32(check, 9), 0xCBF43926u);
+  EXPECT_EQ(libserial::crc32c(check, 9), 0xE3069283u);
+
+  // Checksums continue across buffers
+  EXPECT_EQ(libserial::crc16Ccitt(check + 4, 5, libserial::crc16Ccitt(check, 4)), 0x29B1);
+  EXPECT_EQ(libserial::crc32(check + 4, 5, libserial::crc32(check, 4)), 0xCBF43926u);
+  EXPECT_EQ(libserial::crc32c(check + 4, 5, libserial::crc32c(check, 4)), 0xE3069283u);
+}
+
+TEST(CrcTest, MatchesReferenceAtAnyAlignment) {
+  std::mt19937 random(42);
+  std::vector<uint8_t> data(300);
+  for (uint8_t& byte : data) {
+    byte = static_cast<uint8_t>(random());
+  }
+
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t size = 0; size + offset <= data.size(); size += 37) {
+      const uint8_t* p = data.data() + offset;
+      EXPECT_EQ(libserial::crc32(p, size), referenceCrc(p, size, 0xEDB88320));
+      EXPECT_EQ(libserial::crc32c(p, size), referenceCrc(p, size, 0x82F63B78));
+    }
+  }
+}
+
+class PacketFramerTest : public RawPtyTest {};
+
+TEST_F(PacketFramerTest, WritesHeaderPayloadAndCrc) {
+  libserial::PacketFramer framer(serial_);
+  const std::string expected = packet("hi");
+  EXPECT_EQ(framer.writeFrame(std::string("hi")), expected.size());
+  EXPECT_EQ(readMaster(expected.size()), expected);
+
+  EXPECT_THROW(framer.writeFrame(std::string(5000, 'x')), libserial::IOException);
+  EXPECT_THROW(libserial::PacketFramer(serial_, libserial::FrameCheck::CRC32, 70000),
+               libserial::SerialException);
+}
+
+TEST_F(PacketFramerTest, RoundTripsWithEveryCheck) {
+  for (auto check : {libserial::FrameCheck::CRC16_CCITT, libserial::FrameCheck::CRC32,
+                     libserial::FrameCheck::CRC32C}) {
+    libserial::PacketFramer framer(serial_, check);
+    EXPECT_EQ(framer.getFrameCheck(), check);
+
+    std::string payload(300, '\0');
+    for (size_t i = 0; i < payload.size(); ++i) {
+      payload[i] = static_cast<char>(i * 7);
+    }
+    size_t written = framer.writeFrame(payload);
+    size_t empty = framer.writeFrame(std::string());
+    writeMaster(readMaster(written + empty));
+
+    auto frame = std::make_shared<std::string>();
+    EXPECT_EQ(framer.readFrame(frame), payload.size());
+    EXPECT_EQ(*frame, payload);
+    EXPECT_EQ(framer.readFrame(frame), 0u);
+    EXPECT_EQ(framer.getFrameErrorCount(), 0u);
+  }
+}
+
+TEST_F(PacketFramerTest, ResynchronizesAfterCorruption) {
+  libserial::PacketFramer framer(serial_, libserial::FrameCheck::CRC16_CCITT, 64);
+  std::vector<std::string> frames;
+  std::vector<std::string> errors;
+  framer.onFrame([&frames](const char* frame, size_t size) {
+      frames.emplace_back(frame, size);
+    });
+  framer.onFrameError([&errors](const libserial::FramingException& error) {
+      errors.emplace_back(error.what());
+    });
+
+  // Corrupted payload byte
+  std::string bad_payload = packet("first");
+  bad_payload[5] ^= 0x01;
+
+  // Corrupted length that swallows the next packet; it must be found again
+  std::string bad_length = packet("xy");
+  bad_length[2] = 20;
+
+  // Length above the maximum
+  std::string too_long = packet("z");
+  too_long[3] = 0x10;
+
+  const std::string stream = std::string("\x01\xA5 noise") + bad_payload + packet("second") +
+                             bad_length + packet("third") + too_long + packet("fourth") +
+                             std::string(20, '\0');
+
+  // One byte at a time, then as a single chunk
+  for (char byte : stream) {
+    framer.feed(&byte, 1);
+  }
+  framer.feed(stream.data(), stream.size());
+
+  ASSERT_EQ(frames.size(), 6u);
+  for (size_t i = 0; i < frames.size(); i += 3) {
+    EXPECT_EQ(frames[i], "second");
+    EXPECT_EQ(frames[i + 1], "third");
+    EXPECT_EQ(frames[i + 2], "fourth");
+  }
+  ASSERT_EQ(errors.size(), 6u);
+  EXPECT_EQ(errors[0], "Packet CRC mismatch");
+  EXPECT_EQ(errors[1], "Packet CRC mismatch");
+  EXPECT_EQ(errors[2], "Packet length of 4097 bytes exceeds maximum frame size of 64 bytes");
+}
+
+TEST_F(PacketFramerTest, ReadFrameRecoversBufferedPacket) {
+  libserial::PacketFramer framer(serial_, libserial::FrameCheck::CRC16_CCITT, 64);
+
+  std::string bad_length = packet("xy");
+  bad_length[2] = 30;
+  writeMaster(bad_length + packet("kept") + packet("next") + std::string(30, '\0'));
+
+  char buffer[64];
+  size_t size = framer.readFrame(buffer, sizeof(buffer));
+  EXPECT_EQ(std::string(buffer, size), "kept");
+  size = framer.readFrame(buffer, sizeof(buffer));
+  EXPECT_EQ(std::string(buffer, size), "next");
+  EXPECT_EQ(framer.getFrameErrorCount(), 1u);
+}
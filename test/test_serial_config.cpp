@@ -0,0 +1,45 @@
+// Copyright 2020-2025 Nestor Neto
+
+#include <gtest/gtest.h>
+#include <chrono>
+
+#include "libserial/serial_config.hpp"
+
+TEST(SerialConfigTest, DefaultConstructorLeavesEverythingUnset) {
+  libserial::SerialConfig config;
+
+  EXPECT_FALSE(config.getBaudRate().has_value());
+  EXPECT_FALSE(config.getDataLength().has_value());
+  EXPECT_FALSE(config.getParity().has_value());
+  EXPECT_FALSE(config.getStopBits().has_value());
+  EXPECT_FALSE(config.getCanonicalMode().has_value());
+  EXPECT_FALSE(config.getReadTimeout().has_value());
+  EXPECT_FALSE(config.getWriteTimeout().has_value());
+  EXPECT_FALSE(config.getMinNumberCharRead().has_value());
+}
+
+TEST(SerialConfigTest, SetGetFunction) {
+  libserial::SerialConfig config;
+
+  config.setBaudRate(libserial::BaudRate::BAUD_RATE_115200);
+  config.setDataLength(libserial::DataLength::SEVEN);
+  config.setParity(libserial::Parity::ENABLE);
+  config.setStopBits(libserial::StopBits::TWO);
+  config.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  config.setReadTimeout(std::chrono::milliseconds(1500));
+  config.setWriteTimeout(std::chrono::milliseconds(250));
+  config.setMinNumberCharRead(4);
+
+  EXPECT_EQ(config.getBaudRate(), 115200u);
+  EXPECT_EQ(config.getDataLength(), libserial::DataLength::SEVEN);
+  EXPECT_EQ(config.getParity(), libserial::Parity::ENABLE);
+  EXPECT_EQ(config.getStopBits(), libserial::StopBits::TWO);
+  EXPECT_EQ(config.getCanonicalMode(), libserial::CanonicalMode::DISABLE);
+  EXPECT_EQ(config.getReadTimeout(), std::chrono::milliseconds(1500));
+  EXPECT_EQ(config.getWriteTimeout(), std::chrono::milliseconds(250));
+  EXPECT_EQ(config.getMinNumberCharRead(), 4);
+
+  // Integer baud rates are accepted as well
+  config.setBaudRate(250000);
+  EXPECT_EQ(config.getBaudRate(), 250000u);
+}
@@ -0,0 +1,222 @@
+// Copyright 2020-2025 Nestor Neto
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "libserial/serial_coroutine.hpp"
+#include "libserial/serial_exception.hpp"
+#include "libserial/serial_executor.hpp"
+
+#include "raw_pty_test.hpp"
+
+// Pseudo-terminal pairs whose slaves are driven by coroutines
+class SerialCoroutineTest : public ::testing::Test {
+protected:
+std::vector<int> master_fd_;
+std::vector<std::unique_ptr<libserial::Serial>> serial_;
+
+void openPorts(size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    int master = -1;
+    auto serial = std::make_unique<libserial::Serial>();
+    RawPtyTest::openRawPty(*serial, master);
+    if (master != -1) {
+      master_fd_.push_back(master);
+    }
+    ASSERT_FALSE(HasFatalFailure());
+    serial_.push_back(std::move(serial));
+  }
+}
+
+void TearDown() override {
+  serial_.clear();
+  for (int fd : master_fd_) {
+    close(fd);
+  }
+}
+
+void writeMaster(size_t index, const std::string& data) {
+  ASSERT_EQ(write(master_fd_[index], data.data(), data.size()),
+            static_cast<ssize_t>(data.size()));
+}
+};
+
+namespace {
+
+libserial::Task<std::string> readLine(libserial::Serial& serial) {
+  std::string line = co_await serial.asyncReadUntil('\n');
+  co_return line;
+}
+
+}  // namespace
+
+TEST_F(SerialCoroutineTest, RequestResponse) {
+  openPorts(1);
+  libserial::SerialExecutor executor;
+  std::vector<std::string> lines;
+  size_t written = 0;
+
+  // Two lines arrive in one chunk; the second must stay buffered
+  writeMaster(0, "pong\nnext\n");
+
+  libserial::spawn(executor, [](libserial::Serial& serial, std::vector<std::string>& out,
+                                size_t& bytes) -> libserial::Task<> {
+      bytes = co_await serial.asyncWrite(std::string("ping"));
+      out.push_back(co_await readLine(serial));
+      out.push_back(co_await serial.asyncReadUntil('\n'));
+    }(*serial_[0], lines, written));
+  executor.run();
+
+  EXPECT_EQ(written, 4u);
+  ASSERT_EQ(lines.size(), 2u);
+  EXPECT_EQ(lines[0], "pong\n");
+  EXPECT_EQ(lines[1], "next\n");
+
+  char buffer[16] = {};
+  ASSERT_EQ(read(master_fd_[0], buffer, sizeof(buffer)), 4);
+  EXPECT_EQ(std::string(buffer, 4), "ping");
+}
+
+TEST_F(SerialCoroutineTest, ReadBytesSuspendsUntilComplete) {
+  openPorts(1);
+  libserial::SerialExecutor executor;
+  std::string result;
+
+  libserial::spawn(executor, [](libserial::Serial& serial,
+                                std::string& out) -> libserial::Task<> {
+      out = co_await serial.asyncReadBytes(6);
+    }(*serial_[0], result));
+
+  std::thread writer([this]() {
+      writeMaster(0, "abc");
+      std::this_thread::sleep_for(std::chrono::milliseconds(30));
+      writeMaster(0, "defgh");
+    });
+  executor.run();
+  writer.join();
+
+  EXPECT_EQ(result, "abcdef");
+}
+
+TEST_F(SerialCoroutineTest, OneThreadDrivesManyPorts) {
+  constexpr size_t kPorts = 200;
+  openPorts(kPorts);
+  libserial::SerialExecutor executor;
+  size_t completed = 0;
+
+  for (size_t i = 0; i < kPorts; ++i) {
+    libserial::spawn(executor, [](libserial::Serial& serial, size_t index,
+                                  size_t& done) -> libserial::Task<> {
+        std::string line = co_await serial.asyncReadUntil('\n');
+        if (line == "port " + std::to_string(index) + "\n") {
+          done++;
+        }
+      }(*serial_[i], i, completed));
+  }
+
+  // Every coroutine is parked before any data arrives
+  executor.runOnce(std::chrono::milliseconds(0));
+  EXPECT_EQ(executor.getPendingCount(), kPorts);
+
+  for (size_t i = 0; i < kPorts; ++i) {
+    writeMaster(i, "port " + std::to_string(i) + "\n");
+  }
+  executor.run();
+
+  EXPECT_EQ(completed, kPorts);
+  EXPECT_EQ(executor.getPendingCount(), 0u);
+}
+
+TEST_F(SerialCoroutineTest, ErrorsPropagateToAwaiter) {
+  openPorts(1);
+  libserial::SerialExecutor executor;
+  bool caught = false;
+
+  libserial::spawn(executor, [](libserial::Serial& serial, bool& flag) -> libserial::Task<> {
+      try {
+        co_await readLine(serial);
+      }
+      catch (const libserial::IOException&) {
+        flag = true;
+      }
+    }(*serial_[0], caught));
+
+  executor.runOnce(std::chrono::milliseconds(0));
+  close(master_fd_[0]);
+  master_fd_.clear();
+  executor.run();
+
+  EXPECT_TRUE(caught);
+}
+
+TEST_F(SerialCoroutineTest, LineTooLongIsReported) {
+  openPorts(1);
+  serial_[0]->setMaxSafeReadSize(8);
+  libserial::SerialExecutor executor;
+  std::string message;
+
+  writeMaster(0, "0123456789\n");
+  libserial::spawn(executor, [](libserial::Serial& serial, std::string& out) -> libserial::Task<> {
+      try {
+        co_await serial.asyncReadUntil('\n');
+      }
+      catch (const libserial::IOException& e) {
+        out = e.what();
+      }
+    }(*serial_[0], message));
+  executor.run();
+
+  EXPECT_EQ(message, "Read buffer exceeded maximum size limit of 8 bytes without finding terminator");
+}
+
+TEST(SerialExecutorTest, PostAndWaitContinuations) {
+  libserial::SerialExecutor executor;
+  int pipe_fd[2];
+  ASSERT_EQ(pipe(pipe_fd), 0);
+
+  int posted = 0;
+  int readable = 0;
+  executor.post([](void* context, bool) {
+      (*static_cast<int*>(context))++;
+    }, &posted);
+  executor.waitReadable(pipe_fd[0], [](void* context, bool) {
+      (*static_cast<int*>(context))++;
+    }, &readable);
+  EXPECT_THROW(executor.waitReadable(pipe_fd[0], nullptr, nullptr), libserial::SerialException);
+  EXPECT_EQ(executor.getPendingCount(), 2u);
+
+  executor.runOnce(std::chrono::milliseconds(0));
+  EXPECT_EQ(posted, 1);
+  EXPECT_EQ(readable, 0);
+
+  ASSERT_EQ(write(pipe_fd[1], "x", 1), 1);
+  executor.run();
+  EXPECT_EQ(readable, 1);
+  EXPECT_EQ(executor.getPendingCount(), 0u);
+
+  close(pipe_fd[0]);
+  close(pipe_fd[1]);
+}
+
+TEST(SerialExecutorTest, StopInterruptsRun) {
+  libserial::SerialExecutor executor;
+  int pipe_fd[2];
+  ASSERT_EQ(pipe(pipe_fd), 0);
+  executor.waitReadable(pipe_fd[0], [](void*, bool) {}, nullptr);
+
+  std::thread runner([&executor]() { executor.run(); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  executor.stop();
+  runner.join();
+
+  EXPECT_EQ(executor.getPendingCount(), 1u);
+  close(pipe_fd[0]);
+  close(pipe_fd[1]);
+}
@@ -8,6 +8,8 @@
 #include <memory>
 #include <string>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 #include <sys/types.h>
@@ -16,6 +18,7 @@
 #include <unistd.h>
 #include <string.h>
 #include <sys/ioctl.h>
+#include <linux/serial.h>
 
 #include "libserial/serial.hpp"
 #include "libserial/serial_exception.hpp"
@@ -730,3 +733,963 @@ TEST_F(PseudoTerminalTest, ReadUntilWithOverflowBuffer) {
     }
   }, libserial::IOException);
 }
+
+TEST_F(PseudoTerminalTest, ReadUntilKeepsLeftoverBuffered) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(9600);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+
+  const std::string test_message = "first\nsecond\nthird";
+
+  ssize_t bytes_written = write(master_fd_, test_message.c_str(), test_message.length());
+  ASSERT_GT(bytes_written, 0) << "Failed to write to master end";
+
+  // Give time for data to propagate
+  fsync(master_fd_);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  auto read_buffer = std::make_shared<std::string>();
+
+  EXPECT_EQ(serial_port.readUntil(read_buffer, '\n'), 6u);
+  EXPECT_EQ(*read_buffer, "first\n");
+
+  // The remaining bytes were pulled in by the same bulk read
+  EXPECT_EQ(serial_port.getAvailableData(), 12);
+
+  EXPECT_EQ(serial_port.readUntil(read_buffer, '\n'), 7u);
+  EXPECT_EQ(*read_buffer, "second\n");
+
+  EXPECT_EQ(serial_port.readBytes(read_buffer, 3), 3u);
+  EXPECT_EQ(*read_buffer, "thi");
+
+  EXPECT_EQ(serial_port.readBytes(read_buffer, 10), 2u);
+  EXPECT_EQ(*read_buffer, "rd");
+}
+
+TEST_F(PseudoTerminalTest, ReadUntilUsesBulkReads) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(9600);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+
+  size_t read_calls = 0;
+  serial_port.setReadSystemFunction(
+    [&read_calls](int fd, void* buf, size_t sz) -> ssize_t {
+    read_calls++;
+    return ::read(fd, buf, sz);
+  });
+
+  const std::string test_message = std::string(200, 'x') + "\n";
+
+  ssize_t bytes_written = write(master_fd_, test_message.c_str(), test_message.length());
+  ASSERT_GT(bytes_written, 0) << "Failed to write to master end";
+
+  // Give time for data to propagate
+  fsync(master_fd_);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  auto read_buffer = std::make_shared<std::string>();
+
+  EXPECT_EQ(serial_port.readUntil(read_buffer, '\n'), test_message.length());
+  EXPECT_EQ(*read_buffer, test_message);
+  EXPECT_EQ(read_calls, 1u);
+}
+
+TEST_F(PseudoTerminalTest, ReadLinesReturnsBurstWithOneRead) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  serial_port.setReadTimeout(std::chrono::milliseconds(1000));
+
+  size_t read_calls = 0;
+  serial_port.setReadSystemFunction(
+    [&read_calls](int fd, void* buf, size_t sz) -> ssize_t {
+    read_calls++;
+    return ::read(fd, buf, sz);
+  });
+
+  const std::string burst = "t=1\nt=22\nt=333\npart";
+  ASSERT_EQ(write(master_fd_, burst.c_str(), burst.length()),
+            static_cast<ssize_t>(burst.length()));
+  fsync(master_fd_);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  const auto& lines = serial_port.readLines();
+  ASSERT_EQ(lines.size(), 3u);
+  EXPECT_EQ(lines[0], "t=1\n");
+  EXPECT_EQ(lines[1], "t=22\n");
+  EXPECT_EQ(lines[2], "t=333\n");
+  EXPECT_EQ(read_calls, 1u);
+
+  // The partial line is completed by the next burst
+  ASSERT_EQ(write(master_fd_, "ial\nend\n", 8), 8);
+  const auto& next = serial_port.readLines();
+  ASSERT_EQ(next.size(), 2u);
+  EXPECT_EQ(next[0], "partial\n");
+  EXPECT_EQ(next[1], "end\n");
+  EXPECT_EQ(read_calls, 2u);
+
+  // Lines already buffered are returned without touching the port
+  ASSERT_EQ(write(master_fd_, "ab\ncd\n", 6), 6);
+  fsync(master_fd_);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  auto buffer = std::make_shared<std::string>();
+  EXPECT_EQ(serial_port.readBytes(buffer, 1), 1u);
+  const auto& buffered = serial_port.readLines();
+  ASSERT_EQ(buffered.size(), 2u);
+  EXPECT_EQ(buffered[0], "b\n");
+  EXPECT_EQ(read_calls, 3u);
+}
+
+TEST_F(PseudoTerminalTest, ReadLinesLimitsAndTimeout) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  serial_port.setReadTimeout(std::chrono::milliseconds(100));
+
+  EXPECT_THROW(serial_port.readLines(), libserial::IOException);
+
+  serial_port.setMaxSafeReadSize(16);
+  const std::string unterminated(16, 'x');
+  ASSERT_EQ(write(master_fd_, unterminated.c_str(), unterminated.length()),
+            static_cast<ssize_t>(unterminated.length()));
+  EXPECT_THROW(serial_port.readLines(), libserial::IOException);
+}
+
+TEST_F(PseudoTerminalTest, TryReadUntilReportsOutcomes) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  serial_port.setReadTimeout(std::chrono::milliseconds(100));
+
+  char buffer[16];
+  libserial::IoResult result = serial_port.tryReadUntil(buffer, sizeof(buffer), '\n');
+  EXPECT_EQ(result.getStatus(), libserial::IoStatus::TIMEOUT);
+  EXPECT_STREQ(result.getMessage(), "Read timeout exceeded while waiting for data");
+  EXPECT_EQ(result.getBytes(), 0u);
+
+  const std::string test_message = "abc\nde";
+  ASSERT_EQ(write(master_fd_, test_message.c_str(), test_message.length()),
+            static_cast<ssize_t>(test_message.length()));
+
+  result = serial_port.tryReadUntil(buffer, sizeof(buffer), '\n');
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(std::string(buffer, result.getBytes()), "abc\n");
+
+  // The partial line is stored before the timeout and reported in getBytes()
+  result = serial_port.tryReadUntil(buffer, sizeof(buffer), std::string_view("\r\n"));
+  EXPECT_EQ(result.getStatus(), libserial::IoStatus::TIMEOUT);
+  EXPECT_EQ(result.getBytes(), 1u);
+  EXPECT_EQ(buffer[0], 'd');
+
+  ASSERT_EQ(write(master_fd_, "xxxxxxxx", 8), 8);
+  result = serial_port.tryReadUntil(buffer, 4, '\n');
+  EXPECT_EQ(result.getStatus(), libserial::IoStatus::LIMIT_EXCEEDED);
+
+  EXPECT_EQ(serial_port.tryReadUntil(nullptr, 4, '\n').getStatus(),
+            libserial::IoStatus::INVALID_ARGUMENT);
+  EXPECT_EQ(serial_port.tryReadUntil(buffer, 4, std::string_view()).getStatus(),
+            libserial::IoStatus::INVALID_ARGUMENT);
+}
+
+TEST_F(PseudoTerminalTest, TryReadAndTryReadBytesReportTimeouts) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::ENABLE);
+
+  char buffer[16];
+  serial_port.setReadTimeout(std::chrono::milliseconds(0));
+  EXPECT_EQ(serial_port.tryRead(buffer, sizeof(buffer)).getStatus(),
+            libserial::IoStatus::WOULD_BLOCK);
+  serial_port.setReadTimeout(std::chrono::milliseconds(100));
+  EXPECT_EQ(serial_port.tryRead(buffer, sizeof(buffer)).getStatus(),
+            libserial::IoStatus::TIMEOUT);
+  EXPECT_EQ(serial_port.tryReadBytes(buffer, sizeof(buffer)).getStatus(),
+            libserial::IoStatus::INVALID_ARGUMENT);
+
+  ASSERT_EQ(write(master_fd_, "hi\n", 3), 3);
+  libserial::IoResult result = serial_port.tryRead(buffer, sizeof(buffer));
+  ASSERT_TRUE(result);
+  EXPECT_EQ(std::string(buffer, result.getBytes()), "hi\n");
+
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  serial_port.setMinNumberCharRead(0);
+  EXPECT_EQ(serial_port.tryReadBytes(buffer, sizeof(buffer)).getStatus(),
+            libserial::IoStatus::TIMEOUT);
+  serial_port.setReadTimeout(std::chrono::milliseconds(0));
+  EXPECT_EQ(serial_port.tryReadBytes(buffer, sizeof(buffer)).getStatus(),
+            libserial::IoStatus::WOULD_BLOCK);
+  EXPECT_EQ(serial_port.tryRead(buffer, sizeof(buffer)).getStatus(),
+            libserial::IoStatus::INVALID_ARGUMENT);
+}
+
+TEST_F(PseudoTerminalTest, TryReadReportsSystemErrors) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::ENABLE);
+
+  serial_port.setPollSystemFunction(
+    [](struct pollfd*, nfds_t, int) -> int {
+    errno = EINTR;
+    return -1;
+  });
+
+  char buffer[16];
+  libserial::IoResult result = serial_port.tryRead(buffer, sizeof(buffer));
+  EXPECT_EQ(result.getStatus(), libserial::IoStatus::SYSTEM_ERROR);
+  EXPECT_EQ(result.getErrno(), EINTR);
+  EXPECT_STREQ(result.getMessage(), "Error in poll()");
+
+  serial_port.setPollSystemFunction(
+    [](struct pollfd*, nfds_t, int) -> int {
+    return 1;
+  });
+  serial_port.setReadSystemFunction(
+    [](int, void*, size_t) -> ssize_t {
+    errno = EIO;
+    return -1;
+  });
+
+  result = serial_port.tryReadUntil(buffer, sizeof(buffer), '\n');
+  EXPECT_EQ(result.getStatus(), libserial::IoStatus::SYSTEM_ERROR);
+  EXPECT_EQ(result.getErrno(), EIO);
+  EXPECT_STREQ(result.getMessage(), "Error reading from serial port");
+}
+
+TEST_F(PseudoTerminalTest, TryWriteReportsBytesOnTimeout) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(115200);
+  serial_port.setWriteTimeout(std::chrono::milliseconds(200));
+
+  libserial::IoResult result = serial_port.tryWrite("ping", 4);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result.getBytes(), 4u);
+  EXPECT_EQ(serial_port.tryWrite(nullptr, 4).getStatus(), libserial::IoStatus::INVALID_ARGUMENT);
+
+  // Nobody drains the master side, so the output queue fills up
+  const std::string payload(1024 * 1024, 't');
+  result = serial_port.tryWrite(payload.data(), payload.size());
+  EXPECT_EQ(result.getStatus(), libserial::IoStatus::TIMEOUT);
+  EXPECT_GT(result.getBytes(), 0u);
+  EXPECT_LT(result.getBytes(), payload.size());
+}
+
+TEST_F(PseudoTerminalTest, LowLatencyModeTunesVminVtimeAndRestores) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  serial_port.setReadTimeout(std::chrono::milliseconds(100));
+  serial_port.setMinNumberCharRead(1);
+
+  // A pseudo-terminal has no TIOCGSERIAL; the mode still applies
+  serial_port.setLowLatencyMode(true);
+  EXPECT_TRUE(serial_port.isLowLatencyMode());
+  EXPECT_EQ(serial_port.getSpinTime(), std::chrono::microseconds(50));
+
+  struct termios2 tty;
+  ASSERT_EQ(ioctl(serial_port.getFileDescriptor(), TCGETS2, &tty), 0);
+  EXPECT_EQ(tty.c_cc[VMIN], 0);
+  EXPECT_EQ(tty.c_cc[VTIME], 0);
+
+  // The read timeout now comes from poll()
+  char buffer[16];
+  auto start_time = std::chrono::steady_clock::now();
+  EXPECT_EQ(serial_port.readBytes(buffer, sizeof(buffer)), 0u);
+  EXPECT_GE(std::chrono::steady_clock::now() - start_time, std::chrono::milliseconds(90));
+
+  ASSERT_EQ(write(master_fd_, "ab\n", 3), 3);
+  EXPECT_EQ(serial_port.readBytes(buffer, 2), 2u);
+  auto line = std::make_shared<std::string>();
+  EXPECT_EQ(serial_port.readUntil(line, '\n'), 1u);
+  EXPECT_EQ(*line, "\n");
+
+  serial_port.setLowLatencyMode(false);
+  EXPECT_FALSE(serial_port.isLowLatencyMode());
+  EXPECT_EQ(serial_port.getSpinTime(), std::chrono::microseconds(0));
+  ASSERT_EQ(ioctl(serial_port.getFileDescriptor(), TCGETS2, &tty), 0);
+  EXPECT_EQ(tty.c_cc[VMIN], 1);
+  EXPECT_EQ(tty.c_cc[VTIME], 1);
+}
+
+TEST_F(PseudoTerminalTest, LowLatencyModeKeepsSettingsMadeWhileEnabled) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  serial_port.setReadTimeout(std::chrono::milliseconds(500));
+  serial_port.setMinNumberCharRead(1);
+  serial_port.setLowLatencyMode(true);
+
+  serial_port.setReadTimeout(std::chrono::milliseconds(2000));
+  serial_port.setMinNumberCharRead(5);
+
+  // Reported, but not written to the kernel while the mode is on
+  EXPECT_EQ(serial_port.getReadTimeout(), std::chrono::milliseconds(2000));
+  EXPECT_EQ(serial_port.getMinNumberCharRead(), 5);
+  struct termios2 tty;
+  ASSERT_EQ(ioctl(serial_port.getFileDescriptor(), TCGETS2, &tty), 0);
+  EXPECT_EQ(tty.c_cc[VMIN], 0);
+  EXPECT_EQ(tty.c_cc[VTIME], 0);
+
+  libserial::SerialConfig config;
+  config.setReadTimeout(std::chrono::milliseconds(3000));
+  serial_port.applyConfig(config);
+  ASSERT_EQ(ioctl(serial_port.getFileDescriptor(), TCGETS2, &tty), 0);
+  EXPECT_EQ(tty.c_cc[VTIME], 0);
+  EXPECT_EQ(serial_port.getReadTimeout(), std::chrono::milliseconds(3000));
+  EXPECT_EQ(serial_port.getMinNumberCharRead(), 5);
+
+  serial_port.setLowLatencyMode(false);
+  ASSERT_EQ(ioctl(serial_port.getFileDescriptor(), TCGETS2, &tty), 0);
+  EXPECT_EQ(tty.c_cc[VMIN], 5);
+  EXPECT_EQ(tty.c_cc[VTIME], 30);
+  EXPECT_EQ(serial_port.getReadTimeout(), std::chrono::milliseconds(3000));
+  EXPECT_EQ(serial_port.getMinNumberCharRead(), 5);
+}
+
+TEST_F(PseudoTerminalTest, LowLatencyModeSetsDriverFlag) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+
+  // Pretend to be a UART driver that supports TIOCGSERIAL
+  int flags = 0;
+  serial_port.setIoctlSystemFunction(
+    [&flags](int fd, unsigned long request, void* arg) -> int {  // NOLINT
+    auto* info = static_cast<struct serial_struct*>(arg);
+    if (request == TIOCGSERIAL) {
+      *info = {};
+      info->flags = flags;
+      return 0;
+    }
+    if (request == TIOCSSERIAL) {
+      flags = info->flags;
+      return 0;
+    }
+    return ::ioctl(fd, request, arg);
+  });
+
+  serial_port.setLowLatencyMode(true, std::chrono::microseconds(0));
+  EXPECT_TRUE(flags & ASYNC_LOW_LATENCY);
+  EXPECT_EQ(serial_port.getSpinTime(), std::chrono::microseconds(0));
+
+  serial_port.setLowLatencyMode(false);
+  EXPECT_FALSE(flags & ASYNC_LOW_LATENCY);
+
+  serial_port.setIoctlSystemFunction(
+    [](int fd, unsigned long request, void* arg) -> int {  // NOLINT
+    if (request == TIOCGSERIAL) {
+      errno = EIO;
+      return -1;
+    }
+    return ::ioctl(fd, request, arg);
+  });
+  EXPECT_THROW(serial_port.setLowLatencyMode(true), libserial::SerialException);
+  EXPECT_FALSE(serial_port.isLowLatencyMode());
+}
+
+TEST_F(PseudoTerminalTest, FlushInputBufferDropsBufferedData) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(9600);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+
+  const std::string test_message = "abc!def";
+
+  ssize_t bytes_written = write(master_fd_, test_message.c_str(), test_message.length());
+  ASSERT_GT(bytes_written, 0) << "Failed to write to master end";
+
+  // Give time for data to propagate
+  fsync(master_fd_);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  auto read_buffer = std::make_shared<std::string>();
+  EXPECT_NO_THROW({ serial_port.readUntil(read_buffer, '!'); });
+  EXPECT_EQ(*read_buffer, "abc!");
+
+  EXPECT_NO_THROW(serial_port.flushInputBuffer());
+  EXPECT_EQ(serial_port.getAvailableData(), 0);
+}
+
+TEST_F(PseudoTerminalTest, RawPointerWriteAndRead) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(115200);
+
+  const char payload[] = "Raw Write";
+  size_t bytes_written = 0;
+  EXPECT_NO_THROW({ bytes_written = serial_port.write(payload, sizeof(payload) - 1); });
+  EXPECT_EQ(bytes_written, sizeof(payload) - 1);
+
+  // Give time for data to propagate
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  char received[32] = {0};
+  ssize_t master_read = read(master_fd_, received, sizeof(received));
+  ASSERT_GT(master_read, 0);
+  EXPECT_EQ(std::string(received, master_read), "Raw Write");
+
+  // Echo a line back and read it straight into a fixed array
+  ssize_t echoed = write(master_fd_, "Raw Read\n", 9);
+  ASSERT_EQ(echoed, 9);
+  fsync(master_fd_);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  char line[32];
+  size_t bytes_read = serial_port.read(line, sizeof(line));
+  EXPECT_EQ(std::string(line, bytes_read), "Raw Read\n");
+}
+
+TEST_F(PseudoTerminalTest, PooledReadsRecycleBuffers) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::ENABLE);
+  libserial::BufferPool::trim();
+
+  ASSERT_EQ(write(master_fd_, "line one\n", 9), 9);
+  const char* slab = nullptr;
+  {
+    libserial::PooledBuffer buffer = serial_port.readPooled();
+    EXPECT_EQ(buffer.view(), "line one\n");
+    EXPECT_GE(buffer.capacity(), serial_port.getMaxSafeReadSize());
+    slab = buffer.data();
+  }
+
+  // The next read of the same size reuses the dropped slab
+  ASSERT_EQ(write(master_fd_, "line two\n", 9), 9);
+  libserial::PooledBuffer buffer = serial_port.readPooled();
+  EXPECT_EQ(buffer.view(), "line two\n");
+  EXPECT_EQ(buffer.data(), slab);
+
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  ASSERT_EQ(write(master_fd_, "HDR;abc##xyz", 12), 12);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(serial_port.readUntilPooled(';').view(), "HDR;");
+  EXPECT_EQ(serial_port.readUntilPooled(std::string_view("##")).view(), "abc##");
+  EXPECT_EQ(serial_port.readBytesPooled(3).view(), "xyz");
+  EXPECT_THROW(serial_port.readBytesPooled(0), libserial::IOException);
+
+  libserial::BufferPool::trim();
+}
+
+TEST_F(PseudoTerminalTest, RawPointerReadBytesAndReadUntil) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(9600);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+
+  const std::string test_message = "HDR:payload;tail";
+
+  ssize_t bytes_written = write(master_fd_, test_message.c_str(), test_message.length());
+  ASSERT_GT(bytes_written, 0) << "Failed to write to master end";
+
+  fsync(master_fd_);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  char header[4];
+  EXPECT_EQ(serial_port.readBytes(header, sizeof(header)), sizeof(header));
+  EXPECT_EQ(std::string(header, sizeof(header)), "HDR:");
+
+  char body[16];
+  size_t body_size = serial_port.readUntil(body, sizeof(body), ';');
+  EXPECT_EQ(std::string(body, body_size), "payload;");
+
+  // A destination smaller than the pending data is reported as overflow
+  char small[2];
+  EXPECT_THROW(serial_port.readUntil(small, sizeof(small), '!'), libserial::IOException);
+}
+
+TEST_F(PseudoTerminalTest, ReadUntilMultiByteDelimiterAcrossReads) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  serial_port.setReadTimeout(std::chrono::milliseconds(1000));
+
+  // Keep '\r' intact instead of translating it to '\n'
+  struct termios2 tty;
+  ASSERT_EQ(ioctl(serial_port.getFileDescriptor(), TCGETS2, &tty), 0);
+  tty.c_iflag &= ~(INLCR | IGNCR | ICRNL);
+  ASSERT_EQ(ioctl(serial_port.getFileDescriptor(), TCSETS2, &tty), 0);
+
+  // The delimiter arrives split over two reads
+  std::thread writer([this]() {
+    ASSERT_EQ(write(master_fd_, "+CSQ: 21,0\r", 11), 11);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(write(master_fd_, "\nO\r\nOK\r\nnext", 12), 12);
+  });
+
+  auto read_buffer = std::make_shared<std::string>();
+  EXPECT_EQ(serial_port.readUntil(read_buffer, "\r\n"), 12u);
+  EXPECT_EQ(*read_buffer, "+CSQ: 21,0\r\n");
+
+  // A partial match ("O\r\n") does not end an "OK\r\n" read
+  char line[16];
+  size_t size = serial_port.readUntil(line, sizeof(line), "OK\r\n");
+  EXPECT_EQ(std::string(line, size), "O\r\nOK\r\n");
+  writer.join();
+
+  EXPECT_EQ(serial_port.getAvailableData(), 4);
+}
+
+TEST_F(PseudoTerminalTest, ReadUntilMultiByteDelimiterErrors) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  serial_port.setReadTimeout(std::chrono::milliseconds(100));
+
+  auto read_buffer = std::make_shared<std::string>();
+  EXPECT_THROW(serial_port.readUntil(read_buffer, std::string_view()), libserial::IOException);
+  EXPECT_THROW(serial_port.readUntil(read_buffer, std::string(4096, '!')),
+               libserial::IOException);
+
+  // Held-back bytes of a possible delimiter count against the limit
+  ASSERT_EQ(write(master_fd_, "abcdefgh", 8), 8);
+  char small[8];
+  EXPECT_THROW(serial_port.readUntil(small, sizeof(small), "--"), libserial::IOException);
+
+  // No delimiter before the read timeout
+  ASSERT_EQ(write(master_fd_, "abc-", 4), 4);
+  EXPECT_THROW(serial_port.readUntil(read_buffer, "--"), libserial::IOException);
+}
+
+TEST_F(PseudoTerminalTest, RawPointerNullBuffers) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+
+  EXPECT_THROW(serial_port.write(nullptr, 4), libserial::IOException);
+  EXPECT_THROW(serial_port.read(nullptr, 4), libserial::IOException);
+  EXPECT_THROW(serial_port.readUntil(nullptr, 4, '\n'), libserial::IOException);
+
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  EXPECT_THROW(serial_port.readBytes(nullptr, 4), libserial::IOException);
+}
+
+TEST_F(PseudoTerminalTest, WriteLargePayloadCompletes) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(115200);
+  serial_port.setWriteTimeout(std::chrono::milliseconds(2000));
+
+  // Larger than the pty output queue, so the write has to wait for room
+  const std::string payload(256 * 1024, 'w');
+
+  size_t drained = 0;
+  std::thread reader([this, &drained, &payload]() {
+      char chunk[4096];
+      while (drained < payload.size()) {
+        ssize_t n = read(master_fd_, chunk, sizeof(chunk));
+        if (n <= 0) {
+          break;
+        }
+        drained += static_cast<size_t>(n);
+      }
+    });
+
+  size_t bytes_written = 0;
+  EXPECT_NO_THROW({ bytes_written = serial_port.write(payload.data(), payload.size()); });
+  reader.join();
+
+  EXPECT_EQ(bytes_written, payload.size());
+  EXPECT_EQ(drained, payload.size());
+}
+
+TEST_F(PseudoTerminalTest, WriteTimeoutReportsBytesWritten) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(115200);
+  serial_port.setWriteTimeout(std::chrono::milliseconds(200));
+
+  // Nobody drains the master side, so the output queue fills up
+  const std::string payload(1024 * 1024, 't');
+
+  auto start_time = std::chrono::steady_clock::now();
+  try {
+    serial_port.write(payload.data(), payload.size());
+    FAIL() << "Expected libserial::TimeoutException";
+  }
+  catch (const libserial::TimeoutException& e) {
+    EXPECT_GT(e.bytesTransferred(), 0u);
+    EXPECT_LT(e.bytesTransferred(), payload.size());
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start_time;
+  EXPECT_GE(elapsed, std::chrono::milliseconds(190));
+  EXPECT_LT(elapsed, std::chrono::milliseconds(2000));
+}
+
+TEST_F(PseudoTerminalTest, WritevSendsAllSegments) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(115200);
+
+  std::string header{"<HDR>"};
+  std::string payload{"payload-owned-elsewhere"};
+  std::string trailer{"<CRC>"};
+
+  struct iovec segments[3];
+  segments[0].iov_base = header.data();
+  segments[0].iov_len = header.size();
+  segments[1].iov_base = payload.data();
+  segments[1].iov_len = payload.size();
+  segments[2].iov_base = trailer.data();
+  segments[2].iov_len = trailer.size();
+
+  size_t bytes_written = 0;
+  EXPECT_NO_THROW({ bytes_written = serial_port.writev(segments, 3); });
+  EXPECT_EQ(bytes_written, header.size() + payload.size() + trailer.size());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  char buffer[100] = {0};
+  ssize_t bytes_read = read(master_fd_, buffer, sizeof(buffer));
+  ASSERT_GT(bytes_read, 0);
+  EXPECT_EQ(std::string(buffer, bytes_read), header + payload + trailer);
+}
+
+TEST_F(PseudoTerminalTest, WritevManySegmentsAndPartialWrites) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(115200);
+  serial_port.setWriteTimeout(std::chrono::milliseconds(2000));
+
+  // More segments than one writev() window and more bytes than the queue holds
+  std::vector<std::string> parts;
+  std::string expected;
+  for (int i = 0; i < 200; ++i) {
+    parts.emplace_back(1000 + i, static_cast<char>('a' + i % 26));
+    parts.emplace_back();  // Empty segments are skipped
+    expected += parts[parts.size() - 2];
+  }
+
+  std::vector<struct iovec> segments(parts.size());
+  for (size_t i = 0; i < parts.size(); ++i) {
+    segments[i].iov_base = parts[i].data();
+    segments[i].iov_len = parts[i].size();
+  }
+
+  std::string received;
+  std::thread reader([this, &received, &expected]() {
+      char chunk[4096];
+      while (received.size() < expected.size()) {
+        ssize_t n = read(master_fd_, chunk, sizeof(chunk));
+        if (n <= 0) {
+          break;
+        }
+        received.append(chunk, static_cast<size_t>(n));
+      }
+    });
+
+  size_t bytes_written = 0;
+  EXPECT_NO_THROW({ bytes_written = serial_port.writev(segments.data(), segments.size()); });
+  reader.join();
+
+  EXPECT_EQ(bytes_written, expected.size());
+  EXPECT_TRUE(received == expected);
+}
+
+TEST_F(PseudoTerminalTest, WritevWithNullSegments) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+
+  EXPECT_THROW(serial_port.writev(nullptr, 2), libserial::IOException);
+  EXPECT_EQ(serial_port.writev(nullptr, 0), 0u);
+}
+
+TEST_F(PseudoTerminalTest, ApplyConfigUsesSingleSetIoctl) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+
+  int set_calls = 0;
+  /* *INDENT-OFF* */
+  serial_port.setIoctlSystemFunction(
+    [&set_calls](int fd, unsigned long request, void* arg) -> int {  // NOLINT
+    if (request == TCSETS2) {
+      set_calls++;
+    }
+    return ::ioctl(fd, request, arg);
+  });
+  /* *INDENT-ON* */
+
+  libserial::SerialConfig config;
+  config.setBaudRate(libserial::BaudRate::BAUD_RATE_57600);
+  config.setDataLength(libserial::DataLength::EIGHT);
+  config.setParity(libserial::Parity::DISABLE);
+  config.setStopBits(libserial::StopBits::ONE);
+  config.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  config.setReadTimeout(std::chrono::milliseconds(700));
+  config.setMinNumberCharRead(3);
+
+  EXPECT_NO_THROW(serial_port.applyConfig(config));
+  EXPECT_EQ(set_calls, 1);
+
+  EXPECT_EQ(serial_port.getBaudRate(), 57600);
+  EXPECT_EQ(serial_port.getDataLength(), libserial::DataLength::EIGHT);
+  EXPECT_EQ(serial_port.getReadTimeout().count(), 700);
+  EXPECT_EQ(serial_port.getMinNumberCharRead(), 3);
+
+  // Canonical mode was switched off, so readBytes() is now accepted
+  auto read_buffer = std::make_shared<std::string>();
+  ssize_t bytes_written = write(master_fd_, "cfg", 3);
+  ASSERT_EQ(bytes_written, 3);
+  EXPECT_EQ(serial_port.readBytes(read_buffer, 3), 3u);
+  EXPECT_EQ(*read_buffer, "cfg");
+}
+
+TEST_F(PseudoTerminalTest, OpenWithConfig) {
+  libserial::SerialConfig config;
+  config.setBaudRate(libserial::BaudRate::BAUD_RATE_230400);
+  config.setWriteTimeout(std::chrono::milliseconds(100));
+
+  libserial::Serial serial_port(slave_port_, config);
+  EXPECT_EQ(serial_port.getBaudRate(), 230400);
+
+  libserial::Serial other_port;
+  EXPECT_NO_THROW(other_port.open(slave_port_, config));
+  EXPECT_EQ(other_port.getBaudRate(), 230400);
+
+  EXPECT_THROW(libserial::Serial("/dev/nonexistent", config), libserial::SerialException);
+}
+
+TEST_F(PseudoTerminalTest, GettersDoNotIssueIoctl) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(115200);
+  serial_port.setMinNumberCharRead(2);
+
+  int ioctl_calls = 0;
+  /* *INDENT-OFF* */
+  serial_port.setIoctlSystemFunction(
+    [&ioctl_calls](int fd, unsigned long request, void* arg) -> int {  // NOLINT
+    ioctl_calls++;
+    return ::ioctl(fd, request, arg);
+  });
+  /* *INDENT-ON* */
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(serial_port.getBaudRate(), 115200);
+    EXPECT_EQ(serial_port.getDataLength(), libserial::DataLength::EIGHT);
+    EXPECT_EQ(serial_port.getMinNumberCharRead(), 2);
+    serial_port.getReadTimeout();
+  }
+  EXPECT_EQ(ioctl_calls, 0);
+}
+
+TEST_F(PseudoTerminalTest, RefreshConfigPicksUpExternalChanges) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(9600);
+
+  // Change the line settings behind the Serial object's back
+  struct termios2 external;
+  ASSERT_EQ(ioctl(slave_fd_, TCGETS2, &external), 0);
+  external.c_cflag &= ~CBAUD;
+  external.c_cflag |= BOTHER;
+  external.c_ispeed = 38400;
+  external.c_ospeed = 38400;
+  external.c_cc[VMIN] = 9;
+  ASSERT_EQ(ioctl(slave_fd_, TCSETS2, &external), 0);
+
+  // The cache still reports what this object applied
+  EXPECT_EQ(serial_port.getBaudRate(), 9600);
+
+  EXPECT_NO_THROW(serial_port.refreshConfig());
+  EXPECT_EQ(serial_port.getBaudRate(), 38400);
+  EXPECT_EQ(serial_port.getMinNumberCharRead(), 9);
+}
+
+TEST_F(PseudoTerminalTest, FailedSetKeepsCachedConfig) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setBaudRate(9600);
+
+  /* *INDENT-OFF* */
+  serial_port.setIoctlSystemFunction(
+    [](int, unsigned long, void*) -> int {  // NOLINT
+    errno = EIO;
+    return -1;
+  });
+  /* *INDENT-ON* */
+
+  EXPECT_THROW(serial_port.setBaudRate(115200), libserial::SerialException);
+  EXPECT_EQ(serial_port.getBaudRate(), 9600);
+}
+
+TEST_F(PseudoTerminalTest, SetStopBitsKeepsDataLength) {
+  libserial::Serial serial_port;
+
+  serial_port.open(slave_port_);
+  serial_port.setDataLength(libserial::DataLength::EIGHT);
+
+  serial_port.setStopBits(libserial::StopBits::TWO);
+  serial_port.setStopBits(libserial::StopBits::ONE);
+  EXPECT_EQ(serial_port.getDataLength(), libserial::DataLength::EIGHT);
+
+  serial_port.refreshConfig();
+  EXPECT_EQ(serial_port.getDataLength(), libserial::DataLength::EIGHT);
+}
+
+TEST_F(PseudoTerminalTest, AsyncReadDeliversLines) {
+  libserial::Serial serial_port;
+  serial_port.open(slave_port_);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::string> lines;
+  std::string data;
+
+  serial_port.onLine([&](const std::string& line) {
+      std::lock_guard<std::mutex> lock(mutex);
+      lines.push_back(line);
+      cv.notify_one();
+    });
+  serial_port.onData([&](const char* bytes, size_t size) {
+      std::lock_guard<std::mutex> lock(mutex);
+      data.append(bytes, size);
+    });
+  serial_port.startAsyncRead();
+  EXPECT_TRUE(serial_port.isAsyncReading());
+
+  // A line split across two writes is reassembled
+  ASSERT_EQ(write(master_fd_, "fir", 3), 3);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_EQ(write(master_fd_, "st\nsecond\n", 10), 10);
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2),
+                            [&lines]() { return lines.size() == 2; }));
+    EXPECT_EQ(lines[0], "first\n");
+    EXPECT_EQ(lines[1], "second\n");
+    EXPECT_EQ(data, "first\nsecond\n");
+  }
+
+  serial_port.stopAsyncRead();
+  EXPECT_FALSE(serial_port.isAsyncReading());
+}
+
+TEST_F(PseudoTerminalTest, AsyncReadStopInterruptsBlockedPoll) {
+  libserial::Serial serial_port;
+  serial_port.open(slave_port_);
+  serial_port.startAsyncRead();
+
+  // Nothing arrives, the reader sits in poll()
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  auto start_time = std::chrono::steady_clock::now();
+  serial_port.stopAsyncRead();
+  auto elapsed = std::chrono::steady_clock::now() - start_time;
+
+  EXPECT_LT(elapsed, std::chrono::milliseconds(100));
+  EXPECT_FALSE(serial_port.isAsyncReading());
+
+  // Restartable, and close() joins the thread
+  serial_port.startAsyncRead();
+  EXPECT_NO_THROW(serial_port.close());
+  EXPECT_FALSE(serial_port.isAsyncReading());
+}
+
+TEST_F(PseudoTerminalTest, AsyncReadInvalidUsage) {
+  libserial::Serial serial_port;
+  EXPECT_THROW(serial_port.startAsyncRead(), libserial::SerialException);
+
+  serial_port.open(slave_port_);
+  serial_port.startAsyncRead();
+  EXPECT_THROW(serial_port.startAsyncRead(), libserial::SerialException);
+  EXPECT_THROW(serial_port.onData(nullptr), libserial::SerialException);
+  EXPECT_THROW(serial_port.onLine(nullptr), libserial::SerialException);
+  EXPECT_THROW(serial_port.onError(nullptr), libserial::SerialException);
+  serial_port.stopAsyncRead();
+
+  EXPECT_NO_THROW(serial_port.onData(nullptr));
+}
+
+TEST_F(PseudoTerminalTest, AsyncReadReportsPollError) {
+  libserial::Serial serial_port;
+  serial_port.open(slave_port_);
+  serial_port.setPollSystemFunction([](struct pollfd*, nfds_t, int) {
+      errno = EBADF;
+      return -1;
+    });
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::string message;
+  serial_port.onError([&](const libserial::SerialException& error) {
+      std::lock_guard<std::mutex> lock(mutex);
+      message = error.what();
+      cv.notify_one();
+    });
+  serial_port.startAsyncRead();
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(2),
+                            [&message]() { return !message.empty(); }));
+  }
+  EXPECT_EQ(message, "Error in poll(): Bad file descriptor");
+
+  // The thread ended on its own; stop only joins it
+  EXPECT_TRUE(serial_port.isAsyncReading());
+  serial_port.stopAsyncRead();
+  EXPECT_FALSE(serial_port.isAsyncReading());
+}
+
+TEST_F(PseudoTerminalTest, ReadIntoFillsRingAcrossWrap) {
+  libserial::Serial serial_port;
+  serial_port.open(slave_port_);
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  serial_port.setReadTimeout(std::chrono::milliseconds(1000));
+
+  // Leave the free space split around the end of the storage
+  libserial::SpscRing ring(16);
+  ASSERT_EQ(ring.write("0123456789", 10), 10u);
+  char scratch[10];
+  ASSERT_EQ(ring.read(scratch, sizeof(scratch)), 10u);
+
+  ASSERT_EQ(write(master_fd_, "abcdefghijkl", 12), 12);
+  size_t stored = 0;
+  while (stored < 12) {
+    stored += serial_port.readInto(ring);
+  }
+
+  struct iovec regions[2];
+  ASSERT_EQ(ring.readableRegions(regions), 12u);
+  EXPECT_EQ(std::string(static_cast<char*>(regions[0].iov_base), regions[0].iov_len), "abcdef");
+  EXPECT_EQ(std::string(static_cast<char*>(regions[1].iov_base), regions[1].iov_len), "ghijkl");
+  ring.consume(12);
+
+  // A full ring is reported without touching the port
+  ASSERT_EQ(ring.write("0123456789abcdef", 16), 16u);
+  EXPECT_EQ(serial_port.readInto(ring), 0u);
+
+  serial_port.setReadTimeout(std::chrono::milliseconds(10));
+  ring.consume(16);
+  EXPECT_THROW(serial_port.readInto(ring), libserial::IOException);
+}
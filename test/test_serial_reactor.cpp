@@ -0,0 +1,289 @@
+// Copyright 2020-2025 Nestor Neto
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "libserial/io_uring.hpp"
+#include "libserial/serial.hpp"
+#include "libserial/serial_exception.hpp"
+#include "libserial/serial_reactor.hpp"
+#include "libserial/serial_stats.hpp"
+
+// Several pseudo-terminal pairs driven by one reactor, run against every backend
+class SerialReactorTest : public ::testing::TestWithParam<libserial::ReactorBackend> {
+protected:
+static constexpr int kPorts = 3;
+
+int master_fd_[kPorts];
+libserial::Serial serial_[kPorts];
+
+void SetUp() override {
+  for (int i = 0; i < kPorts; ++i) {
+    master_fd_[i] = posix_openpt(O_RDWR | O_NOCTTY);
+    ASSERT_NE(master_fd_[i], -1) << "Failed to open master pseudo-terminal";
+    ASSERT_EQ(grantpt(master_fd_[i]), 0);
+    ASSERT_EQ(unlockpt(master_fd_[i]), 0);
+
+    serial_[i].open(ptsname(master_fd_[i]));
+    serial_[i].setCanonicalMode(libserial::CanonicalMode::DISABLE);
+  }
+}
+
+void TearDown() override {
+  for (int i = 0; i < kPorts; ++i) {
+    serial_[i].close();
+    close(master_fd_[i]);
+  }
+}
+
+void writeMaster(int index, const std::string& data) {
+  ASSERT_EQ(write(master_fd_[index], data.data(), data.size()),
+            static_cast<ssize_t>(data.size()));
+}
+
+// Runs the reactor until the predicate holds or a deadline passes
+template <typename Predicate>
+void runUntil(libserial::SerialReactor& reactor, Predicate done) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (!done() && std::chrono::steady_clock::now() < deadline) {
+    reactor.runOnce(std::chrono::milliseconds(20));
+  }
+}
+};
+
+TEST_P(SerialReactorTest, LinesAreReassembledAcrossWakeups) {
+  libserial::SerialReactor reactor(GetParam());
+  std::vector<std::string> lines[kPorts];
+
+  for (int i = 0; i < kPorts; ++i) {
+    libserial::PortHandlers handlers;
+    handlers.on_line = [&lines, i](libserial::Serial&, const std::string& line) {
+        lines[i].push_back(line);
+      };
+    reactor.addPort(serial_[i], handlers);
+  }
+  EXPECT_EQ(reactor.getPortCount(), static_cast<size_t>(kPorts));
+
+  writeMaster(0, "hel");
+  writeMaster(1, "one\ntw");
+  runUntil(reactor, [&lines]() { return lines[1].size() == 1; });
+
+  writeMaster(0, "lo\nwor");
+  writeMaster(1, "o\n");
+  writeMaster(2, "solo\n");
+  runUntil(reactor, [&lines]() {
+      return lines[0].size() == 1 && lines[1].size() == 2 && lines[2].size() == 1;
+    });
+
+  writeMaster(0, "ld\n");
+  runUntil(reactor, [&lines]() { return lines[0].size() == 2; });
+
+  ASSERT_EQ(lines[0].size(), 2u);
+  EXPECT_EQ(lines[0][0], "hello\n");
+  EXPECT_EQ(lines[0][1], "world\n");
+  ASSERT_EQ(lines[1].size(), 2u);
+  EXPECT_EQ(lines[1][0], "one\n");
+  EXPECT_EQ(lines[1][1], "two\n");
+  ASSERT_EQ(lines[2].size(), 1u);
+  EXPECT_EQ(lines[2][0], "solo\n");
+}
+
+TEST_P(SerialReactorTest, DataHandlerSeesEveryByte) {
+  libserial::SerialReactor reactor(GetParam());
+  std::string received;
+
+  libserial::PortHandlers handlers;
+  handlers.on_data = [&received](libserial::Serial&, const char* data, size_t size) {
+      received.append(data, size);
+    };
+  reactor.addPort(serial_[0], handlers);
+
+  writeMaster(0, "raw bytes without terminator");
+  runUntil(reactor, [&received]() { return received.size() == 28; });
+
+  EXPECT_EQ(received, "raw bytes without terminator");
+  if (libserial::StatsRecorder::kEnabled) {
+    EXPECT_EQ(serial_[0].getStats().bytes_read, received.size());
+    EXPECT_GE(serial_[0].getStats().read_calls, 1u);
+  }
+}
+
+TEST_P(SerialReactorTest, BufferedBytesAreDeliveredOnRegistration) {
+  // One kernel read pulls the whole burst into the receive buffer
+  writeMaster(0, "first\nsecond\nthi");
+  serial_[0].setReadTimeout(std::chrono::milliseconds(1000));
+  auto first = std::make_shared<std::string>();
+  ASSERT_EQ(serial_[0].readUntil(first, '\n'), 6u);
+
+  libserial::SerialReactor reactor(GetParam());
+  std::vector<std::string> lines;
+  libserial::PortHandlers handlers;
+  handlers.on_line = [&lines](libserial::Serial&, const std::string& line) {
+      lines.push_back(line);
+    };
+  reactor.addPort(serial_[0], handlers);
+  ASSERT_EQ(lines.size(), 1u);
+  EXPECT_EQ(lines[0], "second\n");
+
+  writeMaster(0, "rd\n");
+  runUntil(reactor, [&lines]() { return lines.size() == 2; });
+  ASSERT_EQ(lines.size(), 2u);
+  EXPECT_EQ(lines[1], "third\n");
+}
+
+TEST_P(SerialReactorTest, ReadTimeoutComesFromSharedTimer) {
+  libserial::SerialReactor reactor(GetParam());
+  int timeouts[kPorts] = {0, 0, 0};
+
+  for (int i = 0; i < 2; ++i) {
+    libserial::PortHandlers handlers;
+    handlers.read_timeout = std::chrono::milliseconds(50 * (i + 1));
+    handlers.on_read_timeout = [&timeouts, i](libserial::Serial&) {
+        timeouts[i]++;
+      };
+    reactor.addPort(serial_[i], handlers);
+  }
+
+  auto start_time = std::chrono::steady_clock::now();
+  runUntil(reactor, [&timeouts]() { return timeouts[1] >= 1; });
+  auto elapsed = std::chrono::steady_clock::now() - start_time;
+
+  EXPECT_GE(timeouts[0], 1);
+  EXPECT_EQ(timeouts[1], 1);
+  EXPECT_GE(elapsed, std::chrono::milliseconds(90));
+}
+
+TEST_P(SerialReactorTest, SendFlushesQueuedOutput) {
+  libserial::SerialReactor reactor(GetParam());
+  reactor.addPort(serial_[0], libserial::PortHandlers());
+
+  // Larger than the pty queue, so part of it waits for EPOLLOUT
+  const std::string payload(256 * 1024, 's');
+  reactor.send(serial_[0], payload.data(), payload.size());
+
+  // The io_uring backend only writes once runOnce() submits the batch
+  fcntl(master_fd_[0], F_SETFL, fcntl(master_fd_[0], F_GETFL) | O_NONBLOCK);
+
+  size_t drained = 0;
+  char chunk[4096];
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (drained < payload.size() && std::chrono::steady_clock::now() < deadline) {
+    ssize_t n = read(master_fd_[0], chunk, sizeof(chunk));
+    if (n > 0) {
+      drained += static_cast<size_t>(n);
+    }
+    reactor.runOnce(std::chrono::milliseconds(1));
+  }
+
+  EXPECT_EQ(drained, payload.size());
+  if (libserial::StatsRecorder::kEnabled) {
+    EXPECT_EQ(serial_[0].getStats().bytes_written, payload.size());
+  }
+}
+
+TEST_P(SerialReactorTest, WriteTimeoutDropsQueuedOutput) {
+  libserial::SerialReactor reactor(GetParam());
+  size_t dropped = 0;
+
+  libserial::PortHandlers handlers;
+  handlers.write_timeout = std::chrono::milliseconds(50);
+  handlers.on_write_timeout = [&dropped](libserial::Serial&, size_t bytes) {
+      dropped = bytes;
+    };
+  reactor.addPort(serial_[0], handlers);
+
+  // Nobody drains the master side
+  const std::string payload(1024 * 1024, 'q');
+  reactor.send(serial_[0], payload.data(), payload.size());
+  runUntil(reactor, [&dropped]() { return dropped > 0; });
+
+  EXPECT_GT(dropped, 0u);
+  EXPECT_LT(dropped, payload.size());
+}
+
+TEST_P(SerialReactorTest, RemovePortFromHandler) {
+  libserial::SerialReactor reactor(GetParam());
+  int calls = 0;
+
+  libserial::PortHandlers handlers;
+  handlers.on_line = [&reactor, &calls](libserial::Serial& serial, const std::string&) {
+      calls++;
+      reactor.removePort(serial);
+    };
+  reactor.addPort(serial_[0], handlers);
+
+  writeMaster(0, "a\nb\nc\n");
+  runUntil(reactor, [&calls]() { return calls > 0; });
+  reactor.runOnce(std::chrono::milliseconds(20));
+
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(reactor.getPortCount(), 0u);
+}
+
+TEST_P(SerialReactorTest, StopInterruptsRun) {
+  libserial::SerialReactor reactor(GetParam());
+  reactor.addPort(serial_[0], libserial::PortHandlers());
+
+  std::thread runner([&reactor]() { reactor.run(); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  auto start_time = std::chrono::steady_clock::now();
+  reactor.stop();
+  runner.join();
+
+  EXPECT_LT(std::chrono::steady_clock::now() - start_time, std::chrono::milliseconds(500));
+}
+
+TEST_P(SerialReactorTest, InvalidRegistration) {
+  libserial::SerialReactor reactor(GetParam());
+  libserial::Serial closed_port;
+
+  EXPECT_THROW(reactor.addPort(closed_port, libserial::PortHandlers()),
+               libserial::SerialException);
+
+  reactor.addPort(serial_[0], libserial::PortHandlers());
+  EXPECT_THROW(reactor.addPort(serial_[0], libserial::PortHandlers()),
+               libserial::SerialException);
+
+  const char data[] = "x";
+  EXPECT_THROW(reactor.send(serial_[1], data, 1), libserial::SerialException);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, SerialReactorTest,
+                         ::testing::Values(libserial::ReactorBackend::EPOLL,
+                                           libserial::ReactorBackend::IO_URING));
+
+TEST(SerialReactorBackendTest, SelectsRequestedBackend) {
+  libserial::SerialReactor epoll_reactor;
+  EXPECT_EQ(epoll_reactor.getBackend(), libserial::ReactorBackend::EPOLL);
+
+  libserial::SerialReactor uring_reactor(libserial::ReactorBackend::IO_URING);
+  if (libserial::IoUring::isSupported()) {
+    EXPECT_EQ(uring_reactor.getBackend(), libserial::ReactorBackend::IO_URING);
+  }
+  else {
+    EXPECT_EQ(uring_reactor.getBackend(), libserial::ReactorBackend::EPOLL);
+  }
+}
+
+TEST(SerialReactorBackendTest, FallsBackToEpollWithoutIoUring) {
+  libserial::IoUring::setSetupSystemFunction(
+    [](unsigned int, struct io_uring_params*) {
+      errno = ENOSYS;
+      return -1;
+    });
+
+  libserial::SerialReactor reactor(libserial::ReactorBackend::IO_URING);
+  libserial::IoUring::setSetupSystemFunction(nullptr);
+
+  EXPECT_EQ(reactor.getBackend(), libserial::ReactorBackend::EPOLL);
+}
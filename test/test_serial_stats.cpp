@@ -0,0 +1,171 @@
+// Copyright 2020-2025 Nestor Neto
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "libserial/serial.hpp"
+#include "libserial/serial_exception.hpp"
+#include "libserial/serial_stats.hpp"
+
+#include "raw_pty_test.hpp"
+
+class SerialStatsTest : public RawPtyTest {
+protected:
+void SetUp() override {
+  if (!libserial::StatsRecorder::kEnabled) {
+    GTEST_SKIP() << "Built without BUILD_STATS";
+  }
+
+  RawPtyTest::SetUp();
+  ASSERT_FALSE(HasFatalFailure());
+  serial_.setReadTimeout(std::chrono::milliseconds(100));
+  serial_.resetStats();
+}
+
+void TearDown() override {
+  if (master_fd_ != -1) {
+    RawPtyTest::TearDown();
+  }
+}
+};
+
+TEST(LatencyHistogramTest, CountAndPercentiles) {
+  libserial::LatencyHistogram histogram;
+  EXPECT_EQ(histogram.getCount(), 0u);
+  EXPECT_EQ(histogram.getPercentile(50).count(), 0);
+
+  histogram.buckets[3] = 90;   // 8-15 ns
+  histogram.buckets[10] = 10;  // 1024-2047 ns
+  EXPECT_EQ(histogram.getCount(), 100u);
+  EXPECT_EQ(histogram.getPercentile(0).count(), 15);
+  EXPECT_EQ(histogram.getPercentile(50).count(), 15);
+  EXPECT_EQ(histogram.getPercentile(90).count(), 15);
+  EXPECT_EQ(histogram.getPercentile(99).count(), 2047);
+  EXPECT_EQ(histogram.getPercentile(100).count(), 2047);
+}
+
+TEST_F(SerialStatsTest, CountsBytesAndSystemCalls) {
+  const std::string message = "stats\n";
+  EXPECT_EQ(serial_.write(message.data(), message.size()), message.size());
+
+  char echoed[16];
+  ASSERT_EQ(read(master_fd_, echoed, sizeof(echoed)), static_cast<ssize_t>(message.size()));
+  ASSERT_EQ(write(master_fd_, "abc\ndef\n", 8), 8);
+
+  auto buffer = std::make_shared<std::string>();
+  EXPECT_EQ(serial_.readUntil(buffer, '\n'), 4u);
+  EXPECT_EQ(serial_.readUntil(buffer, '\n'), 4u);
+
+  libserial::SerialStats stats = serial_.getStats();
+  EXPECT_EQ(stats.bytes_written, message.size());
+  EXPECT_EQ(stats.write_calls, 1u);
+  EXPECT_GE(stats.poll_calls, 1u);
+  EXPECT_EQ(stats.bytes_read, 8u);
+  EXPECT_GE(stats.read_calls, 1u);
+  EXPECT_EQ(stats.timeouts, 0u);
+  EXPECT_EQ(stats.exceptions, 0u);
+  EXPECT_EQ(stats.write_latency.getCount(), 1u);
+  EXPECT_EQ(stats.read_latency.getCount(), 2u);
+
+  // Line settings go through TCSETS2
+  serial_.setParity(libserial::Parity::ENABLE);
+  EXPECT_EQ(serial_.getStats().ioctl_calls, stats.ioctl_calls + 1);
+
+  serial_.resetStats();
+  stats = serial_.getStats();
+  EXPECT_EQ(stats.bytes_read, 0u);
+  EXPECT_EQ(stats.read_latency.getCount(), 0u);
+}
+
+TEST_F(SerialStatsTest, CountsTimeoutsExceptionsAndRetries) {
+  auto buffer = std::make_shared<std::string>();
+  EXPECT_THROW(serial_.readUntil(buffer, '\n'), libserial::IOException);
+
+  char data[8];
+  EXPECT_EQ(serial_.readAvailable(data, sizeof(data)), 0u);
+
+  // Argument errors are counted too
+  EXPECT_THROW(serial_.readUntil(nullptr, '\n'), libserial::IOException);
+  EXPECT_THROW(serial_.readUntil(data, sizeof(data), std::string_view()), libserial::IOException);
+
+  libserial::SerialStats stats = serial_.getStats();
+  EXPECT_EQ(stats.timeouts, 1u);
+  EXPECT_EQ(stats.exceptions, 3u);
+  EXPECT_EQ(stats.eagain_retries, 1u);
+  EXPECT_EQ(stats.read_latency.getCount(), 4u);
+
+  // The timed-out call waited for the whole read timeout
+  EXPECT_GE(stats.read_latency.getPercentile(100), std::chrono::milliseconds(100));
+}
+
+TEST_F(SerialStatsTest, OnlyTimedWritesSwitchTheDescriptorMode) {
+  EXPECT_FALSE(fcntl(serial_.getFileDescriptor(), F_GETFL) & O_NONBLOCK);
+  serial_.setWriteTimeout(std::chrono::milliseconds(0));
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(serial_.write("ping", 4), 4u);
+    char echoed[8];
+    ASSERT_EQ(read(master_fd_, echoed, sizeof(echoed)), 4);
+    ASSERT_EQ(write(master_fd_, "pong", 4), 4);
+
+    char reply[4];
+    EXPECT_EQ(serial_.readBytes(reply, sizeof(reply)), 4u);
+    auto line = std::make_shared<std::string>();
+    ASSERT_EQ(write(master_fd_, "\n", 1), 1);
+    EXPECT_EQ(serial_.readUntil(line, '\n'), 1u);
+  }
+  EXPECT_EQ(serial_.getStats().ioctl_calls, 0u);
+
+  // One F_SETFL to enter and one to leave non-blocking mode
+  serial_.setWriteTimeout(std::chrono::milliseconds(100));
+  EXPECT_EQ(serial_.write("ping", 4), 4u);
+  EXPECT_EQ(serial_.getStats().ioctl_calls, 2u);
+  EXPECT_FALSE(fcntl(serial_.getFileDescriptor(), F_GETFL) & O_NONBLOCK);
+
+  // A descriptor the caller made non-blocking is left alone
+  serial_.setNonBlocking(true);
+  EXPECT_EQ(serial_.write("ping", 4), 4u);
+  EXPECT_EQ(serial_.getStats().ioctl_calls, 3u);
+  EXPECT_TRUE(fcntl(serial_.getFileDescriptor(), F_GETFL) & O_NONBLOCK);
+}
+
+TEST_F(SerialStatsTest, SnapshotFromAnotherThread) {
+  std::atomic<bool> done{false};
+  std::thread observer([this, &done]() {
+    uint64_t last = 0;
+    while (!done.load()) {
+      uint64_t written = serial_.getStats().bytes_written;
+      EXPECT_GE(written, last);
+      last = written;
+      std::this_thread::yield();
+    }
+  });
+
+  const std::string chunk(64, 'x');
+  std::vector<char> sink(chunk.size());
+  for (int i = 0; i < 100; ++i) {
+    serial_.write(chunk.data(), chunk.size());
+    size_t received = 0;
+    while (received < sink.size()) {
+      ssize_t result = read(master_fd_, sink.data(), sink.size() - received);
+      if (result <= 0) {
+        ADD_FAILURE() << "Failed to read from master end";
+        break;
+      }
+      received += static_cast<size_t>(result);
+    }
+  }
+  done = true;
+  observer.join();
+
+  EXPECT_EQ(serial_.getStats().bytes_written, 100u * chunk.size());
+}
@@ -0,0 +1,94 @@
+// Copyright 2020-2025 Nestor Neto
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "libserial/serial.hpp"
+#include "libserial/serial_exception.hpp"
+#include "libserial/slip.hpp"
+
+#include "raw_pty_test.hpp"
+
+class SlipFramerTest : public RawPtyTest {};
+
+TEST_F(SlipFramerTest, EscapesEndAndEsc) {
+  libserial::SlipFramer framer(serial_);
+  const std::string expected = bytes({0xC0, 0x01, 0xDB, 0xDC, 0x02, 0xDB, 0xDD, 0xC0});
+  EXPECT_EQ(framer.writeFrame(bytes({0x01, 0xC0, 0x02, 0xDB})), expected.size());
+  EXPECT_EQ(readMaster(expected.size()), expected);
+}
+
+TEST_F(SlipFramerTest, WriteFramesSharesDelimiters) {
+  libserial::SlipFramer framer(serial_);
+  std::string first = bytes({0x11, 0x22});
+  std::string second = bytes({0xC0});
+  struct iovec frames[] = {{&first[0], first.size()}, {&second[0], second.size()}};
+
+  const std::string expected = bytes({0xC0, 0x11, 0x22, 0xC0, 0xDB, 0xDC, 0xC0});
+  EXPECT_EQ(framer.writeFrames(frames, 2), expected.size());
+  EXPECT_EQ(readMaster(expected.size()), expected);
+}
+
+TEST_F(SlipFramerTest, DecodesEscapesSplitAcrossReads) {
+  libserial::SlipFramer framer(serial_);
+  std::vector<std::string> frames;
+  framer.onFrame([&frames](const char* frame, size_t size) {
+      frames.emplace_back(frame, size);
+    });
+
+  const std::string stream = bytes({0xC0, 0xC0, 0x01, 0xDB, 0xDC, 0xDB, 0xDD, 0x02, 0xC0,
+                                    0x03, 0xC0});
+  for (char byte : stream) {
+    framer.feed(&byte, 1);
+  }
+  EXPECT_EQ(framer.feed(stream.data(), stream.size()), 2u);
+
+  ASSERT_EQ(frames.size(), 4u);
+  for (size_t i = 0; i < frames.size(); i += 2) {
+    EXPECT_EQ(frames[i], bytes({0x01, 0xC0, 0xDB, 0x02}));
+    EXPECT_EQ(frames[i + 1], bytes({0x03}));
+  }
+  EXPECT_EQ(framer.getFrameErrorCount(), 0u);
+}
+
+TEST_F(SlipFramerTest, ReadFrameRoundTripsThroughPort) {
+  libserial::SlipFramer framer(serial_);
+  const std::string payload = bytes({0xDB, 0x00, 0xC0, 0xFF, 0xDD});
+  size_t written = framer.writeFrame(payload);
+  writeMaster(readMaster(written) + bytes({0x42, 0xC0}));
+
+  auto frame = std::make_shared<std::string>();
+  EXPECT_EQ(framer.readFrame(frame), payload.size());
+  EXPECT_EQ(*frame, payload);
+
+  char buffer[1];
+  EXPECT_EQ(framer.readFrame(buffer, sizeof(buffer)), 1u);
+  EXPECT_EQ(buffer[0], 0x42);
+}
+
+TEST_F(SlipFramerTest, MalformedFramesAreDroppedNotFatal) {
+  libserial::SlipFramer framer(serial_, 4);
+  std::vector<std::string> errors;
+  framer.onFrameError([&errors](const libserial::FramingException& error) {
+      errors.emplace_back(error.what());
+    });
+
+  // Invalid escape, oversized frame, then a valid frame
+  writeMaster(bytes({0x01, 0xDB, 0x05, 0x02, 0xC0}) +
+              bytes({0x01, 0x02, 0x03, 0x04, 0x05, 0xC0}) +
+              bytes({0x42, 0xC0}));
+
+  char buffer[4];
+  EXPECT_EQ(framer.readFrame(buffer, sizeof(buffer)), 1u);
+  EXPECT_EQ(buffer[0], 0x42);
+
+  ASSERT_EQ(errors.size(), 2u);
+  EXPECT_EQ(errors[0], "SLIP frame has an invalid escape sequence");
+  EXPECT_EQ(errors[1], "SLIP frame exceeds maximum size of 4 bytes");
+  EXPECT_EQ(framer.getFrameErrorCount(), 2u);
+
+  EXPECT_THROW(framer.writeFrames(nullptr, 1), libserial::IOException);
+}
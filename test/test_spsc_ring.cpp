@@ -0,0 +1,133 @@
+// Copyright 2020-2025 Nestor Neto
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libserial/serial_exception.hpp"
+#include "libserial/spsc_ring.hpp"
+
+TEST(SpscRingTest, CapacityRoundsUpToPowerOfTwo) {
+  EXPECT_EQ(libserial::SpscRing(1).getCapacity(), 1u);
+  EXPECT_EQ(libserial::SpscRing(100).getCapacity(), 128u);
+  EXPECT_EQ(libserial::SpscRing(4096).getCapacity(), 4096u);
+  EXPECT_THROW(libserial::SpscRing(0), libserial::SerialException);
+}
+
+TEST(SpscRingTest, RegionsWrapAroundTheEnd) {
+  libserial::SpscRing ring(8);
+  char buffer[8];
+  ASSERT_EQ(ring.write("abcdef", 6), 6u);
+  ASSERT_EQ(ring.read(buffer, 4), 4u);
+  EXPECT_EQ(std::string(buffer, 4), "abcd");
+
+  // Free space: 2 bytes at the end, 4 at the start
+  struct iovec regions[2];
+  EXPECT_EQ(ring.writableRegions(regions), 6u);
+  EXPECT_EQ(regions[0].iov_len, 2u);
+  EXPECT_EQ(regions[1].iov_len, 4u);
+
+  EXPECT_EQ(ring.write("ghijklmn", 8), 6u);
+  EXPECT_EQ(ring.size(), 8u);
+
+  EXPECT_EQ(ring.readableRegions(regions), 8u);
+  EXPECT_EQ(std::string(static_cast<char*>(regions[0].iov_base), regions[0].iov_len), "efgh");
+  EXPECT_EQ(std::string(static_cast<char*>(regions[1].iov_base), regions[1].iov_len), "ijkl");
+
+  ring.consume(3);
+  EXPECT_EQ(ring.read(buffer, sizeof(buffer)), 5u);
+  EXPECT_EQ(std::string(buffer, 5), "hijkl");
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingTest, RejectsOvercommit) {
+  libserial::SpscRing ring(4);
+  EXPECT_THROW(ring.commitWrite(5), libserial::SerialException);
+  ring.commitWrite(4);
+  EXPECT_THROW(ring.commitWrite(1), libserial::SerialException);
+  EXPECT_THROW(ring.consume(5), libserial::SerialException);
+  ring.consume(4);
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingTest, WatermarksFireOnCrossing) {
+  libserial::SpscRing ring(16);
+  std::vector<size_t> high;
+  std::vector<size_t> low;
+  ring.setHighWatermark(12, [&high](size_t level) { high.push_back(level); });
+  ring.setLowWatermark(4, [&low](size_t level) { low.push_back(level); });
+
+  ring.write("0123456789", 10);
+  EXPECT_TRUE(high.empty());
+  ring.write("abcd", 4);
+  ASSERT_EQ(high.size(), 1u);
+  EXPECT_EQ(high[0], 14u);
+
+  // Staying above the level does not fire again
+  ring.write("x", 1);
+  EXPECT_EQ(high.size(), 1u);
+
+  ring.consume(5);
+  EXPECT_TRUE(low.empty());
+  ring.consume(7);
+  ASSERT_EQ(low.size(), 1u);
+  EXPECT_EQ(low[0], 3u);
+
+  // Rising again re-arms the high watermark
+  ring.write("0123456789", 10);
+  EXPECT_EQ(high.size(), 2u);
+}
+
+TEST(SpscRingTest, ProducerAndConsumerThreads) {
+  constexpr size_t kTotal = 1024 * 1024;
+  libserial::SpscRing ring(1024);
+
+  std::thread producer([&ring]() {
+      uint8_t value = 0;
+      size_t sent = 0;
+      while (sent < kTotal) {
+        struct iovec regions[2];
+        size_t space = std::min(ring.writableRegions(regions), kTotal - sent);
+        if (space == 0) {
+          std::this_thread::yield();
+          continue;
+        }
+        size_t first = std::min(space, regions[0].iov_len);
+        for (size_t i = 0; i < space; ++i) {
+          auto* region = static_cast<uint8_t*>(i < first ? regions[0].iov_base :
+                                               regions[1].iov_base);
+          region[i < first ? i : i - first] = value++;
+        }
+        ring.commitWrite(space);
+        sent += space;
+      }
+    });
+
+  uint8_t expected = 0;
+  size_t received = 0;
+  bool in_order = true;
+  while (received < kTotal) {
+    struct iovec regions[2];
+    size_t available = ring.readableRegions(regions);
+    if (available == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    for (const struct iovec& region : regions) {
+      const auto* bytes = static_cast<const uint8_t*>(region.iov_base);
+      for (size_t i = 0; i < region.iov_len; ++i) {
+        in_order = in_order && bytes[i] == expected++;
+      }
+    }
+    ring.consume(available);
+    received += available;
+  }
+  producer.join();
+
+  EXPECT_TRUE(in_order);
+  EXPECT_TRUE(ring.empty());
+}
@@ -0,0 +1,226 @@
+// Copyright 2020-2025 Nestor Neto
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "libserial/serial.hpp"
+#include "libserial/serial_exception.hpp"
+#include "libserial/traffic_tap.hpp"
+
+using libserial::CaptureDirection;
+using libserial::CaptureRecord;
+using libserial::TapOverflow;
+using libserial::TapStats;
+using libserial::TrafficTap;
+
+namespace {
+
+// Observer that stores every chunk and can be held inside a call
+class Recorder {
+public:
+void operator()(const CaptureRecord& chunk) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  entered_ = true;
+  cv_.notify_all();
+  cv_.wait(lock, [this]() {
+      return !held_;
+    });
+  chunks_.push_back(chunk);
+}
+
+void hold() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  held_ = true;
+  entered_ = false;
+}
+
+void waitEntered() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() {
+      return entered_;
+    });
+}
+
+void release() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  held_ = false;
+  cv_.notify_all();
+}
+
+std::vector<std::string> data() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::string> result;
+  for (const auto& chunk : chunks_) {
+    result.push_back(chunk.data);
+  }
+  return result;
+}
+
+std::vector<CaptureRecord> chunks() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return chunks_;
+}
+
+private:
+std::mutex mutex_;
+std::condition_variable cv_;
+bool held_{false};
+bool entered_{false};
+std::vector<CaptureRecord> chunks_;
+};
+
+// Publishes "0", "1", ... while the observer is held inside the first chunk
+void publishWhileHeld(TrafficTap& tap, Recorder& recorder, int chunks) {
+  recorder.hold();
+  tap.publish(CaptureDirection::RX, "0", 1);
+  recorder.waitEntered();
+  for (int i = 1; i < chunks; ++i) {
+    std::string data = std::to_string(i);
+    tap.publish(CaptureDirection::RX, data.data(), data.size());
+  }
+  recorder.release();
+  tap.flush();
+}
+
+}  // namespace
+
+TEST(TrafficTapTest, DeliversChunksToEveryObserverInOrder) {
+  TrafficTap tap;
+  EXPECT_EQ(tap.getQueueSize(), TrafficTap::kDefaultQueueSize);
+  EXPECT_EQ(tap.getOverflow(), TapOverflow::DROP_NEWEST);
+  EXPECT_THROW(TrafficTap(0), libserial::SerialException);
+
+  auto first = std::make_shared<Recorder>();
+  auto second = std::make_shared<Recorder>();
+  tap.addObserver([first](const CaptureRecord& chunk) { (*first)(chunk); });
+  tap.addObserver([second](const CaptureRecord& chunk) { (*second)(chunk); });
+
+  tap.publish(CaptureDirection::TX, "ping", 4);
+  struct iovec segments[2] = {{const_cast<char*>("po"), 2}, {const_cast<char*>("ng!!"), 4}};
+  tap.publish(CaptureDirection::RX, segments, 2, 4);
+  tap.flush();
+
+  std::vector<CaptureRecord> chunks = first->chunks();
+  ASSERT_EQ(chunks.size(), 2u);
+  EXPECT_EQ(chunks[0].direction, CaptureDirection::TX);
+  EXPECT_EQ(chunks[0].data, "ping");
+  EXPECT_EQ(chunks[1].direction, CaptureDirection::RX);
+  EXPECT_EQ(chunks[1].data, "pong");
+  EXPECT_LE(chunks[0].timestamp, chunks[1].timestamp);
+  EXPECT_EQ(second->data(), first->data());
+
+  TapStats stats = tap.getStats();
+  EXPECT_EQ(stats.published, 2u);
+  EXPECT_EQ(stats.delivered, 2u);
+  EXPECT_EQ(stats.dropped, 0u);
+}
+
+TEST(TrafficTapTest, DropNewestKeepsTheOldestChunks) {
+  TrafficTap tap(3, TapOverflow::DROP_NEWEST);
+  Recorder recorder;
+  tap.addObserver([&recorder](const CaptureRecord& chunk) { recorder(chunk); });
+
+  // "0" is being delivered, "1" to "3" fill the queue and "4" is lost
+  publishWhileHeld(tap, recorder, 5);
+  tap.publish(CaptureDirection::RX, "55", 2);
+  tap.flush();
+
+  EXPECT_EQ(recorder.data(), (std::vector<std::string>{"0", "1", "2", "3", "55"}));
+  TapStats stats = tap.getStats();
+  EXPECT_EQ(stats.published, 5u);
+  EXPECT_EQ(stats.delivered, 5u);
+  EXPECT_EQ(stats.dropped, 1u);
+  EXPECT_EQ(stats.dropped_bytes, 1u);
+}
+
+TEST(TrafficTapTest, DropOldestKeepsTheLatestChunks) {
+  TrafficTap tap(3, TapOverflow::DROP_OLDEST);
+  Recorder recorder;
+  tap.addObserver([&recorder](const CaptureRecord& chunk) { recorder(chunk); });
+
+  // "1" and "2" make room for "4" and "5"
+  publishWhileHeld(tap, recorder, 6);
+
+  EXPECT_EQ(recorder.data(), (std::vector<std::string>{"0", "3", "4", "5"}));
+  TapStats stats = tap.getStats();
+  EXPECT_EQ(stats.published, 6u);
+  EXPECT_EQ(stats.delivered, 4u);
+  EXPECT_EQ(stats.dropped, 2u);
+  EXPECT_EQ(stats.dropped_bytes, 2u);
+}
+
+TEST(TrafficTapTest, RemovedObserversAreNotCalled) {
+  TrafficTap tap;
+  Recorder recorder;
+  int id = tap.addObserver([&recorder](const CaptureRecord& chunk) { recorder(chunk); });
+
+  bool threw = false;
+  tap.addObserver([&tap, &threw](const CaptureRecord&) {
+      try {
+        tap.flush();
+      }
+      catch (const libserial::SerialException&) {
+        threw = true;
+      }
+    });
+
+  tap.publish(CaptureDirection::TX, "one", 3);
+  tap.flush();
+  tap.removeObserver(id);
+  tap.removeObserver(id + 100);
+  tap.publish(CaptureDirection::TX, "two", 3);
+  tap.flush();
+
+  EXPECT_EQ(recorder.data(), std::vector<std::string>{"one"});
+  EXPECT_TRUE(threw);
+}
+
+TEST(TrafficTapTest, SerialPublishesItsTraffic) {
+  int master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+  ASSERT_NE(master_fd, -1);
+  ASSERT_EQ(grantpt(master_fd), 0);
+  ASSERT_EQ(unlockpt(master_fd), 0);
+
+  libserial::Serial serial_port;
+  serial_port.open(ptsname(master_fd));
+  serial_port.setCanonicalMode(libserial::CanonicalMode::DISABLE);
+
+  auto tap = std::make_shared<TrafficTap>();
+  Recorder recorder;
+  tap->addObserver([&recorder](const CaptureRecord& chunk) { recorder(chunk); });
+  serial_port.setTap(tap);
+  EXPECT_EQ(serial_port.getTap(), tap);
+
+  serial_port.write("ping", 4);
+  ASSERT_EQ(write(master_fd, "pong;", 5), 5);
+  auto reply = std::make_shared<std::string>();
+  serial_port.readUntil(reply, ';');
+  EXPECT_EQ(*reply, "pong;");
+
+  serial_port.startAsyncRead();
+  EXPECT_THROW(serial_port.setTap(nullptr), libserial::SerialException);
+  serial_port.stopAsyncRead();
+  serial_port.setTap(nullptr);
+  serial_port.write("not tapped", 10);
+  tap->flush();
+
+  std::vector<CaptureRecord> chunks = recorder.chunks();
+  ASSERT_EQ(chunks.size(), 2u);
+  EXPECT_EQ(chunks[0].direction, CaptureDirection::TX);
+  EXPECT_EQ(chunks[0].data, "ping");
+  EXPECT_EQ(chunks[1].direction, CaptureDirection::RX);
+  EXPECT_EQ(chunks[1].data, "pong;");
+
+  serial_port.close();
+  close(master_fd);
+}